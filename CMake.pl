@@ -9,7 +9,7 @@ use strict;
 ## EXECUTABLES
 my @masterprog=("fullBuild","ess","muBeam","pipe","photonMod2","t1Real",
 		"sns","reactor","t1MarkII","essBeamline","bilbau",
-		"filter","singleItem","maxiv","testMain"); 
+		"filter","singleItem","maxiv","testMain","benchMain"); 
 
 
 
@@ -468,6 +468,19 @@ $gM->addDepUnit("testMain", ["test","build","visit","chip","t1Upgrade",
 			     "world","weights","md5","global","attachComp",
 			     "insertUnit","visit","poly","essConstruct"]);
 
+$gM->addDepUnit("benchMain", ["build","visit","chip","t1Upgrade",
+			     "build","zoom","construct",
+			     "crystal","transport","t1Build",
+			     "src","simMC","physics","input","process","source",
+			     "monte","funcBase","log","geometry","tally",
+			     "flukaProcess","flukaPhysics","flukaTally",
+			     "phitsProcess","phitsPhysics","phitsTally","phitsSupport",
+			     "build","imat","moderator","chip","zoom",
+                             "simMC","transport","scatMat","crystal","endf",
+			     "mersenne","src","work","xml","poly","support",
+			     "world","weights","md5","global","attachComp",
+			     "insertUnit","visit","poly","essConstruct"]);
+
 $gM->writeCMake();
 
 print "FINISH CMake.pl\n";
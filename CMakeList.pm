@@ -211,6 +211,7 @@ sub setParameters
 	  $self->{optimise}.=" -O2 " if ($Ostr eq "-O");
 	  push(@{$self->{definitions}},"NO_REGEX") if ($Ostr eq "-NR");
 	  $self->{noregex}=1 if ($Ostr eq "-NR");
+	  push(@{$self->{definitions}},"NO_HOTREG") if ($Ostr eq "-NH");
 	  $self->{optimise}.=" -pg " if ($Ostr eq "-p"); ## Gprof
 	  $self->{gcov}=1 if ($Ostr eq "-C");
 	  $self->{gtk}=1 if ($Ostr eq "-gtk");
@@ -341,6 +342,7 @@ sub writeExcutables
       print $DX "target_link_libraries(",$item," gsl)\n";
       print $DX "target_link_libraries(",$item," gslcblas)\n";
       print $DX "target_link_libraries(",$item," m)\n";
+      print $DX "target_link_libraries(",$item," pthread)\n";
     }
   
   
@@ -0,0 +1,456 @@
+/********************************************************************* 
+  Comblayer : MCNP(X) Input builder
+ 
+ * File:   Main/benchMain.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <list>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <array>
+#include <chrono>
+
+#include "Exception.h"
+#include "MersenneTwister.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "stringCombine.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Cylinder.h"
+#include "Cone.h"
+#include "Sphere.h"
+#include "Line.h"
+#include "LineKernel.h"
+#include "surfaceFactory.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "SimMCNP.h"
+#include "LineTrack.h"
+#include "MainProcess.h"
+
+MTRand RNG(12345UL);
+
+namespace ELog 
+{
+  ELog::OutputLog<EReport> EM;
+  ELog::OutputLog<FileReport> FM("Spectrum.log");
+  ELog::OutputLog<FileReport> RN("Renumber.txt");   ///< Renumber
+  ELog::OutputLog<StreamReport> CellM;
+}
+
+typedef std::chrono::steady_clock CLK;      ///< Benchmark clock
+
+int benchTrack(const size_t);
+int benchKernel(const size_t);
+
+namespace
+{
+  /// Loop body with a literal registration
+  double
+  regLiteral(const double X)
+  {
+    ELog::RegMethod RegA("benchMain","regLiteral");
+    return X*1.0000001;
+  }
+
+  /// Loop body with a hot path registration
+  double
+  regHot(const double X)
+  {
+    ELog::RegHot RegA("benchMain","regHot");
+    return X*1.0000001;
+  }
+
+  /// Loop body with a run time [string] registration
+  double
+  regString(const double X)
+  {
+    static const std::string CN("benchMain");
+    static const std::string MN("regString");
+    ELog::RegMethod RegA(CN,MN);
+    return X*1.0000001;
+  }
+
+  /// Loop body with no registration
+  double
+  regNone(const double X)
+  {
+    return X*1.0000001;
+  }
+
+  double
+  callTime(double (*Func)(const double),const size_t N)
+    /*!
+      Time N calls of a loop body 
+      \param Func :: Loop body
+      \param N :: Number of calls
+      \return ns per call
+    */
+  {
+    double X(1.0);
+    const CLK::time_point tA=CLK::now();
+    for(size_t i=0;i<N;i++)
+      X=Func(X);
+    const CLK::time_point tB=CLK::now();
+    if (X<0.0) ELog::EM<<"Value "<<X<<ELog::endDiag;   // keep X
+    return std::chrono::duration<double,std::nano>(tB-tA).count()/
+      static_cast<double>(N);
+  }
+
+  size_t
+  lineRoots(const Geometry::Line& LX,const int type,
+	    const Geometry::Surface* SPtr,std::vector<double>& LOut)
+    /*!
+      Line parameters of the Line::intersect points
+      \param LX :: Line
+      \param type :: LineKernel type of surface
+      \param SPtr :: Surface
+      \param LOut :: Line parameters [added to]
+      \return number of points
+    */
+  {
+    std::vector<Geometry::Vec3D> PtOut;
+    if (type==LineKernel::axisPlane || type==LineKernel::genPlane)
+      LX.intersect(PtOut,*static_cast<const Geometry::Plane*>(SPtr));
+    else if (type==LineKernel::axisCylinder ||
+	     type==LineKernel::genCylinder)
+      LX.intersect(PtOut,*static_cast<const Geometry::Cylinder*>(SPtr));
+    else if (type==LineKernel::sphere)
+      LX.intersect(PtOut,*static_cast<const Geometry::Sphere*>(SPtr));
+    else if (type==LineKernel::cone)
+      LX.intersect(PtOut,*static_cast<const Geometry::Cone*>(SPtr));
+
+    for(const Geometry::Vec3D& Pt : PtOut)
+      LOut.push_back((Pt-LX.getOrigin()).dotProd(LX.getDirect()));
+    return PtOut.size();
+  }
+
+  size_t
+  kernelRoots(const Geometry::Line& LX,const int type,
+	      const Geometry::Surface* SPtr,std::vector<double>& LOut)
+    /*!
+      Line parameters from the single surface LineKernel functions
+      \param LX :: Line
+      \param type :: LineKernel type of surface
+      \param SPtr :: Surface
+      \param LOut :: Line parameters [added to]
+      \return number of roots
+    */
+  {
+    const Geometry::Vec3D& O=LX.getOrigin();
+    const Geometry::Vec3D& D=LX.getDirect();
+    double L[2];
+    size_t nL(0);
+    if (type==LineKernel::axisPlane || type==LineKernel::genPlane)
+      nL=LineKernel::planeRoots
+	(*static_cast<const Geometry::Plane*>(SPtr),O,D,L);
+    else if (type==LineKernel::axisCylinder ||
+	     type==LineKernel::genCylinder)
+      nL=LineKernel::cylinderRoots
+	(*static_cast<const Geometry::Cylinder*>(SPtr),O,D,L);
+    else if (type==LineKernel::sphere)
+      nL=LineKernel::sphereRoots
+	(*static_cast<const Geometry::Sphere*>(SPtr),O,D,L);
+    else if (type==LineKernel::cone)
+      nL=LineKernel::coneRoots
+	(*static_cast<const Geometry::Cone*>(SPtr),O,D,L);
+
+    for(size_t i=0;i<nL;i++)
+      LOut.push_back(L[i]);
+    return nL;
+  }
+}
+
+int
+benchTrack(const size_t nTrack)
+  /*!
+    Tracking loop overhead : LineTrack through nested
+    boxes [LineTrack::updateDistance/ObjSurfMap::findNextObject
+    are RegHot] and the cost of each registration type.
+    Run from builds with and without NO_HOTREG [CMake.pl -NH]
+    to compare.
+    \param nTrack :: Number of tracks
+    \return 0 on success 
+  */
+{
+  ELog::RegMethod RegA("benchMain","benchTrack");
+
+  const size_t nCall(20000000);
+  ELog::EM<<"Registration [ns/call] : none "<<callTime(&regNone,nCall)
+	  <<" : literal "<<callTime(&regLiteral,nCall)
+	  <<" : hot "<<callTime(&regHot,nCall)
+	  <<" : string "<<callTime(&regString,nCall)<<ELog::endDiag;
+
+  // nested boxes [half width 1-20] in a sphere
+  const size_t nBox(20);
+  SimMCNP ASim;
+  ASim.resetAll();
+  ASim.cell("World",1);
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  for(size_t i=1;i<=nBox;i++)
+    {
+      const std::string W(StrFunc::makeString(static_cast<double>(i)));
+      const int SI(10*static_cast<int>(i));
+      SurI.createSurface(SI+1,"px -"+W);
+      SurI.createSurface(SI+2,"px "+W);
+      SurI.createSurface(SI+3,"py -"+W);
+      SurI.createSurface(SI+4,"py "+W);
+      SurI.createSurface(SI+5,"pz -"+W);
+      SurI.createSurface(SI+6,"pz "+W);
+    }
+  SurI.createSurface(1000,"so 50");
+
+  ASim.addCell(MonteCarlo::Object(1,0,0.0,"1000"));
+  ASim.addCell(MonteCarlo::Object(2,3,0.0,"11 -12 13 -14 15 -16"));
+  for(int i=2;i<=static_cast<int>(nBox);i++)
+    {
+      const std::string Out=
+	ModelSupport::getComposite(10*i,"1 -2 3 -4 5 -6 ")+
+	"("+ModelSupport::getComposite(10*(i-1),"-1:2:-3:4:-5:6")+")";
+      ASim.addCell(MonteCarlo::Object(i+1,3,0.0,Out));
+    }
+  const std::string Out="-1000 ("+ModelSupport::getComposite
+    (10*static_cast<int>(nBox),"-1:2:-3:4:-5:6")+")";
+  ASim.addCell(MonteCarlo::Object(static_cast<int>(nBox)+2,0,0.0,Out));
+  ASim.populateCells();
+  ASim.createObjSurfMap();
+
+  std::vector<std::pair<Geometry::Vec3D,Geometry::Vec3D>> Tracks;
+  for(size_t i=0;i<nTrack;i++)
+    {
+      const Geometry::Vec3D APt(RNG.rand()-0.5,RNG.rand()-0.5,
+				RNG.rand()-0.5);
+      Geometry::Vec3D Dir(RNG.rand()-0.5,RNG.rand()-0.5,RNG.rand()-0.5);
+      Tracks.push_back(std::pair<Geometry::Vec3D,Geometry::Vec3D>
+		       (APt*10.0,Dir.unit()*40.0));
+    }
+
+  size_t nSeg(0);
+  const CLK::time_point tA=CLK::now();
+  for(const std::pair<Geometry::Vec3D,Geometry::Vec3D>& TP : Tracks)
+    {
+      ModelSupport::LineTrack LT(TP.first,TP.second);
+      LT.calculate(ASim);
+      nSeg+=LT.getCells().size();
+    }
+  const CLK::time_point tB=CLK::now();
+  const double TTime=std::chrono::duration<double,std::micro>(tB-tA).count();
+
+  ELog::EM<<"Tracks "<<nTrack<<" Segments "<<nSeg<<ELog::endDiag;
+  ELog::EM<<"Track time "<<TTime/static_cast<double>(nTrack)<<" us/track : "
+	  <<1000.0*TTime/static_cast<double>(nSeg)<<" ns/segment"
+	  <<ELog::endDiag;
+  return 0;
+}
+
+int
+benchKernel(const size_t nTrack)
+  /*!
+    Line-surface intersection : Line::intersect against the
+    type tagged kernels and the surfBatch on a surface mix
+    like a moderator/reflector model [mostly axis planes
+    and y-axis cylinders]. The results of the three
+    paths must agree.
+    \param nTrack :: Number of tracks
+    \return 0 on success / -1 if the paths disagree
+  */
+{
+  ELog::RegMethod RegA("benchMain","benchKernel");
+
+  const Geometry::surfaceFactory& SF=
+    Geometry::surfaceFactory::Instance();
+
+  std::vector<std::shared_ptr<Geometry::Surface> > SurList;
+  for(size_t i=0;i<20;i++)
+    {
+      const double V(static_cast<double>(i)*5.0-50.0);
+      SurList.push_back(std::shared_ptr<Geometry::Surface>
+	(SF.processLine("px "+std::to_string(V))));
+      SurList.push_back(std::shared_ptr<Geometry::Surface>
+	(SF.processLine("py "+std::to_string(V*1.3))));
+      SurList.push_back(std::shared_ptr<Geometry::Surface>
+	(SF.processLine("pz "+std::to_string(V*0.7))));
+    }
+  for(size_t i=0;i<10;i++)
+    {
+      const double A(static_cast<double>(i)*0.3);
+      SurList.push_back(std::shared_ptr<Geometry::Surface>
+	(SF.processLine("p "+std::to_string(cos(A))+" "+
+			std::to_string(sin(A))+" 0.1 "+
+			std::to_string(static_cast<double>(i)*3.0))));
+    }
+  for(size_t i=0;i<20;i++)
+    {
+      const double R(static_cast<double>(i)*2.5+5.0);
+      SurList.push_back(std::shared_ptr<Geometry::Surface>
+	(SF.processLine("c/y 0 "+std::to_string(R*0.1)+" "+
+			std::to_string(R))));
+    }
+  for(size_t i=0;i<4;i++)
+    SurList.push_back(std::shared_ptr<Geometry::Surface>
+		      (new Geometry::Cylinder
+		       (10,Geometry::Vec3D(1,1,0),
+			Geometry::Vec3D(1,1,static_cast<double>(i)),
+			3.0+static_cast<double>(i))));
+  SurList.push_back(std::shared_ptr<Geometry::Surface>
+		    (SF.processLine("so 150")));
+  SurList.push_back(std::shared_ptr<Geometry::Surface>
+		    (SF.processLine("s 5 5 5 20")));
+  SurList.push_back(std::shared_ptr<Geometry::Surface>
+		    (SF.processLine("k/y 0 10 0 0.2 1")));
+  SurList.push_back(std::shared_ptr<Geometry::Surface>
+		    (SF.processLine("k/y 0 -10 0 0.2 -1")));
+
+  std::vector<int> SType;
+  LineKernel::surfBatch SB;
+  for(const std::shared_ptr<Geometry::Surface>& SPtr : SurList)
+    {
+      SType.push_back(LineKernel::getType(SPtr.get()));
+      SB.addSurface(SPtr.get());
+    }
+
+  std::vector<Geometry::Line> Tracks;
+  for(size_t i=0;i<nTrack;i++)
+    {
+      const double fI(static_cast<double>(i));
+      const double phi(fI*2.399963);
+      const double cosT(1.0-2.0*(fI+0.5)/static_cast<double>(nTrack));
+      const double sinT(sqrt(1.0-cosT*cosT));
+      Tracks.push_back
+	(Geometry::Line(Geometry::Vec3D(fmod(fI,7.0),fmod(fI,11.0)-5.0,1.0),
+			Geometry::Vec3D(sinT*cos(phi),sinT*sin(phi),cosT)));
+    }
+
+  std::vector<double> LA,LB,LC;
+  std::vector<size_t> IC;
+
+  const CLK::time_point tA=CLK::now();
+  for(const Geometry::Line& LX : Tracks)
+    for(size_t i=0;i<SurList.size();i++)
+      lineRoots(LX,SType[i],SurList[i].get(),LA);
+
+  const CLK::time_point tB=CLK::now();
+  for(const Geometry::Line& LX : Tracks)
+    for(size_t i=0;i<SurList.size();i++)
+      kernelRoots(LX,SType[i],SurList[i].get(),LB);
+
+  const CLK::time_point tC=CLK::now();
+  for(const Geometry::Line& LX : Tracks)
+    SB.intersect(LX.getOrigin(),LX.getDirect(),LC,IC);
+  const CLK::time_point tD=CLK::now();
+
+  double sumA(0.0),sumB(0.0),sumC(0.0);
+  for(const double L : LA) sumA+=L;
+  for(const double L : LB) sumB+=L;
+  for(const double L : LC) sumC+=L;
+
+  const double scale(1e-8*(1.0+std::abs(sumA)));
+  if (LA.size()!=LB.size() || LA.size()!=LC.size() ||
+      std::abs(sumA-sumB)>scale || std::abs(sumA-sumC)>scale)
+    {
+      ELog::EM<<"Points  "<<LA.size()<<" "<<LB.size()<<" "
+	      <<LC.size()<<ELog::endDiag;
+      ELog::EM<<"Sum  "<<sumA<<" "<<sumB<<" "<<sumC<<ELog::endDiag;
+      return -1;
+    }
+
+  typedef std::chrono::duration<double,std::milli> MS;
+  ELog::EM<<"Tracks "<<nTrack<<" Surfaces "<<SurList.size()
+	  <<" Points "<<LA.size()<<ELog::endDiag;
+  ELog::EM<<"Line::intersect "<<MS(tB-tA).count()<<" ms : kernel "
+	  <<MS(tC-tB).count()<<" ms : batch "
+	  <<MS(tD-tC).count()<<" ms"<<ELog::endDiag;
+  return 0;
+}
+
+int
+main(int argc,char* argv[])
+  /*!
+    Stand-alone benchmarks [not part of testMain]:
+     - 1 [nTrack] :: tracking loop / registration overhead
+     - 2 [nTrack] :: line-surface intersection kernels
+    \param argc :: number of arguments
+    \param argv :: arguments
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RControl("","main");
+  mainSystem::activateLogging(RControl);
+  ELog::EM.setDebug(0);
+  ELog::EM.setAction(ELog::error);
+
+  int section(0);
+  size_t N(0);
+  if (argc>1)
+    StrFunc::convert(argv[1],section);
+  if (argc>2)
+    StrFunc::convert(argv[2],N);
+
+  int retVal(0);
+  try
+    {
+      if (section==1)
+	retVal=benchTrack((N) ? N : 20000);
+      else if (section==2)
+	retVal=benchKernel((N) ? N : 2000);
+      else
+	{
+	  std::cout<<"benchMain section [N]"<<std::endl;
+	  std::cout<<"  1 :: Tracking loop [nTrack]"<<std::endl;
+	  std::cout<<"  2 :: Intersection kernels [nTrack]"<<std::endl;
+	}
+    }
+  catch (ColErr::ExBase& EObj)
+    {
+      ELog::EM<<"EXCEPTION FAILURE :: "<<EObj.what()<<ELog::endErr;
+      retVal= -1;
+    }
+  ModelSupport::surfIndex::Instance().reset();
+  return retVal;
+}
@@ -104,6 +104,7 @@
 #include "MainProcess.h"
 #include "MainInputs.h"
 
+#include "testActivationSource.h"
 #include "testAlgebra.h"
 #include "testAttachSupport.h"
 #include "testBinData.h"
@@ -111,6 +112,7 @@
 #include "testBoost.h"
 #include "testBoundary.h"
 #include "testBoxLine.h"
+#include "testCellValueSet.h"
 #include "testCone.h"
 #include "testContained.h"
 #include "testConvex.h"
@@ -182,6 +184,7 @@
 #include "testVarNameOrder.h"
 #include "testVec3D.h"
 #include "testVolumes.h"
+#include "testVTKwrite.h"
 #include "testWorkData.h"
 #include "testWrapper.h"
 #include "testWriteSupport.h"
@@ -413,6 +416,7 @@ globalTest(const int type,const int extra)
 {
   const std::vector<std::string> TestName=
     {
+      "testActivationSource",
       "testBnId",
       "testBoost",
       "testHeadRule",
@@ -445,6 +449,12 @@ globalTest(const int type,const int extra)
     {
       index++;
       int cnt(1);
+      if (index==cnt)
+	{
+	  testActivationSource A;
+	  X=A.applyTest(extra);
+	}
+      cnt++;
       if (index==cnt)
 	{
 	  testBnId A;
@@ -553,6 +563,7 @@ funcbaseTest(const int type,const int extra)
       std::cout<<"testFunction             (1)"<<std::endl;
       std::cout<<"testMD5                  (2)"<<std::endl;
       std::cout<<"testVarNameOrder         (3)"<<std::endl;
+      std::cout<<"testVTKwrite             (4)"<<std::endl;
     }
 
   if(type==1 || type<0)
@@ -573,6 +584,12 @@ funcbaseTest(const int type,const int extra)
       const int X=A.applyTest(extra);
       if (X) return -3;
     }
+  if(type==4 || type<0)
+    {
+      testVTKwrite A;
+      const int X=A.applyTest(extra);
+      if (X) return -4;
+    }
   return 0;
 }
 
@@ -908,9 +925,16 @@ physicsTest(const int type,const int extra)
   if (type==0)
     {
       TestFunc::Instance().reportTest(std::cout);
-      std::cout<<"testExtControl    (1)"<<std::endl;
+      std::cout<<"testCellValueSet  (1)"<<std::endl;
+      std::cout<<"testExtControl    (2)"<<std::endl;
     }
   if(type==1 || type<0)
+    {
+      testCellValueSet A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  if(type==2 || type<0)
     {
       testExtControl A;
       const int X=A.applyTest(extra);
@@ -101,6 +101,7 @@ class Reflector : public attachSystem::ContainedComp,
   void insertPipeObjects(Simulation&,const mainSystem::inputParam&);
 
   virtual std::string getExclude() const;
+  virtual HeadRule getExcludeRule() const;
 
   void createAll(Simulation&,const mainSystem::inputParam&);
 
@@ -45,12 +45,14 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "support.h"
 #include "Surface.h"
 #include "Quadratic.h"
 #include "Plane.h"
 #include "Rules.h"
 #include "HeadRule.h"
+#include "RuleBox.h"
 #include "Object.h"
 #include "surfRegister.h"
 #include "objectRegister.h"
@@ -334,7 +336,7 @@ addToInsertControl(Simulation& System,
                        "addToInsertControl(CM,string,FC,CC)");
 
   const std::vector<Geometry::Vec3D> linkPts=FC.getAllLinkPts();
-  const std::string excludeStr=CC.getExclude();
+  const HeadRule excludeRule=CC.getExcludeRule();
 
   for(const int cN : BaseObj.getCells(cellName))
     {
@@ -346,7 +348,7 @@ addToInsertControl(Simulation& System,
 	    {
 	      if (CRPtr->isValid(IP))
 		{
-		  CRPtr->addSurfString(excludeStr);
+		  CRPtr->addIntersection(excludeRule);
 		  break;
 		}
 	    }
@@ -375,7 +377,7 @@ addToInsertControl(Simulation& System,
   ELog::RegMethod RegA("AttachSupport","addToInsertControl");
 
   const std::vector<Geometry::Vec3D> linkPts=FC.getAllLinkPts();
-  const std::string excludeStr=CC.getExclude();
+  const HeadRule excludeRule=CC.getExcludeRule();
 
   for(const int CN : cellVec)
     {
@@ -387,7 +389,7 @@ addToInsertControl(Simulation& System,
 	    {
 	      if (CRPtr->isValid(IP))
 		{
-		  CRPtr->addSurfString(excludeStr);
+		  CRPtr->addIntersection(excludeRule);
 		  break;
 		}
 	    }
@@ -488,8 +490,6 @@ addToInsertSurfCtrl(Simulation& System,
 {
   ELog::RegMethod RegA("AttachSupport","addToInsertSurfCtrl(int,int,CC)");
 
-  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
-
   MonteCarlo::Object* CRPtr=System.findObject(cellA);
   if (!CRPtr) return;
   
@@ -521,7 +521,10 @@ addToInsertSurfCtrl(Simulation& System,
 {
   ELog::RegMethod RegA("AttachSupport","addToInsertSurfCtrl(int,int,CC)");
 
-  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
+  // component box/vertices are the same for each cell
+  const Geometry::BoundBox CCBox=calcOuterBox(CC);
+  const std::vector<Geometry::Vec3D> CCVertex=
+    calcSurfVertex(CC.getSurfaces());
 
   for(const int CN : cellVec)
     {
@@ -533,7 +536,7 @@ addToInsertSurfCtrl(Simulation& System,
 	  const std::vector<const Geometry::Surface*>&
 	    CellSVec=CRPtr->getSurList();
 	  
-	  if (checkIntersect(CC,*CRPtr,CellSVec))
+	  if (checkIntersect(CC,CCBox,CCVertex,*CRPtr,CellSVec))
 	    CC.addInsertCell(CN);
 	}
     }
@@ -560,8 +563,9 @@ addToInsertOuterSurfCtrl(Simulation& System,
 {
   ELog::RegMethod RegA("AttachSupport","addToInsertSurfCtrl(vec,CC)");
 
-  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces();
-
+  const Geometry::BoundBox CCBox=calcOuterBox(CC);
+  const std::vector<Geometry::Vec3D> CCVertex=
+    calcSurfVertex(CC.getSurfaces());
 
   // Populate and createSurface list MUST have been called      
   const std::vector<const Geometry::Surface*>
@@ -570,7 +574,7 @@ addToInsertOuterSurfCtrl(Simulation& System,
   for(const int CN : cellVec)
     {
       MonteCarlo::Object* CRPtr=System.findObject(CN);
-      if (CRPtr && checkIntersect(CC,*CRPtr,CellSVec))
+      if (CRPtr && checkIntersect(CC,CCBox,CCVertex,*CRPtr,CellSVec))
 	CC.addInsertCell(CN);
     }
 
@@ -578,10 +582,77 @@ addToInsertOuterSurfCtrl(Simulation& System,
   return;
 }
 
+Geometry::BoundBox
+calcOuterBox(const ContainedComp& CC)
+  /*!
+    Calculate the conservative box of the outer surface
+    of a ContainedComp
+    \param CC :: Contained Component
+    \return box [infinite if not bounded]
+  */
+{
+  ELog::RegMethod RegA("AttachSupport","calcOuterBox");
+
+  Geometry::BoundBox Out=
+    RuleBox::ruleBox(CC.getOuterSurf().getTopRule());
+  Out.grow(Geometry::shiftTol);
+  return Out;
+}
+
+std::vector<Geometry::Vec3D>
+calcSurfVertex(const std::vector<Geometry::Surface*>& SVec)
+  /*!
+    Calculate all the intersection points of three
+    different surfaces of a group
+    \param SVec :: Surfaces
+    \return intersection points
+  */
+{
+  ELog::RegMethod RegA("AttachSupport","calcSurfVertex");
+
+  std::vector<Geometry::Vec3D> Out;
+  for(size_t iA=0;iA<SVec.size();iA++)
+    for(size_t iB=iA+1;iB<SVec.size();iB++)
+      for(size_t iC=iB+1;iC<SVec.size();iC++)
+	{
+	  const std::vector<Geometry::Vec3D> Pts=
+	    SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
+	  Out.insert(Out.end(),Pts.begin(),Pts.end());
+	}
+  return Out;
+}
+
+bool
+checkBoxCross(const Geometry::Surface* SPtr,const Geometry::BoundBox& Box)
+  /*!
+    Determine if a surface can pass through a box. Only planes
+    are tested [against the extreme corners] : all other
+    surfaces are assumed to cross.
+    \param SPtr :: Surface
+    \param Box :: Box
+    \return false if the surface cannot meet the box
+  */
+{
+  const Geometry::Plane* PPtr=dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (!PPtr || !Box.isFinite()) return 1;
+
+  const Geometry::Vec3D& N=PPtr->getNormal();
+  double minV(-PPtr->getDistance());
+  double maxV(minV);
+  for(size_t i=0;i<3;i++)
+    {
+      const double A(N[i]*Box.low(i));
+      const double B(N[i]*Box.high(i));
+      minV+=std::min(A,B);
+      maxV+=std::max(A,B);
+    }
+  return (minV<=Geometry::zeroTol && maxV>=-Geometry::zeroTol);
+}
+
 bool
 checkIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
 	       const std::vector<const Geometry::Surface*>& CellSVec)
-   /*
+   /*!
      Determine if the surface group is in the Contained Component
      \param CC :: Contained Component
      \param CellObj :: Cell Object
@@ -590,49 +661,87 @@ checkIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
    */
 {
   ELog::RegMethod RegA("AttachSupport","checkInsert");
-  //  ELog::debugMethod DegA;
+
+  return checkIntersect(CC,calcOuterBox(CC),
+			calcSurfVertex(CC.getSurfaces()),
+			CellObj,CellSVec);
+}
+
+bool
+checkIntersect(const ContainedComp& CC,
+	       const Geometry::BoundBox& CCBox,
+	       const std::vector<Geometry::Vec3D>& CCVertex,
+	       const MonteCarlo::Object& CellObj,
+	       const std::vector<const Geometry::Surface*>& CellSVec)
+   /*!
+     Determine if the surface group is in the Contained Component.
+     The component vertices are tested first as they need not
+     be within the component box. Any other point found must be
+     in both the cell box and the component box so surfaces
+     that miss the boxes are not used.
+     \param CC :: Contained Component
+     \param CCBox :: Box of the CC outer surface [calcOuterBox]
+     \param CCVertex :: Surface vertices of the CC [calcSurfVertex]
+     \param CellObj :: Cell Object
+     \param CellSVec :: Cell vector
+     \return true/false
+   */
+{
+  ELog::RegMethod RegA("AttachSupport","checkInsert");
+
+  const Geometry::BoundBox& CellBox=CellObj.getBoundBox();
+  for(const Geometry::Vec3D& Pt : CCVertex)
+    {
+      if (CellBox.isValid(Pt) && CellObj.isValid(Pt))
+	return 1;
+    }
+  
+  if (!CCBox.overlap(CellBox))
+    return 0;
+  
+  Geometry::BoundBox ActiveBox(CCBox);
+  ActiveBox&=CellBox;
+  
   const std::vector<Geometry::Surface*>& SVec=CC.getSurfaces(); 
+  std::vector<const Geometry::Surface*> ASVec;
+  std::vector<const Geometry::Surface*> BSVec;
+  for(const Geometry::Surface* SPtr : SVec)
+    if (checkBoxCross(SPtr,ActiveBox))
+      ASVec.push_back(SPtr);
+  for(const Geometry::Surface* SPtr : CellSVec)
+    if (checkBoxCross(SPtr,ActiveBox))
+      BSVec.push_back(SPtr);
+  
   std::vector<Geometry::Vec3D> Out;
   std::vector<Geometry::Vec3D>::const_iterator vc;
 
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=0;iB<CellSVec.size();iB++)
-      for(size_t iC=iB+1;iC<CellSVec.size();iC++)
+  for(size_t iA=0;iA<ASVec.size();iA++)
+    for(size_t iB=0;iB<BSVec.size();iB++)
+      for(size_t iC=iB+1;iC<BSVec.size();iC++)
 	{	      
-	  Out=SurInter::processPoint(SVec[iA],CellSVec[iB],CellSVec[iC]);
+	  Out=SurInter::processPoint(ASVec[iA],BSVec[iB],BSVec[iC]);
 	  for(vc=Out.begin();vc!=Out.end();vc++)
 	    {
 	      std::set<int> boundarySet;
-	      boundarySet.insert(CellSVec[iB]->getName());
-	      boundarySet.insert(CellSVec[iC]->getName());		  
+	      boundarySet.insert(BSVec[iB]->getName());
+	      boundarySet.insert(BSVec[iC]->getName());		  
 	      // Outer valid returns true if out of object
 	      if (CellObj.isValid(*vc,boundarySet) &&
-		  !CC.isOuterValid(*vc,SVec[iA]->getName()))
-		return 1;
-	    }
-	}
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=iA+1;iB<SVec.size();iB++)
-      for(size_t iC=iB+1;iC<SVec.size();iC++)
-	{
-	  Out=SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
-	  for(vc=Out.begin();vc!=Out.end();vc++)
-	    {
-	      if (CellObj.isValid(*vc))
+		  !CC.isOuterValid(*vc,ASVec[iA]->getName()))
 		return 1;
 	    }
 	}
-  for(size_t iA=0;iA<SVec.size();iA++)
-    for(size_t iB=iA+1;iB<SVec.size();iB++)
-      for(size_t iC=0;iC<CellSVec.size();iC++)
+  for(size_t iA=0;iA<ASVec.size();iA++)
+    for(size_t iB=iA+1;iB<ASVec.size();iB++)
+      for(size_t iC=0;iC<BSVec.size();iC++)
 	{
-	  Out=SurInter::processPoint(SVec[iA],SVec[iB],CellSVec[iC]);
+	  Out=SurInter::processPoint(ASVec[iA],ASVec[iB],BSVec[iC]);
 	  for(vc=Out.begin();vc!=Out.end();vc++)
 	    {
 	      std::set<int> boundarySet;
-	      boundarySet.insert(SVec[iA]->getName());
-	      boundarySet.insert(SVec[iB]->getName());
-	      if (CellObj.isValid(*vc,CellSVec[iC]->getName()) &&
+	      boundarySet.insert(ASVec[iA]->getName());
+	      boundarySet.insert(ASVec[iB]->getName());
+	      if (CellObj.isValid(*vc,BSVec[iC]->getName()) &&
 		  !CC.isOuterValid(*vc,boundarySet))
 		{
 		  return 1;
@@ -267,8 +267,7 @@ addToInsertLineCtrl(Simulation& System,
 
   if (CRPtr && checkLineIntersect(InsertFC,*CRPtr))
     {
-      const std::string excludeStr=CC.getExclude();
-      CRPtr->addSurfString(excludeStr);
+      CRPtr->addIntersection(CC.getExcludeRule());
     }
   return;
 }
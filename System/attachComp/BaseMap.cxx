@@ -599,5 +599,28 @@ BaseMap::changeCell(const int oldCell,const int newCell)
   return 0;
 }
 
+size_t
+BaseMap::changeCell(const std::map<int,int>& RMap)
+  /*!
+    Change a set of cell numbers in one pass
+    \param RMap :: Map of old number : new number
+    \return number of cells changed
+  */
+{
+  ELog::RegMethod RegA("BaseMap","changeCell");
+
+  size_t cnt(0);
+  for(LCTYPE::value_type& IUnit : Items)
+    for(int& CN : IUnit.second)
+      {
+	const std::map<int,int>::const_iterator mc=RMap.find(CN);
+	if (mc!=RMap.end())
+	  {
+	    CN=mc->second;
+	    cnt++;
+	  }
+      }
+  return cnt;
+}
  
 }  // NAMESPACE attachSystem
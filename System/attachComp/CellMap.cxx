@@ -495,4 +495,17 @@ CellMap::renumberCell(const int oldCell,const int newCell)
   return;
 }
 
+void
+CellMap::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber a set of cells -- cells not found are ignored
+    \param RMap :: Map of old cell number : new cell number
+  */
+{
+  ELog::RegMethod RegA("CellMap","renumberCell");
+  
+  changeCell(RMap);
+  return;
+}
+
 }  // NAMESPACE attachSystem
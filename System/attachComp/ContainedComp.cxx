@@ -348,6 +348,20 @@ ContainedComp::getExclude() const
   return "";
 }
 
+HeadRule
+ContainedComp::getExcludeRule() const
+  /*!
+    Calculate the excluded rule [complement of the outer
+    surface]. This allows the object to be inserted in
+    a larger object without a string round trip.
+    \return Exclude rule [empty if no outer surface]
+  */
+{
+  ELog::RegMethod RegA("ContainedComp","getExcludeRule");
+  
+  return (outerSurf.hasRule()) ? outerSurf.complement() : HeadRule();
+}
+
 std::string
 ContainedComp::getContainer() const
   /*!
@@ -654,13 +668,12 @@ ContainedComp::insertExternalObject(Simulation& System,
 {
   ELog::RegMethod RegA("ContainedComp","insertExternalObject");
   
-  const std::string excludeStr=
-    excludeObj.getHeadRule().complement().display();
+  const HeadRule excludeRule=excludeObj.getHeadRule().complement();
   for(const int CN : insertCells)
     {
       MonteCarlo::Object* outerObj=System.findObject(CN);
       if (outerObj)
-	outerObj->addSurfString(excludeStr);
+	outerObj->addIntersection(excludeRule);
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
     }
@@ -677,11 +690,12 @@ ContainedComp::insertObjects(Simulation& System)
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
 
+  const HeadRule excludeRule=getExcludeRule();
   for(const int CN : insertCells)
     {
       MonteCarlo::Object* outerObj=System.findObject(CN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addIntersection(excludeRule);
 
       else
 	ELog::EM<<"Failed to find outerObject: "<<CN<<ELog::endErr;
@@ -703,6 +717,7 @@ ContainedComp::insertObjects(Simulation& System,
   ELog::RegMethod RegA("ContainedComp","insertObjects");
   if (!hasOuterSurf()) return;
 
+  const HeadRule excludeRule=getExcludeRule();
   for(const int CN : insertCells)
     {
       MonteCarlo::Object* outerObj=System.findObject(CN);
@@ -713,7 +728,7 @@ ContainedComp::insertObjects(Simulation& System,
 	    {
 	      if (HR.isValid(Pts))
 		{
-		  outerObj->addSurfString(getExclude());
+		  outerObj->addIntersection(excludeRule);
 		  break;
 		}
 	    }
@@ -741,7 +756,7 @@ ContainedComp::insertInCell(Simulation& System,
   MonteCarlo::Object* outerObj=System.findObject(cellN);
 
   if (outerObj)
-    outerObj->addSurfString(getExclude());
+    outerObj->addIntersection(getExcludeRule());
   else
     throw ColErr::InContainerError<int>(cellN,"Cell not in Simulation");
   return;
@@ -759,11 +774,12 @@ ContainedComp::insertInCell(Simulation& System,
   ELog::RegMethod RegA("ContainedComp","insertInCell(Vec)");
   
   if (!hasOuterSurf()) return;
+  const HeadRule excludeRule=getExcludeRule();
   for(const int cellN : cellVec)
     {
       MonteCarlo::Object* outerObj=System.findObject(cellN);
       if (outerObj)
-	outerObj->addSurfString(getExclude());
+	outerObj->addIntersection(excludeRule);
       else
 	throw ColErr::InContainerError<int>(cellN,"Cell not in Simulation");
     }
@@ -26,6 +26,11 @@ class Rule;
 class Simulation;
 class HeadRule;
 
+namespace Geometry
+{
+  class BoundBox;
+}
+
 namespace attachSystem
 {
 
@@ -88,8 +93,16 @@ void addToInsertForced(Simulation&,const std::vector<int>&,
 		       ContainedComp&);
 
 // External check system
+Geometry::BoundBox calcOuterBox(const ContainedComp&);
+std::vector<Geometry::Vec3D>
+calcSurfVertex(const std::vector<Geometry::Surface*>&);
+bool checkBoxCross(const Geometry::Surface*,const Geometry::BoundBox&);
 bool checkIntersect(const ContainedComp&,const MonteCarlo::Object&,
 		    const std::vector<const Geometry::Surface*>&);
+bool checkIntersect(const ContainedComp&,const Geometry::BoundBox&,
+		    const std::vector<Geometry::Vec3D>&,
+		    const MonteCarlo::Object&,
+		    const std::vector<const Geometry::Surface*>&);
 
 bool checkLineIntersect(const FixedComp&,const MonteCarlo::Object&);
 
@@ -84,6 +84,7 @@ class BaseMap
   bool registerExtra(const int,const int);
 
   bool changeCell(const int,const int);
+  size_t changeCell(const std::map<int,int>&);
   
   std::string removeItemNumber(const int,const size_t =0);
   int removeItem(const std::string&,const size_t =0);
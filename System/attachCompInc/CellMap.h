@@ -100,6 +100,7 @@ class CellMap  : public BaseMap
     {  return BaseMap::removeItem(K,Index); }
 
   void renumberCell(const int,const int);
+  void renumberCell(const std::map<int,int>&);
 
   // Insert the cellMap object into the cell
   void insertCellMapInCell(Simulation&,const std::string&,
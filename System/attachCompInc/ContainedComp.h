@@ -65,6 +65,7 @@ class ContainedComp
 
   virtual const HeadRule& getOuterSurf() const;
   virtual std::string getExclude() const;
+  virtual HeadRule getExcludeRule() const;
   virtual std::string getCompExclude() const;
   virtual std::string getContainer() const;
   virtual std::string getCompContainer() const;
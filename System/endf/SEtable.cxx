@@ -118,7 +118,7 @@ SEtable::STotal(const double energy) const
     \return \sigma_tot(E)
   */
 {
-  ELog::RegMethod RegA("SEtable","STotal");
+  ELog::RegHot RegA("SEtable","STotal");
 
   if (E.empty())
     ELog::EM<<"Energy empty "<<ELog::endErr;
@@ -256,7 +256,7 @@ SQWtable::Sab(const double alphaV,const double betaV) const
     \return S(Q,w)
   */
 {
-  ELog::RegMethod RegA("SQWtable","Sab");
+  ELog::RegHot RegA("SQWtable","Sab");
 
   long int aInt,bInt;
   if (!isValidRangePt(alphaV,betaV,aInt,bInt))
@@ -105,7 +105,8 @@ template<size_t N>
 cellValueSet<N>::cellValueSet(const cellValueSet<N>& A) : 
   keyName(A.keyName),outName(A.outName),tag(A.tag),
   scaleVec(A.scaleVec),dataMap(A.dataMap),
-  strRegister(A.strRegister),intRegister(A.intRegister)
+  strRegister(A.strRegister),intRegister(A.intRegister),
+  strValue(A.strValue),strValueIndex(A.strValueIndex)
   /*!
     Copy constructor
     \param A :: cellValueSet to copy
@@ -126,6 +127,8 @@ cellValueSet<N>::operator=(const cellValueSet<N>& A)
       dataMap=A.dataMap;
       strRegister=A.strRegister;
       intRegister=A.intRegister;
+      strValue=A.strValue;
+      strValueIndex=A.strValueIndex;
       scaleVec=A.scaleVec;
     }
   return *this;
@@ -148,6 +151,8 @@ cellValueSet<N>::clearAll()
   dataMap.erase(dataMap.begin(),dataMap.end());
   strRegister.erase(strRegister.begin(),strRegister.end());
   intRegister.erase(intRegister.begin(),intRegister.end());
+  strValue.clear();
+  strValueIndex.clear();
   return;
 }
 
@@ -192,6 +197,63 @@ cellValueSet<N>::getStrIndex(const int CN) const
   return mc->second;
 }
   
+template<size_t N>
+bool
+cellValueSet<N>::equalValue(const valTYPE& A,const valTYPE& B)
+  /*!
+    Determine if two value sets are the same 
+    [def = def is a pass / string by index]
+    \param A :: First value set
+    \param B :: Second value set
+    \return true if the same for output
+  */
+{
+  for(size_t index=0;index<N;index++)
+    {
+      if (A[index].first!=B[index].first ||
+	  (A[index].first &&
+	   std::abs(A[index].second-B[index].second)>Geometry::zeroTol))
+	return 0;
+    }
+  return 1;
+}
+
+template<size_t N>
+void
+cellValueSet<N>::setStrValue(std::pair<int,double>& Item,
+			     const std::string& V)
+  /*!
+    Set an item from a string : def / number / string tag
+    \param Item :: Item to set
+    \param V :: String value
+  */
+{
+  double D;
+  if (V=="def" || V=="Def")
+    {
+      Item.first=0;
+      Item.second=0.0;
+    }
+  else if (StrFunc::convert(V,D))
+    {
+      Item.first=1;
+      Item.second=D;
+    }
+  else
+    {
+      std::map<std::string,size_t>::const_iterator mc=
+	strValueIndex.find(V);
+      if (mc==strValueIndex.end())
+	{
+	  mc=strValueIndex.emplace(V,strValue.size()).first;
+	  strValue.push_back(V);
+	}
+      Item.first= -1;
+      Item.second=static_cast<double>(mc->second);
+    }
+  return;
+}
+  
 template<size_t N>  
 bool
 cellValueSet<N>::simpleSplit(std::vector<std::tuple<int,int>>& initCell,
@@ -202,10 +264,11 @@ cellValueSet<N>::simpleSplit(std::vector<std::tuple<int,int>>& initCell,
     goal of this method is to minimize the number of fluka cards. e.g
     cell 1 to 10 might all have the same importance values, so they can
     be expressed in FLUKA as a single importance/bias card with a range 
-    of cells.
+    of cells. A range is broken by a gap in the cell numbers
+    so the ordered map is walked once.
 
     \param initCell :: initialization range
-    \param dataValue :: initialization range
+    \param outData :: values for each range
     \return true if output required
    */
 {
@@ -215,58 +278,26 @@ cellValueSet<N>::simpleSplit(std::vector<std::tuple<int,int>>& initCell,
   outData.clear();
 
   if (dataMap.empty()) return 0;
-  const int lastCN=dataMap.rbegin()->first+1;       //ordered map
 
-  int prev(0);
-  valTYPE V;
-  for(int CN=dataMap.begin()->first;CN<=lastCN;CN++)
+  typename dataTYPE::const_iterator mc=dataMap.begin();
+  int AA(mc->first);
+  int AB(mc->first);
+  const valTYPE* VPtr(&mc->second);
+  for(++mc;mc!=dataMap.end();++mc)
     {
-      typename dataTYPE::const_iterator mc=dataMap.find(CN);	  
-      if (mc==dataMap.end())
+      if (mc->first!=AB+1 || !equalValue(*VPtr,mc->second))
 	{
-	  if (prev)
-	    {
-	      initCell.push_back(TITEM(prev,CN-1));
-	      outData.push_back(V);
-	      prev=0;
-	    }
-	}
-      else
-	{
-	  if (prev)
-	    {
-	      for(size_t index=0;index<N;index++)
-		{
-		  const int& VDef=V[index].first;
-		  const std::string& VS=V[index].second;
-		  const int& ADef=mc->second[index].first;
-		  const std::string& AS=mc->second[index].second;
-
-		  double VV,AV;
-		  int sumFlag=(VDef<1) ? 0 : StrFunc::convert(VS,VV);
-		  sumFlag+= (ADef<1) ? 0 : StrFunc::convert(AS,AV);
-
-		  if (VDef!=ADef ||           // diff flag
-		      (VDef &&                // def = def is a pass
-		       ((sumFlag!=2 && AS!=VS) ||
-			(sumFlag==2 && (std::abs(VV-AV)>Geometry::zeroTol))) ))
-		    {
-		      initCell.push_back(TITEM(prev,CN-1));
-		      outData.push_back(V);
-		      prev=CN;
-		      V=mc->second;
-		      break;
-		    }
-		}
-	    }
-	  else // new thing just initializs
-	    {
-	      prev=CN;
-	      V=mc->second;
-	    }
+	  initCell.push_back(TITEM(AA,AB));
+	  outData.push_back(*VPtr);
+	  AA=mc->first;
+	  VPtr=&mc->second;
 	}
+      AB=mc->first;
     }
-  return (initCell.empty()) ? 0 : 1;
+  initCell.push_back(TITEM(AA,AB));
+  outData.push_back(*VPtr);
+  
+  return 1;
 }
   
 template<size_t N>  
@@ -280,11 +311,11 @@ cellValueSet<N>::cellSplit(const std::vector<int>& cellN,
     goal of this method is to minimize the number of fluka cards. e.g
     cell 1 to 10 might all have the same importance values, so they can
     be expressed in FLUKA as a single importance/bias card with a range 
-    of cells.
+    of cells. Adjacent is by position in cellN.
 
     \param cellN :: Cell values [normally excluding 0]
     \param initCell :: initialization range
-    \param dataValue :: initialization range
+    \param outData :: values for each range
     \return true if output required
    */
 {
@@ -293,66 +324,65 @@ cellValueSet<N>::cellSplit(const std::vector<int>& cellN,
   outData.clear();
  
   if (dataMap.empty() || cellN.empty()) return 0;
+
+  const valTYPE* VPtr(0);
   size_t prev(0);
-  valTYPE V;
   for(size_t i=0;i<cellN.size();i++)
     {
-      const int CN=cellN[i];
-      typename dataTYPE::const_iterator mc=dataMap.find(CN);
+      typename dataTYPE::const_iterator mc=dataMap.find(cellN[i]);
       if (mc==dataMap.end())
 	{
-	  if (prev)
+	  if (VPtr)
 	    {
-	      initCell.push_back(TITEM(cellN[prev-1],cellN[i-1]));
-	      outData.push_back(V);
-	      prev=0;
+	      initCell.push_back(TITEM(cellN[prev],cellN[i-1]));
+	      outData.push_back(*VPtr);
+	      VPtr=0;
 	    }
 	}
-      else
+      else if (!VPtr)
 	{
-	  if (prev)
-	    {
-	      for(size_t index=0;index<N;index++)
-		{
-		  const int& VDef=V[index].first;
-		  const std::string& VS=V[index].second;
-		  const int& ADef=mc->second[index].first;
-		  const std::string& AS=mc->second[index].second;
-
-		  double VV,AV;
-		  int sumFlag=(VDef<1) ? 0 : StrFunc::convert(VS,VV);
-		  sumFlag+= (ADef<1) ? 0 : StrFunc::convert(AS,AV);
-
-		  if (VDef!=ADef ||           // diff flag
-		      (VDef &&                // def = def is a pass
-		       ((sumFlag!=2 && AS!=VS) ||
-			(sumFlag==2 && (std::abs(VV-AV)>Geometry::zeroTol))) ))
-		    {
-		      initCell.push_back(TITEM(cellN[prev-1],cellN[i-1]));
-		      outData.push_back(V);
-		      prev=i+1;
-		      V=mc->second;
-		      break;
-		    }
-		}
-	    }
-	  else if (!prev)
-	    {
-	      prev=i+1;
-	      V=mc->second;
-	    }
+	  prev=i;
+	  VPtr=&mc->second;
+	}
+      else if (!equalValue(*VPtr,mc->second))
+	{
+	  initCell.push_back(TITEM(cellN[prev],cellN[i-1]));
+	  outData.push_back(*VPtr);
+	  prev=i;
+	  VPtr=&mc->second;
 	}
     }
 
-
-  if (prev)
+  if (VPtr)
     {
-      initCell.push_back(TITEM(cellN[prev-1],cellN.back()));
-      outData.push_back(V);
+      initCell.push_back(TITEM(cellN[prev],cellN.back()));
+      outData.push_back(*VPtr);
     }
   return (initCell.empty()) ? 0 : 1;
 }
 
+template<size_t N> 
+void
+cellValueSet<N>::setValue(const int cN,const size_t index,
+			  const double V)
+  /*!
+    Set a single value in the map [others default if new]
+    \param cN :: Cell number   
+    \param index :: value index
+    \param V :: value for cell
+  */
+{
+  ELog::RegMethod RegA("cellValueSet","setValue");
+  
+  if (index>=N)
+    throw ColErr::IndexError<size_t>(index,N,"index");
+
+  typename dataTYPE::iterator mc=dataMap.find(cN);
+  if (mc==dataMap.end())
+    mc=dataMap.emplace(cN,valTYPE()).first;
+  mc->second[index]=std::pair<int,double>(1,V);
+  return;
+}
 
 template<size_t N> 
 void
@@ -363,6 +393,7 @@ cellValueSet<N>::setValues(const int cN)
   */
 {
   valTYPE A;
+  A.fill(std::pair<int,double>(0,0.0));
   dataMap[cN]=A;
   return;
 }
@@ -377,8 +408,8 @@ cellValueSet<N>::setValues(const int cN,const double V)
   */
 {
   valTYPE A;
-  A[0].first=1;
-  A[0].second=StrFunc::makeString(V);
+  A.fill(std::pair<int,double>(0,0.0));
+  A[0]=std::pair<int,double>(1,V);
   dataMap[cN]=A;
   return;
 }
@@ -396,10 +427,9 @@ cellValueSet<N>::setValues(const int cN,
   */
 {
   valTYPE A;
-  A[0].first=1;
-  A[0].second=StrFunc::makeString(V);
-  A[1].first=1;
-  A[1].second=StrFunc::makeString(V2);
+  A.fill(std::pair<int,double>(0,0.0));
+  A[0]=std::pair<int,double>(1,V);
+  A[1]=std::pair<int,double>(1,V2);
   dataMap[cN]=A;
   return;
 }
@@ -417,12 +447,10 @@ cellValueSet<N>::setValues(const int cN,const double V,
   */
 {
   valTYPE A;
-  A[0].first=1;         // 1: values
-  A[0].second=StrFunc::makeString(V);
-  A[1].first=1;
-  A[1].second=StrFunc::makeString(V2);
-  A[2].first=1;
-  A[2].second=StrFunc::makeString(V3);
+  A.fill(std::pair<int,double>(0,0.0));
+  A[0]=std::pair<int,double>(1,V);         // 1: values
+  A[1]=std::pair<int,double>(1,V2);
+  A[2]=std::pair<int,double>(1,V3);
   dataMap[cN]=A;
   return;
 }
@@ -437,14 +465,8 @@ cellValueSet<N>::setValues(const int cN,const std::string& V)
   */
 {
   valTYPE A;
-  if (V=="def" || V=="Def")
-    A[0].first=0;
-  else
-    {
-      double D;
-      A[0].first= (StrFunc::convert(V,D)) ? 1 : -1;
-      A[0].second=V;
-    }
+  A.fill(std::pair<int,double>(0,0.0));
+  setStrValue(A[0],V);
   dataMap[cN]=A;
   return;
 }
@@ -461,19 +483,11 @@ cellValueSet<N>::setValues(const int cN,const std::string& V1,
   */
 {
   valTYPE A;
+  A.fill(std::pair<int,double>(0,0.0));
   const std::vector<const std::string*> VStr({&V1,&V2});
   for(size_t i=0;i<VStr.size() && i<N;i++)
-    {
-      if (*VStr[i]=="def" || *VStr[i]=="Def")
-	A[i].first=0;
-      else
-	{
-	  double D;
-	  A[i].first= (StrFunc::convert(*VStr[i],D)) ? 1 : -1;
-	  A[i].second= *VStr[i];
-	}
-      
-    }
+    setStrValue(A[i],*VStr[i]);
+
   dataMap[cN]=A;
   return;
 }
@@ -492,18 +506,11 @@ cellValueSet<N>::setValues(const int cN,const std::string& V1,
   */
 {
   valTYPE A;
+  A.fill(std::pair<int,double>(0,0.0));
   const std::vector<const std::string*> VStr({&V1,&V2,&V3});
   for(size_t i=0;i<VStr.size() && i<N;i++)
-    {
-      if (*VStr[i]=="def" || *VStr[i]=="Def")
-	A[i].first=0;
-      else
-	{
-	  double D;
-	  A[i].first= (StrFunc::convert(*VStr[i],D)) ? 1 : -1;
-	  A[i].second= *VStr[i];
-	}
-    }
+    setStrValue(A[i],*VStr[i]);
+
   dataMap[cN]=A;
   return;
 }
@@ -574,77 +581,92 @@ cellValueSet<N>::setValues(const std::string& cStr,
 
 template<size_t N>
 void
-cellValueSet<N>::writeFLUKA(std::ostream& OX,
-			    const std::string& ControlStr) const 
+cellValueSet<N>::writeGroups(std::ostream& OX,
+			     const std::string& ControlStr,
+			     const std::vector<std::tuple<int,int>>& Bgroup,
+			     const std::vector<valTYPE>& Bdata) const 
 /*!
-    Process is to write keyName ControlStr units 
+    Write a card for each group of cells. The values of
+    each group are formatted once.
     \param OX :: Output stream
     \param ControlStr units [%0/%1/%2] for cell range/Value
+    \param Bgroup :: Cell ranges
+    \param Bdata :: Values for each range
   */
 {
-  ELog::RegMethod RegA("cellValueSet","writeFLUKA[no-cell]");
+  ELog::RegMethod RegA("cellValueSet","writeGroups");
   
   typedef std::tuple<int,int> TITEM;
 
   std::ostringstream cx;
-  std::vector<TITEM> Bgroup;
-  std::vector<valTYPE> Bdata;
+  const std::vector<std::string> Units=StrFunc::StrParts(ControlStr);
+  std::vector<std::string> SArray(3+N);
 
-  if (simpleSplit(Bgroup,Bdata))
+  for(size_t index=0;index<Bgroup.size();index++)
     {
-      const std::vector<std::string> Units=StrFunc::StrParts(ControlStr);
-      std::vector<std::string> SArray(3+N);
+      const TITEM& tc(Bgroup[index]);
+      const valTYPE& dArray(Bdata[index]);
 
-      for(size_t index=0;index<Bgroup.size();index++)
-	{
-	  const TITEM& tc(Bgroup[index]);
-	  const valTYPE& dArray(Bdata[index]);
-
-	  const int AA=std::get<0>(tc);
-	  const int AB=std::get<1>(tc);
-	  SArray[0]=(AA<0) ? getStrIndex(AA) : std::to_string(AA);
-	  SArray[1]=(AB<0) ? getStrIndex(AB) : std::to_string(AB);
+      const int AA=std::get<0>(tc);
+      const int AB=std::get<1>(tc);
+      SArray[0]=(AA<0) ? getStrIndex(AA) : std::to_string(AA);
+      SArray[1]=(AB<0) ? getStrIndex(AB) : std::to_string(AB);
 
-	  for(size_t i=0;i<N;i++)
-	    {
-	      if (dArray[i].first==1)
-		{
-		  double D;
-		  StrFunc::convert(dArray[i].second,D);
-		  SArray[2+i]=StrFunc::makeString(D*scaleVec[i]);
-		}
-	      else if (dArray[i].first == -1)
-		SArray[2+i]=dArray[i].second;
-	      else
-		SArray[2+i]="-";
-	    }
-	  cx.str("");
-	  cx<<outName<<" ";
+      for(size_t i=0;i<N;i++)
+	{
+	  if (dArray[i].first==1)
+	    SArray[2+i]=StrFunc::makeString(dArray[i].second*scaleVec[i]);
+	  else if (dArray[i].first == -1)
+	    SArray[2+i]=strValue[static_cast<size_t>(dArray[i].second)];
+	  else
+	    SArray[2+i]="-";
+	}
+      cx.str("");
+      cx<<outName<<" ";
 
-	  for(const std::string& UC : Units)
+      for(const std::string& UC : Units)
+	{
+	  if (UC.size()==2 &&
+	      (UC[0]=='%' || UC[0]=='R' ||
+	       UC[0]=='M' || UC[0]=='P'))
 	    {
-	      if (UC.size()==2 &&
-		  (UC[0]=='%' || UC[0]=='R' ||
-		   UC[0]=='M' || UC[0]=='P'))
-		{
-		  const size_t SA=(static_cast<size_t>(UC[1]-'0') % (N+2));
-		  if (UC[0]=='%')
-		    cx<<SArray[SA]<<" ";
-		  else if (UC[0]=='M' || UC[0]=='R')
-		    cx<<UC[0]<<SArray[SA]<<" ";
-		  else if (UC[0]=='P')
-		    cx<<StrFunc::toUpperString(SArray[SA])<<" ";
-		}
-	      else
-		cx<<UC<<" ";
+	      const size_t SA=(static_cast<size_t>(UC[1]-'0') % (N+2));
+	      if (UC[0]=='%')
+		cx<<SArray[SA]<<" ";
+	      else if (UC[0]=='M' || UC[0]=='R')
+		cx<<UC[0]<<SArray[SA]<<" ";
+	      else if (UC[0]=='P')
+		cx<<StrFunc::toUpperString(SArray[SA])<<" ";
 	    }
-	  cx<<tag;
-	  StrFunc::writeFLUKA(cx.str(),OX);
+	  else
+	    cx<<UC<<" ";
 	}
+      cx<<tag;
+      StrFunc::writeFLUKA(cx.str(),OX);
     }
   return;
 }
 
+template<size_t N>
+void
+cellValueSet<N>::writeFLUKA(std::ostream& OX,
+			    const std::string& ControlStr) const 
+/*!
+    Process is to write keyName ControlStr units 
+    \param OX :: Output stream
+    \param ControlStr units [%0/%1/%2] for cell range/Value
+  */
+{
+  ELog::RegMethod RegA("cellValueSet","writeFLUKA[no-cell]");
+  
+  std::vector<std::tuple<int,int>> Bgroup;
+  std::vector<valTYPE> Bdata;
+
+  if (simpleSplit(Bgroup,Bdata))
+    writeGroups(OX,ControlStr,Bgroup,Bdata);
+  return;
+}
+
 template<size_t N>
 void
 cellValueSet<N>::writeFLUKA(std::ostream& OX,
@@ -659,65 +681,11 @@ cellValueSet<N>::writeFLUKA(std::ostream& OX,
 {
   ELog::RegMethod RegA("cellValueSet","writeFLUKA");
   
-  typedef std::tuple<int,int> TITEM;
-
-  std::ostringstream cx;
-  std::vector<TITEM> Bgroup;
+  std::vector<std::tuple<int,int>> Bgroup;
   std::vector<valTYPE> Bdata;
 
   if (cellSplit(cellN,Bgroup,Bdata))
-    {	
-      const std::vector<std::string> Units=StrFunc::StrParts(ControlStr);
-      std::vector<std::string> SArray(3+N);
-
-      for(size_t index=0;index<Bgroup.size();index++)
-	{
-	  const TITEM& tc(Bgroup[index]);
-	  const valTYPE& dArray(Bdata[index]);
-
-	  const int AA=std::get<0>(tc);
-	  const int AB=std::get<1>(tc);
-	  SArray[0]=(AA<0) ? getStrIndex(AA) : std::to_string(AA);
-	  SArray[1]=(AB<0) ? getStrIndex(AB) : std::to_string(AB);
-	  for(size_t i=0;i<N;i++)
-	    {
-	      if (dArray[i].first==1)
-		{
-		  double D;
-		  StrFunc::convert(dArray[i].second,D);
-		  SArray[2+i]=StrFunc::makeString(D*scaleVec[i]);
-		}
-	      else if (dArray[i].first == -1)
-		SArray[2+i]=dArray[i].second;
-	      else
-		SArray[2+i]="-";
-	    }
-	  cx.str("");
-	  cx<<outName<<" ";
-
-	  for(const std::string& UC : Units)
-	    {
-	      if (UC.size()==2 &&
-		  (UC[0]=='%' || UC[0]=='R' || UC[0]=='M'
-		   || UC[0]=='P'))
-		{
-		  const size_t SA=(static_cast<size_t>(UC[1]-'0') % (N+2));
-		  if (UC[0]=='%')
-		    cx<<SArray[SA]<<" ";
-		  else if (UC[0]=='M' || UC[0]=='R')
-		    cx<<UC[0]<<SArray[SA]<<" ";
-		  else if (UC[0]=='P')
-		    cx<<StrFunc::toUpperString(SArray[SA])<<" ";
-		}
-	      else
-		cx<<UC<<" ";
-	    }
-	  cx<<tag;
-
-
-	  StrFunc::writeFLUKA(cx.str(),OX);
-	}
-    }
+    writeGroups(OX,ControlStr,Bgroup,Bdata);
   return;
 }
 
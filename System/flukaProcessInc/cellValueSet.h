@@ -31,6 +31,10 @@ namespace flukaSystem
   \date March 2018
   \author S.Ansell
   \brief Processes the physics cards in the FLUKA output
+
+  Numbers are held as full doubles: cells are grouped on the
+  value [within zeroTol] and scaleVec is applied before the
+  output is rounded to 6 significant figures.
 */
 
 template <size_t N>
@@ -38,8 +42,8 @@ class cellValueSet
 {
  private:
 
-  /// Data type [-1:string / 0:def / 1 double]
-  typedef  std::array<std::pair<int,std::string>,N> valTYPE;  
+  /// Data type [-1:string index / 0:def / 1 double] : value
+  typedef  std::array<std::pair<int,double>,N> valTYPE;  
   /// map type [-ve int for string type]
   typedef  std::map<int,valTYPE> dataTYPE;
 
@@ -52,6 +56,12 @@ class cellValueSet
 
   std::map<int,std::string> strRegister;   ///< string register
   std::map<std::string,int> intRegister;   ///< string to int regier
+
+  std::vector<std::string> strValue;       ///< string values [opt-in]
+  std::map<std::string,size_t> strValueIndex;  ///< string to value index
+  
+  static bool equalValue(const valTYPE&,const valTYPE&);
+  void setStrValue(std::pair<int,double>&,const std::string&);
   
   bool simpleSplit(std::vector<std::tuple<int,int>>&,
 		   std::vector<valTYPE>&) const;
@@ -61,6 +71,10 @@ class cellValueSet
 
   int makeStrIndex(const std::string&);
   const std::string& getStrIndex(const int) const;
+
+  void writeGroups(std::ostream&,const std::string&,
+		   const std::vector<std::tuple<int,int>>&,
+		   const std::vector<valTYPE>&) const;
   
  public:
 
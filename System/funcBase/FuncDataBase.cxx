@@ -998,13 +998,14 @@ FuncDataBase::processXML(const std::string& FName)
   if (FName.empty() || CO.loadXML(FName))
     throw ColErr::FileError(0,FName,"XMLcollect file");
   // Parse for variables:
-  XML::XMLobject* AR=CO.findObj("variable");
+  std::vector<XML::XMLobject*> VarObj;
+  CO.findAllObj("variable",VarObj);
   XML::XMLgroup* AG;
   double V;
   Geometry::Vec3D VUnit;
   std::string VStr;
   int VInt;
-  while(AR)
+  for(XML::XMLobject* AR : VarObj)
     {
       const std::string Name=AR->getItem<std::string>("name");
       const std::string Type=AR->getDefItem<std::string>("type","double");
@@ -1056,8 +1057,6 @@ FuncDataBase::processXML(const std::string& FName)
 	    V=AR->getItem<double>();
 	  addVariable(Name,V);
 	}
-      CO.deleteObj(AR);      
-      AR=CO.findObj("variable");
     }
   return;
 }
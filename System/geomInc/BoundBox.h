@@ -0,0 +1,98 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/BoundBox.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef Geometry_BoundBox_h
+#define Geometry_BoundBox_h
+
+namespace Geometry
+{
+
+/*!
+  \class BoundBox
+  \brief Axis aligned bounding box
+  \author S. Ansell
+  \date June 2018
+  \version 1.0
+
+  Holds a closed axis aligned box [low:high] in each
+  coordinate. Unbounded directions are held as +/- infinity.
+  A default box is the whole of space. An empty box
+  has low > high.
+*/
+
+class BoundBox
+{
+ private:
+
+  double lowPt[3];            ///< Low corner
+  double highPt[3];           ///< High corner
+
+ public:
+
+  static BoundBox emptyBox();
+
+  BoundBox();
+  BoundBox(const Geometry::Vec3D&,const Geometry::Vec3D&);
+  BoundBox(const BoundBox&);
+  BoundBox& operator=(const BoundBox&);
+  ~BoundBox() {}        ///< Destructor
+
+  BoundBox& operator&=(const BoundBox&);
+  BoundBox& operator|=(const BoundBox&);
+
+  bool isEmpty() const;
+  bool isFinite() const;
+  bool isInfinite() const;
+  /// accessor to low value
+  double low(const size_t index) const { return lowPt[index % 3]; }
+  /// accessor to high value
+  double high(const size_t index) const { return highPt[index % 3]; }
+
+  Geometry::Vec3D getLow() const;
+  Geometry::Vec3D getHigh() const;
+  Geometry::Vec3D getCentre() const;
+  size_t longAxis() const;
+  double volume() const;
+
+  void setEmpty();
+  void setInfinite();
+  void addPoint(const Geometry::Vec3D&);
+  void clipLow(const size_t,const double);
+  void clipHigh(const size_t,const double);
+  void grow(const double);
+
+  /// Is point within [inclusive] the box
+  bool isValid(const Geometry::Vec3D& Pt) const
+    {
+      return (Pt.X()>=lowPt[0] && Pt.X()<=highPt[0] &&
+	      Pt.Y()>=lowPt[1] && Pt.Y()<=highPt[1] &&
+	      Pt.Z()>=lowPt[2] && Pt.Z()<=highPt[2]);
+    }
+  bool overlap(const BoundBox&) const;
+
+  void write(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&,const BoundBox&);
+
+}  // NAMESPACE Geometry
+
+#endif
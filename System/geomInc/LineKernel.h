@@ -0,0 +1,149 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/LineKernel.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef LineKernel_h
+#define LineKernel_h
+
+namespace Geometry
+{
+  class Vec3D;
+  class Surface;
+  class Plane;
+  class Cylinder;
+  class Sphere;
+  class Cone;
+}
+
+/*!
+  \namespace LineKernel
+  \brief Closed form line-surface intersections
+  \version 1.0
+  \date June 2018
+  \author S. Ansell
+
+  Each kernel returns the real line parameters [lambda] of
+  the intersections in ascending order. The direction must be
+  a unit vector [as Geometry::Line]. The roots are those of
+  Line::intersect without the complex quadratic solve, the
+  point vector and the RegMethod stack.
+*/
+
+namespace LineKernel
+{
+
+/// Surface types with a kernel
+enum kernelType
+{
+  noKernel=0,
+  axisPlane=1,
+  genPlane=2,
+  axisCylinder=3,
+  genCylinder=4,
+  sphere=5,
+  cone=6
+};
+
+size_t unitAxis(const Geometry::Vec3D&);
+int getType(const Geometry::Surface*);
+
+size_t quadRoots(const double,const double,const double,double*);
+
+size_t planeRoots(const Geometry::Plane&,const Geometry::Vec3D&,
+		  const Geometry::Vec3D&,double*);
+size_t cylinderRoots(const Geometry::Cylinder&,const Geometry::Vec3D&,
+		     const Geometry::Vec3D&,double*);
+size_t sphereRoots(const Geometry::Sphere&,const Geometry::Vec3D&,
+		   const Geometry::Vec3D&,double*);
+size_t coneRoots(const Geometry::Cone&,const Geometry::Vec3D&,
+		 const Geometry::Vec3D&,double*);
+
+/*!
+  \class surfBatch
+  \version 1.0
+  \author S. Ansell
+  \date June 2018
+  \brief Surfaces held by kernel type as structure-of-arrays
+
+  One line is intersected with all the surfaces of a type
+  in a single loop over contiguous arrays. Axis aligned
+  planes and cylinders are held per axis so the direction
+  terms are computed once. Cones are held by pointer and
+  use the scalar kernel.
+*/
+
+class surfBatch
+{
+ private:
+
+  size_t nSurf;                         ///< Number of surfaces added
+
+  std::vector<double> APos[3];          ///< Axis plane position
+  std::vector<size_t> AIndex[3];        ///< Axis plane index
+
+  std::vector<double> PNX;              ///< Plane normal [x]
+  std::vector<double> PNY;              ///< Plane normal [y]
+  std::vector<double> PNZ;              ///< Plane normal [z]
+  std::vector<double> PDist;            ///< Plane distance
+  std::vector<size_t> PIndex;           ///< Plane index
+
+  std::vector<double> CA[3];            ///< Axis cylinder centre [axis+1]
+  std::vector<double> CB[3];            ///< Axis cylinder centre [axis+2]
+  std::vector<double> CR2[3];           ///< Axis cylinder radius^2
+  std::vector<size_t> CIndex[3];        ///< Axis cylinder index
+
+  std::vector<double> GCX;              ///< Cylinder centre [x]
+  std::vector<double> GCY;              ///< Cylinder centre [y]
+  std::vector<double> GCZ;              ///< Cylinder centre [z]
+  std::vector<double> GNX;              ///< Cylinder axis [x]
+  std::vector<double> GNY;              ///< Cylinder axis [y]
+  std::vector<double> GNZ;              ///< Cylinder axis [z]
+  std::vector<double> GR2;              ///< Cylinder radius^2
+  std::vector<size_t> GIndex;           ///< Cylinder index
+
+  std::vector<double> SX;               ///< Sphere centre [x]
+  std::vector<double> SY;               ///< Sphere centre [y]
+  std::vector<double> SZ;               ///< Sphere centre [z]
+  std::vector<double> SR2;              ///< Sphere radius^2
+  std::vector<size_t> SIndex;           ///< Sphere index
+
+  std::vector<const Geometry::Cone*> ConeSurf;  ///< Cones
+  std::vector<size_t> KIndex;                   ///< Cone index
+
+ public:
+
+  surfBatch();
+  surfBatch(const surfBatch&);
+  surfBatch& operator=(const surfBatch&);
+  ~surfBatch() {}                   ///< Destructor
+
+  /// Number of surfaces added
+  size_t size() const { return nSurf; }
+
+  void clear();
+  int addSurface(const Geometry::Surface*);
+
+  size_t intersect(const Geometry::Vec3D&,const Geometry::Vec3D&,
+		   std::vector<double>&,std::vector<size_t>&) const;
+};
+
+}  // NAMESPACE LineKernel
+
+#endif
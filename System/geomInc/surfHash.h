@@ -0,0 +1,107 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/surfHash.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_surfHash_h
+#define ModelSupport_surfHash_h
+
+namespace Geometry
+{
+  class Surface;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class surfHash
+  \version 1.0
+  \author S. Ansell
+  \date June 2018
+  \brief Spatial hash of surfaces for equal/opposite surface search
+
+  Planes, cylinders, spheres, cones and tori are hashed on
+  their type and their defining values quantised to cells
+  much larger than Geometry::zeroTol. A search probes every
+  cell within tolerance of the search values so no surface
+  that passes the type operator== is missed. Other surface
+  types are not hashed and must be searched linearly.
+
+  Surfaces are hashed at the first search after they are
+  added (so they can be set after creation). Surfaces that
+  are moved after that need rehash().
+*/
+
+class surfHash
+{
+ private:
+
+  /// Values [and search tolerances] of a surface
+  struct hashValues
+  {
+    int type;                  ///< Hash type [0 : not hashed]
+    std::vector<double> Value; ///< Values to quantise
+    std::vector<double> Tol;   ///< Search tolerance of each value
+  };
+
+  static const double cellSize;     ///< Size of quantisation cell
+
+  /// Buckets of surfaces
+  typedef std::unordered_map<size_t,
+    std::vector<Geometry::Surface*>> BTYPE;
+
+  BTYPE Buckets;                                 ///< Hash buckets
+  std::unordered_map<const Geometry::Surface*,size_t> HKey; ///< Key used
+  std::vector<Geometry::Surface*> Pending;       ///< Added not hashed
+
+  static hashValues getValues(const Geometry::Surface*,const int);
+  static long int cellIndex(const double);
+  static size_t cellKey(const int,const std::vector<long int>&);
+
+  void flush();
+  void insertHash(Geometry::Surface*);
+  void probe(const hashValues&,std::vector<Geometry::Surface*>&);
+
+ public:
+
+  surfHash();
+  surfHash(const surfHash&);
+  surfHash& operator=(const surfHash&);
+  ~surfHash() {}                       ///< Destructor
+
+  static int isHashed(const Geometry::Surface*);
+
+  void clear();
+  void addSurface(Geometry::Surface*);
+  void removeSurface(const Geometry::Surface*);
+  void rehash();
+
+  void equalCandidates(const Geometry::Surface*,
+		       std::vector<Geometry::Surface*>&);
+  void oppositeCandidates(const Geometry::Surface*,
+			  std::vector<Geometry::Surface*>&);
+
+  /// Number of hashed surfaces
+  size_t size() const { return HKey.size()+Pending.size(); }
+};
+
+}
+
+#endif
@@ -30,6 +30,8 @@ namespace Geometry
 namespace ModelSupport
 {
 
+class surfHash;
+
 /*!
   \class surfIndex 
   \version 1.0
@@ -49,6 +51,7 @@ class surfIndex
   int uniqNum;                      ///< uniq number
   STYPE SMap;                       ///< Index of kept surfaces
   std::map<int,int> holdMap;        ///< Hold/Write map :: surfaceN : write/no-write flag
+  surfHash* HashPtr;                ///< Hash of SMap for equal surfaces
   
   surfIndex();
 
@@ -84,6 +87,7 @@ class surfIndex
   int checkSurface(const int,const Geometry::Vec3D&) const; 
   void deleteSurface(const int);
   void renumber(const int,const int);
+  void renumber(const std::map<int,int>&);
 
   Geometry::Surface* getSurf(const int) const; 
   
@@ -95,6 +99,8 @@ class surfIndex
 
   /// access to map
   const STYPE& surMap() const { return SMap; }
+  const STYPE& equalMap(const Geometry::Surface*,STYPE&) const;
+  void rehash();
   void setKeep(const int,const int);
 
   bool mapValid() const;
@@ -0,0 +1,351 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/BoundBox.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+
+namespace Geometry
+{
+
+std::ostream&
+operator<<(std::ostream& OX,const BoundBox& A)
+  /*!
+    Standard output stream
+    \param OX :: Output stream
+    \param A :: BoundBox to write
+    \return Current state of stream
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+BoundBox
+BoundBox::emptyBox()
+  /*!
+    Construct an empty box [for accumulating points/boxes]
+    \return empty box
+  */
+{
+  BoundBox Out;
+  Out.setEmpty();
+  return Out;
+}
+
+BoundBox::BoundBox()
+  /*!
+    Constructor : box of all space
+  */
+{
+  setInfinite();
+}
+
+BoundBox::BoundBox(const Geometry::Vec3D& APt,
+		   const Geometry::Vec3D& BPt)
+  /*!
+    Constructor from two corner points [any order]
+    \param APt :: Corner point
+    \param BPt :: Opposite corner point
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(APt[i],BPt[i]);
+      highPt[i]=std::max(APt[i],BPt[i]);
+    }
+}
+
+BoundBox::BoundBox(const BoundBox& A)
+  /*!
+    Copy constructor
+    \param A :: BoundBox to copy
+  */
+{
+  std::copy(A.lowPt,A.lowPt+3,lowPt);
+  std::copy(A.highPt,A.highPt+3,highPt);
+}
+
+BoundBox&
+BoundBox::operator=(const BoundBox& A)
+  /*!
+    Assignment operator
+    \param A :: BoundBox to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      std::copy(A.lowPt,A.lowPt+3,lowPt);
+      std::copy(A.highPt,A.highPt+3,highPt);
+    }
+  return *this;
+}
+
+BoundBox&
+BoundBox::operator&=(const BoundBox& A)
+  /*!
+    Intersection of two boxes
+    \param A :: Box to intersect with
+    \return *this
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::max(lowPt[i],A.lowPt[i]);
+      highPt[i]=std::min(highPt[i],A.highPt[i]);
+    }
+  return *this;
+}
+
+BoundBox&
+BoundBox::operator|=(const BoundBox& A)
+  /*!
+    Union [smallest enclosing box] of two boxes
+    \param A :: Box to add
+    \return *this
+  */
+{
+  if (A.isEmpty()) return *this;
+  if (isEmpty())
+    return (*this=A);
+
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(lowPt[i],A.lowPt[i]);
+      highPt[i]=std::max(highPt[i],A.highPt[i]);
+    }
+  return *this;
+}
+
+void
+BoundBox::setEmpty()
+  /*!
+    Set the box to contain nothing
+  */
+{
+  std::fill(lowPt,lowPt+3,std::numeric_limits<double>::infinity());
+  std::fill(highPt,highPt+3,-std::numeric_limits<double>::infinity());
+  return;
+}
+
+void
+BoundBox::setInfinite()
+  /*!
+    Set the box to contain all space
+  */
+{
+  std::fill(lowPt,lowPt+3,-std::numeric_limits<double>::infinity());
+  std::fill(highPt,highPt+3,std::numeric_limits<double>::infinity());
+  return;
+}
+
+bool
+BoundBox::isEmpty() const
+  /*!
+    Determine if the box contains no points
+    \return true if any low > high
+  */
+{
+  return (lowPt[0]>highPt[0] || lowPt[1]>highPt[1] ||
+	  lowPt[2]>highPt[2]);
+}
+
+bool
+BoundBox::isFinite() const
+  /*!
+    Determine if the box is bounded in all directions
+    \return true if non-empty and all limits finite
+  */
+{
+  if (isEmpty()) return 0;
+  for(size_t i=0;i<3;i++)
+    if (std::isinf(lowPt[i]) || std::isinf(highPt[i]))
+      return 0;
+  return 1;
+}
+
+bool
+BoundBox::isInfinite() const
+  /*!
+    Determine if the box is unbounded in every direction
+    \return true if all limits are infinite
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (!std::isinf(lowPt[i]) || !std::isinf(highPt[i]))
+      return 0;
+  return 1;
+}
+
+Geometry::Vec3D
+BoundBox::getLow() const
+  /*!
+    Accessor to the low corner
+    \return low corner
+  */
+{
+  return Geometry::Vec3D(lowPt[0],lowPt[1],lowPt[2]);
+}
+
+Geometry::Vec3D
+BoundBox::getHigh() const
+  /*!
+    Accessor to the high corner
+    \return high corner
+  */
+{
+  return Geometry::Vec3D(highPt[0],highPt[1],highPt[2]);
+}
+
+Geometry::Vec3D
+BoundBox::getCentre() const
+  /*!
+    Calculate the centre of the box [only sensible if finite]
+    \return centre point
+  */
+{
+  return Geometry::Vec3D((lowPt[0]+highPt[0])/2.0,
+			 (lowPt[1]+highPt[1])/2.0,
+			 (lowPt[2]+highPt[2])/2.0);
+}
+
+size_t
+BoundBox::longAxis() const
+  /*!
+    Determine the axis with the largest extent
+    \return index [0-2] of longest axis
+  */
+{
+  size_t index(0);
+  double maxLen(highPt[0]-lowPt[0]);
+  for(size_t i=1;i<3;i++)
+    if (highPt[i]-lowPt[i]>maxLen)
+      {
+	maxLen=highPt[i]-lowPt[i];
+	index=i;
+      }
+  return index;
+}
+
+double
+BoundBox::volume() const
+  /*!
+    Calculate the volume of the box
+    \return volume [0 if empty]
+  */
+{
+  if (isEmpty()) return 0.0;
+  return (highPt[0]-lowPt[0])*(highPt[1]-lowPt[1])*(highPt[2]-lowPt[2]);
+}
+
+void
+BoundBox::addPoint(const Geometry::Vec3D& Pt)
+  /*!
+    Extend the box to include a point
+    \param Pt :: Point to add
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(lowPt[i],Pt[i]);
+      highPt[i]=std::max(highPt[i],Pt[i]);
+    }
+  return;
+}
+
+void
+BoundBox::clipLow(const size_t index,const double V)
+  /*!
+    Restrict the box to values >= V in the index direction
+    \param index :: axis [0-2]
+    \param V :: lower limit
+  */
+{
+  lowPt[index % 3]=std::max(lowPt[index % 3],V);
+  return;
+}
+
+void
+BoundBox::clipHigh(const size_t index,const double V)
+  /*!
+    Restrict the box to values <= V in the index direction
+    \param index :: axis [0-2]
+    \param V :: upper limit
+  */
+{
+  highPt[index % 3]=std::min(highPt[index % 3],V);
+  return;
+}
+
+void
+BoundBox::grow(const double D)
+  /*!
+    Expand a non-empty box by D in all directions
+    \param D :: Distance to expand by
+  */
+{
+  if (!isEmpty())
+    for(size_t i=0;i<3;i++)
+      {
+	lowPt[i]-=D;
+	highPt[i]+=D;
+      }
+  return;
+}
+
+bool
+BoundBox::overlap(const BoundBox& A) const
+  /*!
+    Determine if two boxes overlap [closed boxes]
+    \param A :: Box to test
+    \return true if any volume/face is shared
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (lowPt[i]>A.highPt[i] || A.lowPt[i]>highPt[i])
+      return 0;
+  return 1;
+}
+
+void
+BoundBox::write(std::ostream& OX) const
+  /*!
+    Write out the box to a stream
+    \param OX :: Output stream
+  */
+{
+  OX<<"["<<getLow()<<" : "<<getHigh()<<"]";
+  return;
+}
+
+}  // NAMESPACE Geometry
@@ -0,0 +1,523 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/LineKernel.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Cone.h"
+#include "Cylinder.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "LineKernel.h"
+
+namespace LineKernel
+{
+
+size_t
+unitAxis(const Geometry::Vec3D& N)
+  /*!
+    Determine if a vector is exactly along an axis.
+    No tolerance is used so the axis kernels give
+    the same result as the general dot products.
+    \param N :: Vector
+    \return axis+1 [0 if not axis aligned]
+  */
+{
+  if (N.Y()==0.0 && N.Z()==0.0 && N.X()!=0.0) return 1;
+  if (N.X()==0.0 && N.Z()==0.0 && N.Y()!=0.0) return 2;
+  if (N.X()==0.0 && N.Y()==0.0 && N.Z()!=0.0) return 3;
+  return 0;
+}
+
+int
+getType(const Geometry::Surface* SPtr)
+  /*!
+    Get the kernel type of a surface
+    \param SPtr :: Surface
+    \return kernelType [noKernel if not handled]
+  */
+{
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    return (unitAxis(PPtr->getNormal())) ? axisPlane : genPlane;
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  if (CPtr)
+    return (unitAxis(CPtr->getNormal())) ? axisCylinder : genCylinder;
+
+  if (dynamic_cast<const Geometry::Sphere*>(SPtr))
+    return sphere;
+  if (dynamic_cast<const Geometry::Cone*>(SPtr))
+    return cone;
+  return noKernel;
+}
+
+size_t
+quadRoots(const double a,const double b,const double c,double* L)
+  /*!
+    Real roots of \f$ a x^2 + b x + c \f$ in ascending order.
+    Follows solveQuadratic / Line::lambdaPair : a double
+    root is returned once and complex roots are dropped.
+    \param a :: x^2 coeff
+    \param b :: x coeff
+    \param c :: const coeff
+    \param L :: Output roots [size 2]
+    \return number of roots
+  */
+{
+  if (a==0.0)
+    {
+      if (b==0.0) return 0;
+      L[0]= -c/b;
+      return 1;
+    }
+  const double cf=b*b-4.0*a*c;
+  if (cf<0.0) return 0;
+
+  const double q=(b>=0.0) ? -0.5*(b+std::sqrt(cf)) : -0.5*(b-std::sqrt(cf));
+  L[0]=q/a;
+  if (cf==0.0) return 1;
+  L[1]=c/q;
+  if (L[0]>L[1])
+    std::swap(L[0],L[1]);
+  return 2;
+}
+
+size_t
+planeRoots(const Geometry::Plane& Pln,const Geometry::Vec3D& O,
+	   const Geometry::Vec3D& D,double* L)
+  /*!
+    Line-plane intersection
+    \param Pln :: Plane
+    \param O :: Line origin
+    \param D :: Line direction [unit]
+    \param L :: Output lambda [size 1]
+    \return number of intersections
+  */
+{
+  const Geometry::Vec3D& N=Pln.getNormal();
+  const size_t ax=unitAxis(N);
+  double OdotN,DdotN;
+  if (ax)
+    {
+      OdotN=O[ax-1]*N[ax-1];
+      DdotN=D[ax-1]*N[ax-1];
+    }
+  else
+    {
+      OdotN=O.dotProd(N);
+      DdotN=D.dotProd(N);
+    }
+  if (std::abs(DdotN)<Geometry::parallelTol)
+    return 0;
+  L[0]=(Pln.getDistance()-OdotN)/DdotN;
+  return 1;
+}
+
+size_t
+cylinderRoots(const Geometry::Cylinder& Cyl,const Geometry::Vec3D& O,
+	      const Geometry::Vec3D& D,double* L)
+  /*!
+    Line-cylinder intersection. An axis cylinder only uses
+    the two off-axis components.
+    \param Cyl :: Cylinder
+    \param O :: Line origin
+    \param D :: Line direction [unit]
+    \param L :: Output lambda [size 2]
+    \return number of intersections
+  */
+{
+  const Geometry::Vec3D Ax=O-Cyl.getCentre();
+  const Geometry::Vec3D& N=Cyl.getNormal();
+  const double R=Cyl.getRadius();
+  const size_t ax=unitAxis(N);
+  if (ax)
+    {
+      const size_t j(ax % 3);
+      const size_t k((ax+1) % 3);
+      return quadRoots(D[j]*D[j]+D[k]*D[k],
+		       2.0*(Ax[j]*D[j]+Ax[k]*D[k]),
+		       Ax[j]*Ax[j]+Ax[k]*Ax[k]-R*R,L);
+    }
+
+  const double vDn=N.dotProd(D);
+  const double vDA=N.dotProd(Ax);
+  return quadRoots(1.0-vDn*vDn,2.0*(Ax.dotProd(D)-vDA*vDn),
+		   Ax.dotProd(Ax)-(R*R+vDA*vDA),L);
+}
+
+size_t
+sphereRoots(const Geometry::Sphere& Sph,const Geometry::Vec3D& O,
+	    const Geometry::Vec3D& D,double* L)
+  /*!
+    Line-sphere intersection
+    \param Sph :: Sphere
+    \param O :: Line origin
+    \param D :: Line direction [unit]
+    \param L :: Output lambda [size 2]
+    \return number of intersections
+  */
+{
+  const Geometry::Vec3D Ax=O-Sph.getCentre();
+  const double R=Sph.getRadius();
+  return quadRoots(1.0,2.0*Ax.dotProd(D),Ax.dotProd(Ax)-R*R,L);
+}
+
+size_t
+coneRoots(const Geometry::Cone& CObj,const Geometry::Vec3D& O,
+	  const Geometry::Vec3D& D,double* L)
+  /*!
+    Line-cone intersection. Roots on the cut side
+    of a single sided cone are removed.
+    \param CObj :: Cone
+    \param O :: Line origin
+    \param D :: Line direction [unit]
+    \param L :: Output lambda [size 2]
+    \return number of intersections
+  */
+{
+  const Geometry::Vec3D V=CObj.getCentre();
+  const Geometry::Vec3D A=CObj.getNormal();
+
+  const Geometry::Vec3D b=O-V;
+  const double AdotN=A.dotProd(D);
+  const double AdotB=A.dotProd(b);
+  const double gamma2=CObj.getCosAngle()*CObj.getCosAngle();
+
+  const size_t nP=quadRoots(AdotN*AdotN-gamma2,
+			    2.0*(AdotB*AdotN-gamma2*b.dotProd(D)),
+			    AdotB*AdotB-gamma2*b.dotProd(b),L);
+  const int cF=CObj.getCutFlag();
+  if (!cF || !nP) return nP;
+
+  size_t nOut(0);
+  for(size_t i=0;i<nP;i++)
+    if (cF*(AdotB+L[i]*AdotN)>0.0)
+      L[nOut++]=L[i];
+  return nOut;
+}
+
+//  ---------------------------------------------------
+//                   surfBatch
+//  ---------------------------------------------------
+
+surfBatch::surfBatch() :
+  nSurf(0)
+  /*!
+    Constructor
+  */
+{}
+
+surfBatch::surfBatch(const surfBatch& A) :
+  nSurf(A.nSurf),
+  PNX(A.PNX),PNY(A.PNY),PNZ(A.PNZ),PDist(A.PDist),PIndex(A.PIndex),
+  GCX(A.GCX),GCY(A.GCY),GCZ(A.GCZ),GNX(A.GNX),GNY(A.GNY),GNZ(A.GNZ),
+  GR2(A.GR2),GIndex(A.GIndex),
+  SX(A.SX),SY(A.SY),SZ(A.SZ),SR2(A.SR2),SIndex(A.SIndex),
+  ConeSurf(A.ConeSurf),KIndex(A.KIndex)
+  /*!
+    Copy constructor
+    \param A :: surfBatch to copy
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      APos[i]=A.APos[i];
+      AIndex[i]=A.AIndex[i];
+      CA[i]=A.CA[i];
+      CB[i]=A.CB[i];
+      CR2[i]=A.CR2[i];
+      CIndex[i]=A.CIndex[i];
+    }
+}
+
+surfBatch&
+surfBatch::operator=(const surfBatch& A)
+  /*!
+    Assignment operator
+    \param A :: surfBatch to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      nSurf=A.nSurf;
+      for(size_t i=0;i<3;i++)
+	{
+	  APos[i]=A.APos[i];
+	  AIndex[i]=A.AIndex[i];
+	  CA[i]=A.CA[i];
+	  CB[i]=A.CB[i];
+	  CR2[i]=A.CR2[i];
+	  CIndex[i]=A.CIndex[i];
+	}
+      PNX=A.PNX;
+      PNY=A.PNY;
+      PNZ=A.PNZ;
+      PDist=A.PDist;
+      PIndex=A.PIndex;
+      GCX=A.GCX;
+      GCY=A.GCY;
+      GCZ=A.GCZ;
+      GNX=A.GNX;
+      GNY=A.GNY;
+      GNZ=A.GNZ;
+      GR2=A.GR2;
+      GIndex=A.GIndex;
+      SX=A.SX;
+      SY=A.SY;
+      SZ=A.SZ;
+      SR2=A.SR2;
+      SIndex=A.SIndex;
+      ConeSurf=A.ConeSurf;
+      KIndex=A.KIndex;
+    }
+  return *this;
+}
+
+void
+surfBatch::clear()
+  /*!
+    Remove all the surfaces
+  */
+{
+  *this=surfBatch();
+  return;
+}
+
+int
+surfBatch::addSurface(const Geometry::Surface* SPtr)
+  /*!
+    Add a surface to the array of its type. Surfaces are
+    indexed in the order they are accepted.
+    \param SPtr :: Surface
+    \return 1 if held / 0 if the surface has no kernel
+  */
+{
+  ELog::RegMethod RegA("surfBatch","addSurface");
+
+  const int type=getType(SPtr);
+  if (type==axisPlane || type==genPlane)
+    {
+      const Geometry::Plane* PPtr=
+	dynamic_cast<const Geometry::Plane*>(SPtr);
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      const size_t ax=unitAxis(N);
+      if (ax)
+	{
+	  // N[ax-1] is +/-1 for a unit normal
+	  APos[ax-1].push_back(PPtr->getDistance()/N[ax-1]);
+	  AIndex[ax-1].push_back(nSurf);
+	}
+      else
+	{
+	  PNX.push_back(N.X());
+	  PNY.push_back(N.Y());
+	  PNZ.push_back(N.Z());
+	  PDist.push_back(PPtr->getDistance());
+	  PIndex.push_back(nSurf);
+	}
+    }
+  else if (type==axisCylinder || type==genCylinder)
+    {
+      const Geometry::Cylinder* CPtr=
+	dynamic_cast<const Geometry::Cylinder*>(SPtr);
+      const Geometry::Vec3D& C=CPtr->getCentre();
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      const double R=CPtr->getRadius();
+      const size_t ax=unitAxis(N);
+      if (ax)
+	{
+	  CA[ax-1].push_back(C[ax % 3]);
+	  CB[ax-1].push_back(C[(ax+1) % 3]);
+	  CR2[ax-1].push_back(R*R);
+	  CIndex[ax-1].push_back(nSurf);
+	}
+      else
+	{
+	  GCX.push_back(C.X());
+	  GCY.push_back(C.Y());
+	  GCZ.push_back(C.Z());
+	  GNX.push_back(N.X());
+	  GNY.push_back(N.Y());
+	  GNZ.push_back(N.Z());
+	  GR2.push_back(R*R);
+	  GIndex.push_back(nSurf);
+	}
+    }
+  else if (type==sphere)
+    {
+      const Geometry::Sphere* SpherePtr=
+	dynamic_cast<const Geometry::Sphere*>(SPtr);
+      const Geometry::Vec3D& C=SpherePtr->getCentre();
+      SX.push_back(C.X());
+      SY.push_back(C.Y());
+      SZ.push_back(C.Z());
+      SR2.push_back(SpherePtr->getRadius()*SpherePtr->getRadius());
+      SIndex.push_back(nSurf);
+    }
+  else if (type==cone)
+    {
+      ConeSurf.push_back(dynamic_cast<const Geometry::Cone*>(SPtr));
+      KIndex.push_back(nSurf);
+    }
+  else
+    return 0;
+
+  nSurf++;
+  return 1;
+}
+
+size_t
+surfBatch::intersect(const Geometry::Vec3D& O,const Geometry::Vec3D& D,
+		     std::vector<double>& LOut,
+		     std::vector<size_t>& IOut) const
+  /*!
+    Intersect a line with all the surfaces. Roots
+    are grouped by type [not sorted].
+    \param O :: Line origin
+    \param D :: Line direction [unit]
+    \param LOut :: Line parameters [added to]
+    \param IOut :: Surface index of each root [added to]
+    \return number of intersections added
+  */
+{
+  const size_t outSize(LOut.size());
+  const double OV[3]={O.X(),O.Y(),O.Z()};
+  const double DV[3]={D.X(),D.Y(),D.Z()};
+  double L[2];
+
+  for(size_t ax=0;ax<3;ax++)
+    {
+      // axis planes : parallel test once for the group
+      // [divide, not 1/D, to match planeRoots exactly]
+      const std::vector<double>& AP(APos[ax]);
+      if (!AP.empty() && std::abs(DV[ax])>=Geometry::parallelTol)
+	{
+	  for(size_t i=0;i<AP.size();i++)
+	    {
+	      LOut.push_back((AP[i]-OV[ax])/DV[ax]);
+	      IOut.push_back(AIndex[ax][i]);
+	    }
+	}
+
+      // axis cylinders : direction terms fixed for the group
+      const std::vector<double>& CR(CR2[ax]);
+      if (!CR.empty())
+	{
+	  const size_t j((ax+1) % 3);
+	  const size_t k((ax+2) % 3);
+	  const double a(DV[j]*DV[j]+DV[k]*DV[k]);
+	  for(size_t i=0;i<CR.size();i++)
+	    {
+	      const double Aj(OV[j]-CA[ax][i]);
+	      const double Ak(OV[k]-CB[ax][i]);
+	      const size_t nR=quadRoots(a,2.0*(Aj*DV[j]+Ak*DV[k]),
+					Aj*Aj+Ak*Ak-CR[i],L);
+	      for(size_t r=0;r<nR;r++)
+		{
+		  LOut.push_back(L[r]);
+		  IOut.push_back(CIndex[ax][i]);
+		}
+	    }
+	}
+    }
+
+  for(size_t i=0;i<PDist.size();i++)
+    {
+      const double DdotN=DV[0]*PNX[i]+DV[1]*PNY[i]+DV[2]*PNZ[i];
+      if (std::abs(DdotN)>=Geometry::parallelTol)
+	{
+	  const double OdotN=OV[0]*PNX[i]+OV[1]*PNY[i]+OV[2]*PNZ[i];
+	  LOut.push_back((PDist[i]-OdotN)/DdotN);
+	  IOut.push_back(PIndex[i]);
+	}
+    }
+
+  for(size_t i=0;i<GR2.size();i++)
+    {
+      const double Ax(OV[0]-GCX[i]);
+      const double Ay(OV[1]-GCY[i]);
+      const double Az(OV[2]-GCZ[i]);
+      const double vDn=DV[0]*GNX[i]+DV[1]*GNY[i]+DV[2]*GNZ[i];
+      const double vDA=Ax*GNX[i]+Ay*GNY[i]+Az*GNZ[i];
+      const size_t nR=
+	quadRoots(1.0-vDn*vDn,
+		  2.0*(Ax*DV[0]+Ay*DV[1]+Az*DV[2]-vDA*vDn),
+		  Ax*Ax+Ay*Ay+Az*Az-(GR2[i]+vDA*vDA),L);
+      for(size_t r=0;r<nR;r++)
+	{
+	  LOut.push_back(L[r]);
+	  IOut.push_back(GIndex[i]);
+	}
+    }
+
+  for(size_t i=0;i<SR2.size();i++)
+    {
+      const double Ax(OV[0]-SX[i]);
+      const double Ay(OV[1]-SY[i]);
+      const double Az(OV[2]-SZ[i]);
+      const size_t nR=
+	quadRoots(1.0,2.0*(Ax*DV[0]+Ay*DV[1]+Az*DV[2]),
+		  Ax*Ax+Ay*Ay+Az*Az-SR2[i],L);
+      for(size_t r=0;r<nR;r++)
+	{
+	  LOut.push_back(L[r]);
+	  IOut.push_back(SIndex[i]);
+	}
+    }
+
+  for(size_t i=0;i<ConeSurf.size();i++)
+    {
+      const size_t nR=coneRoots(*ConeSurf[i],O,D,L);
+      for(size_t r=0;r<nR;r++)
+	{
+	  LOut.push_back(L[r]);
+	  IOut.push_back(KIndex[i]);
+	}
+    }
+
+  return LOut.size()-outSize;
+}
+
+}  // NAMESPACE LineKernel
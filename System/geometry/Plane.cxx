@@ -658,9 +658,12 @@ Plane::writeFLUKA(std::ostream& OX) const
   const int ptype=planeType();
   if (!ptype)
     {
-      cx<<"PLA s"<<getName()<<" "
-	<<MW.Num(NormV)<<" "
-	<<MW.Num(NormV*Dist);
+      char Out[6*masterWrite::bufSize];
+      size_t N=MW.writeNum(Out,sizeof(Out),NormV,' ');
+      Out[N++]=' ';
+      N+=MW.writeNum(Out+N,sizeof(Out)-N,NormV*Dist,' ');
+      cx<<"PLA s"<<getName()<<" ";
+      cx.write(Out,static_cast<std::streamsize>(N));
     }
   else
     {
@@ -716,7 +719,14 @@ Plane::write(std::ostream& OX) const
   Surface::writeHeader(cx);
   const int ptype=planeType();
   if (!ptype)
-      cx<<"p "<<MW.Num(NormV)<<" "<<MW.Num(Dist);
+    {
+      char Out[4*masterWrite::bufSize];
+      size_t N=MW.writeNum(Out,sizeof(Out),NormV,' ');
+      Out[N++]=' ';
+      N+=MW.writeNum(Out+N,sizeof(Out)-N,Dist);
+      cx<<"p ";
+      cx.write(Out,static_cast<std::streamsize>(N));
+    }
   else if(NormV[ptype-1]<0)
     cx<<"p"<<"xyz"[ptype-1]<<" "<<MW.Num(-Dist);
   else 
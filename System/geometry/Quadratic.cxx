@@ -598,8 +598,14 @@ Quadratic::writeFLUKA(std::ostream& OX) const
   cx.precision(Geometry::Nprecision);
   cx<<"QUA s"<<getName();
   // write all 10 items in order: as xy xz yz coeffients
+  char Out[10*masterWrite::bufSize];
+  size_t N(0);
   for(const double& val : BaseEqn)
-    cx<<" "<<MW.Num(val);
+    {
+      Out[N++]=' ';
+      N+=MW.writeNum(Out+N,sizeof(Out)-N,val);
+    }
+  cx.write(Out,static_cast<std::streamsize>(N));
   StrFunc::writeMCNPX(cx.str(),OX);
   return;
 }
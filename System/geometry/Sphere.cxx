@@ -344,10 +344,14 @@ Sphere::writeFLUKA(std::ostream& OX) const
   ELog::RegMethod RegA("Sphere","writeFLUKA");
   
   masterWrite& MW=masterWrite::Instance();
+  char Out[4*masterWrite::bufSize];
+  size_t N=MW.writeNum(Out,sizeof(Out),Centre,' ');
+  Out[N++]=' ';
+  N+=MW.writeNum(Out+N,sizeof(Out)-N,Radius);
+
   std::ostringstream cx;
-  cx<<"SPH s"<<getName()<<" "
-    <<MW.Num(Centre)<<" "
-    <<MW.Num(Radius);
+  cx<<"SPH s"<<getName()<<" ";
+  cx.write(Out,static_cast<std::streamsize>(N));
   StrFunc::writeMCNPX(cx.str(),OX);
   return;
 }
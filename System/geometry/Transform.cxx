@@ -280,13 +280,20 @@ Transform::write(std::ostream& OX) const
   std::ostringstream cx;
   masterWrite& MW=masterWrite::Instance();
 
-  cx<<"tr"<<Nmb<<" "<<MW.Num(Shift);
+  char Out[9*masterWrite::bufSize];
+  size_t N=MW.writeNum(Out,sizeof(Out),Shift,' ');
+  cx<<"tr"<<Nmb<<" ";
+  cx.write(Out,static_cast<std::streamsize>(N));
   StrFunc::writeMCNPX(cx.str(),OX);
-  cx.str("");
+
+  N=0;
   for(size_t i=0;i<3;i++)
     for(size_t j=0;j<3;j++)
-      cx<<MW.Num(Rot.item(i,j))<<" ";
-  StrFunc::writeMCNPXcont(cx.str(),OX);
+      {
+	N+=MW.writeNum(Out+N,sizeof(Out)-N,Rot.item(i,j));
+	Out[N++]=' ';
+      }
+  StrFunc::writeMCNPXcont(std::string(Out,N),OX);
   return;
 }
 
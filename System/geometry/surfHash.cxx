@@ -0,0 +1,381 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/surfHash.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <functional>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Triple.h"
+#include "Quaternion.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Cone.h"
+#include "Cylinder.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Torus.h"
+#include "surfHash.h"
+
+namespace ModelSupport
+{
+
+const double surfHash::cellSize(1e-6);
+
+surfHash::surfHash()
+  /*!
+    Constructor
+  */
+{}
+
+surfHash::surfHash(const surfHash& A) :
+  Buckets(A.Buckets),HKey(A.HKey),Pending(A.Pending)
+  /*!
+    Copy constructor
+    \param A :: surfHash to copy
+  */
+{}
+
+surfHash&
+surfHash::operator=(const surfHash& A)
+  /*!
+    Assignment operator
+    \param A :: surfHash to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      Buckets=A.Buckets;
+      HKey=A.HKey;
+      Pending=A.Pending;
+    }
+  return *this;
+}
+
+surfHash::hashValues
+surfHash::getValues(const Geometry::Surface* SPtr,const int sign)
+  /*!
+    Get the values to hash for a surface. The tolerances
+    are the maximum change in each value between two
+    surfaces that are equal by the type operator==.
+    \param SPtr :: Surface
+    \param sign :: 1 for equal surface / -1 for opposite plane
+    \return values [type 0 if not hashed]
+  */
+{
+  const double tol(Geometry::zeroTol);
+  hashValues Out;
+  Out.type=0;
+
+  const Geometry::Plane* PPtr=dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      // Opposite planes : Plane::isEqual allows the distance
+      // to be up to 3 tol from -D if both are near zero
+      const Geometry::Vec3D N=PPtr->getNormal()*sign;
+      Out.type=1;
+      Out.Value={PPtr->getDistance()*sign,N[0],N[1],N[2]};
+      Out.Tol={(sign>0) ? tol : 3.0*tol,tol,tol,tol};
+      return Out;
+    }
+  if (sign<0) return Out;
+
+  const Geometry::Cylinder* CPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  if (CPtr)
+    {
+      // centre can move along the axis and the axis can flip
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      Out.type=2;
+      Out.Value={CPtr->getRadius(),std::abs(N[0]),
+		 std::abs(N[1]),std::abs(N[2])};
+      Out.Tol={tol,tol,tol,tol};
+      return Out;
+    }
+
+  const Geometry::Sphere* SpherePtr=
+    dynamic_cast<const Geometry::Sphere*>(SPtr);
+  if (SpherePtr)
+    {
+      const Geometry::Vec3D& C=SpherePtr->getCentre();
+      Out.type=3;
+      Out.Value={SpherePtr->getRadius(),C[0],C[1],C[2]};
+      Out.Tol={tol,tol,tol,tol};
+      return Out;
+    }
+
+  const Geometry::Cone* ConePtr=
+    dynamic_cast<const Geometry::Cone*>(SPtr);
+  if (ConePtr)
+    {
+      const Geometry::Vec3D C=ConePtr->getCentre();
+      const Geometry::Vec3D N=ConePtr->getNormal();
+      Out.type=4;
+      Out.Value={ConePtr->getCosAngle(),C[0],C[1],C[2],N[0],N[1],N[2]};
+      Out.Tol.resize(Out.Value.size(),tol);
+      return Out;
+    }
+
+  const Geometry::Torus* TorusPtr=
+    dynamic_cast<const Geometry::Torus*>(SPtr);
+  if (TorusPtr)
+    {
+      const Geometry::Vec3D C=TorusPtr->getCentre();
+      const Geometry::Vec3D N=TorusPtr->getNormal();
+      Out.type=5;
+      Out.Value={TorusPtr->getIRad(),TorusPtr->getORad(),
+		 C[0],C[1],C[2],N[0],N[1],N[2]};
+      Out.Tol.resize(Out.Value.size(),tol);
+      return Out;
+    }
+  return Out;
+}
+
+int
+surfHash::isHashed(const Geometry::Surface* SPtr)
+  /*!
+    Determine if a surface type is held in the hash
+    \param SPtr :: Surface
+    \return 1 if hashed
+  */
+{
+  return (SPtr && getValues(SPtr,1).type) ? 1 : 0;
+}
+
+size_t
+surfHash::cellKey(const int type,const std::vector<long int>& Cell)
+  /*!
+    Combine the cell index into a bucket key
+    \param type :: Surface hash type
+    \param Cell :: Quantised values
+    \return key
+  */
+{
+  size_t key=std::hash<int>()(type);
+  for(const long int CI : Cell)
+    key^=std::hash<long int>()(CI)+0x9e3779b97f4a7c15UL+(key<<6)+(key>>2);
+  return key;
+}
+
+long int
+surfHash::cellIndex(const double V)
+  /*!
+    Quantise a value : cells are centred on multiples
+    of cellSize so exact values (0,1 etc) are not on an edge
+    \param V :: Value
+    \return cell index
+  */
+{
+  return (std::isfinite(V)) ?
+    static_cast<long int>(std::floor(V/cellSize+0.5)) : 0;
+}
+
+void
+surfHash::insertHash(Geometry::Surface* SPtr)
+  /*!
+    Place a surface in its bucket
+    \param SPtr :: Surface [must be hashed type]
+  */
+{
+  const hashValues HV=getValues(SPtr,1);
+  std::vector<long int> Cell;
+  for(const double V : HV.Value)
+    Cell.push_back(cellIndex(V));
+
+  const size_t key=cellKey(HV.type,Cell);
+  Buckets[key].push_back(SPtr);
+  HKey[SPtr]=key;
+  return;
+}
+
+void
+surfHash::flush()
+  /*!
+    Hash the surfaces added since the last search
+  */
+{
+  for(Geometry::Surface* SPtr : Pending)
+    insertHash(SPtr);
+  Pending.clear();
+  return;
+}
+
+void
+surfHash::probe(const hashValues& HV,std::vector<Geometry::Surface*>& Out)
+  /*!
+    Find all the surfaces in the buckets that are within
+    tolerance of the values. The tolerance is doubled to
+    cover rounding at the cell edge.
+    \param HV :: Values to search for
+    \param Out :: Surfaces found [may include non-equal surfaces]
+  */
+{
+  const size_t NV(HV.Value.size());
+  std::vector<long int> Low(NV);
+  std::vector<long int> High(NV);
+  for(size_t i=0;i<NV;i++)
+    {
+      Low[i]=cellIndex(HV.Value[i]-2.0*HV.Tol[i]);
+      High[i]=cellIndex(HV.Value[i]+2.0*HV.Tol[i]);
+    }
+
+  const size_t outSize(Out.size());
+  std::vector<long int> Cell(Low);
+  size_t index;
+  do
+    {
+      BTYPE::const_iterator mc=Buckets.find(cellKey(HV.type,Cell));
+      if (mc!=Buckets.end())
+	Out.insert(Out.end(),mc->second.begin(),mc->second.end());
+
+      // next neighbour cell
+      for(index=0;index<NV && Cell[index]==High[index];index++)
+	Cell[index]=Low[index];
+      if (index<NV)
+	Cell[index]++;
+    } while(index<NV);
+
+  // keys of different cells can share a bucket
+  std::sort(Out.begin()+static_cast<long int>(outSize),Out.end());
+  Out.erase(std::unique(Out.begin()+static_cast<long int>(outSize),
+			Out.end()),Out.end());
+  return;
+}
+
+void
+surfHash::clear()
+  /*!
+    Remove all the surfaces
+  */
+{
+  Buckets.clear();
+  HKey.clear();
+  Pending.clear();
+  return;
+}
+
+void
+surfHash::addSurface(Geometry::Surface* SPtr)
+  /*!
+    Add a surface [ignored if not a hashed type].
+    It is hashed at the next search.
+    \param SPtr :: Surface to add
+  */
+{
+  if (isHashed(SPtr))
+    Pending.push_back(SPtr);
+  return;
+}
+
+void
+surfHash::removeSurface(const Geometry::Surface* SPtr)
+  /*!
+    Remove a surface [before it is deleted]
+    \param SPtr :: Surface to remove
+  */
+{
+  std::unordered_map<const Geometry::Surface*,size_t>::iterator
+    mc=HKey.find(SPtr);
+  if (mc!=HKey.end())
+    {
+      std::vector<Geometry::Surface*>& BVec=Buckets[mc->second];
+      BVec.erase(std::find(BVec.begin(),BVec.end(),SPtr));
+      if (BVec.empty())
+	Buckets.erase(mc->second);
+      HKey.erase(mc);
+      return;
+    }
+  std::vector<Geometry::Surface*>::iterator vc=
+    std::find(Pending.begin(),Pending.end(),SPtr);
+  if (vc!=Pending.end())
+    Pending.erase(vc);
+  return;
+}
+
+void
+surfHash::rehash()
+  /*!
+    Recalculate all the buckets : needed if surfaces
+    have been moved after they were hashed
+  */
+{
+  for(const std::unordered_map<const Geometry::Surface*,
+	size_t>::value_type& HV : HKey)
+    Pending.push_back(const_cast<Geometry::Surface*>(HV.first));
+  Buckets.clear();
+  HKey.clear();
+  return;
+}
+
+void
+surfHash::equalCandidates(const Geometry::Surface* SPtr,
+			  std::vector<Geometry::Surface*>& Out)
+  /*!
+    Get the surfaces that may be equal to SPtr. All surfaces
+    that are equal are found.
+    \param SPtr :: Surface [must be hashed type]
+    \param Out :: Candidate surfaces [added to]
+  */
+{
+  flush();
+  const hashValues HV=getValues(SPtr,1);
+  if (HV.type)
+    probe(HV,Out);
+  return;
+}
+
+void
+surfHash::oppositeCandidates(const Geometry::Surface* SPtr,
+			     std::vector<Geometry::Surface*>& Out)
+  /*!
+    Get the planes that may be opposite to SPtr. All
+    planes that are opposite are found.
+    \param SPtr :: Plane
+    \param Out :: Candidate planes [added to]
+  */
+{
+  flush();
+  const hashValues HV=getValues(SPtr,-1);
+  if (HV.type)
+    probe(HV,Out);
+  return;
+}
+
+} // NAMESPACE ModelSupport
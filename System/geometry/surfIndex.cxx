@@ -26,6 +26,7 @@
 #include <cmath>
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <list>
 #include <stack>
 #include <string>
@@ -61,6 +62,7 @@
 #include "surfEqual.h"
 #include "surfaceFactory.h"
 #include "surfRegister.h"
+#include "surfHash.h"
 #include "surfIndex.h"
 
 #include "Debug.h"
@@ -68,7 +70,8 @@
 namespace ModelSupport
 {
 
-surfIndex::surfIndex() : uniqNum(1)
+surfIndex::surfIndex() :
+  uniqNum(1),HashPtr(new surfHash)
   /*!
     Constructor
   */
@@ -93,6 +96,7 @@ surfIndex::~surfIndex()
   STYPE::iterator mc;
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
+  delete HashPtr;
 }
 
 void
@@ -105,6 +109,7 @@ surfIndex::reset()
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
   SMap.erase(SMap.begin(),SMap.end());
+  HashPtr->clear();
   return;
 }
 
@@ -143,7 +148,10 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      HashPtr->addSurface(SPtr);
+    }
   else
     delete SPtr;
 
@@ -184,6 +192,7 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
     }
 
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  HashPtr->addSurface(SPtr);
 
   return;
 }
@@ -201,10 +210,18 @@ surfIndex::findOpposite(const Geometry::Surface* SPtr)  const
     dynamic_cast<const Geometry::Plane*>(SPtr);
   if (PPtr)
     {
-      STYPE::const_iterator mc;
-      for(mc=SMap.begin();mc!=SMap.end();mc++)
-	if (ModelSupport::oppositeSurfaces(PPtr,mc->second)) 
-	  return mc->first;
+      // lowest numbered opposite plane [as a full map search]
+      std::vector<Geometry::Surface*> CVec;
+      HashPtr->oppositeCandidates(PPtr,CVec);
+      int outN(0);
+      for(const Geometry::Surface* CPtr : CVec)
+	{
+	  const int CN=CPtr->getName();
+	  if ((!outN || CN<outN) &&
+	      ModelSupport::oppositeSurfaces(PPtr,CPtr))
+	    outN=CN;
+	}
+      return outN;
     }
   return 0;
 }
@@ -221,6 +238,7 @@ surfIndex::removeOpposite(const int SN)
   STYPE::iterator sc=SMap.find(SN);
   if (sc!=SMap.end())
     {
+      HashPtr->removeSurface(sc->second);
       delete sc->second;
       SMap.erase(sc);
     }
@@ -247,6 +265,7 @@ surfIndex::removeEqualSurface(const int SNum)
   
   if (NewPtr!=vc->second)
     {
+      HashPtr->removeSurface(vc->second);
       delete vc->second;
       SMap.erase(vc);
     }
@@ -287,14 +306,17 @@ surfIndex::createSurf(const int surfN)
       outPtr=dynamic_cast<T*>(mp->second);
       if (outPtr)
 	return outPtr;
+      HashPtr->removeSurface(mp->second);
       delete mp->second;
       outPtr=new T(surfN,0);
       mp->second=outPtr;
+      HashPtr->addSurface(outPtr);
       ELog::EM<<"Reasigned exiting surface"<<surfN<<ELog::endWarn;
       return outPtr;
     }
   outPtr=new T(surfN,0);
   SMap.insert(STYPE::value_type(surfN,outPtr));
+  HashPtr->addSurface(outPtr);
   return outPtr;
 }
 
@@ -369,6 +391,7 @@ surfIndex::createSurface(const int SN,const int TN,const std::string& SLine)
   if (mc!=SMap.end())
     throw ColErr::InContainerError<int>(SN,"Surface in use");
   SMap.emplace(SN,SPtr);
+  HashPtr->addSurface(SPtr);
   return; 
 }
 
@@ -385,6 +408,7 @@ surfIndex::deleteSurface(const int surfN)
   if (mf==SMap.end())
     throw ColErr::InContainerError<int>(surfN,"surfN");
 
+  HashPtr->removeSurface(mf->second);
   delete mf->second;
   SMap.erase(mf);
 
@@ -408,6 +432,40 @@ surfIndex::checkSurface(const int Snum,const Geometry::Vec3D& Pt) const
   return mf->second->side(Pt);
 }
 
+const surfIndex::STYPE&
+surfIndex::equalMap(const Geometry::Surface* SPtr,STYPE& CMap) const
+  /*!
+    Get the map of surfaces to search for a surface equal
+    to SPtr. For hashed surface types this is the small
+    set of candidates found in the hash.
+    \param SPtr :: Surface to find
+    \param CMap :: Candidate map [filled if hashed]
+    \return CMap / full surface map
+  */
+{
+  ELog::RegMethod RegA("surfIndex","equalMap");
+
+  if (!surfHash::isHashed(SPtr))
+    return SMap;
+
+  std::vector<Geometry::Surface*> CVec;
+  HashPtr->equalCandidates(SPtr,CVec);
+  for(Geometry::Surface* CPtr : CVec)
+    CMap.emplace(CPtr->getName(),CPtr);
+  return CMap;
+}
+
+void
+surfIndex::rehash()
+  /*!
+    Recalculate the surface hash : required after the
+    surfaces in the map have been moved
+  */
+{
+  HashPtr->rehash();
+  return;
+}
+
 Geometry::Surface*
 surfIndex::getSurf(const int Index) const
   /*!
@@ -437,11 +495,59 @@ surfIndex::renumber(const int origNum,const int newNum)
     }
   Geometry::Surface* SPtr=mc->second;
   SMap.erase(mc);
+  HashPtr->removeSurface(SPtr);
   SPtr->setName(newNum);
   insertSurface(SPtr);
   return;
 }
 
+void 
+surfIndex::renumber(const std::map<int,int>& RMap)
+  /*!
+    Renumber a set of surfaces in one step. All the surfaces
+    are removed before any is re-inserted so the map can be 
+    any permutation of numbers [e.g. a->b and b->a]
+    \param RMap :: Map of original number : new number
+  */
+{
+  ELog::RegMethod RegA("surfIndex","renumber");
+
+  std::vector<std::pair<Geometry::Surface*,int>> Moved;
+  std::vector<std::pair<int,int>> Hold;
+  for(const std::map<int,int>::value_type& RM : RMap)
+    {
+      if (RM.first==RM.second) continue;
+      STYPE::iterator mc=SMap.find(RM.first);
+      if (mc==SMap.end())
+	{
+	  ELog::EM<<"Surface "<<RM.first<<" does not exist"<<ELog::endWarn;
+	  continue;
+	}
+      Moved.push_back(std::pair<Geometry::Surface*,int>
+		      (mc->second,RM.second));
+      SMap.erase(mc);
+
+      std::map<int,int>::iterator hc=holdMap.find(RM.first);
+      if (hc!=holdMap.end())
+	{
+	  Hold.push_back(std::pair<int,int>(RM.second,hc->second));
+	  holdMap.erase(hc);
+	}
+    }
+
+  // surfaces are not moved so the hash is unchanged
+  for(const std::pair<Geometry::Surface*,int>& MV : Moved)
+    {
+      MV.first->setName(MV.second);
+      if (!SMap.insert(STYPE::value_type(MV.second,MV.first)).second)
+	throw ColErr::InContainerError<int>(MV.second,"New surface number");
+    }
+  for(const std::pair<int,int>& HV : Hold)
+    holdMap[HV.first]=HV.second;
+
+  return;
+}
+
 int
 surfIndex::calcRenumber(const int allowedSurf,
 			std::vector<std::pair<int,int> >& ChangeList) const
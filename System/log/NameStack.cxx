@@ -3,7 +3,7 @@
  
  * File:   log/NameStack.cxx
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2018 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -29,36 +29,48 @@
 namespace ELog
 {
 
+const size_t NameStack::maxDepth;
+
 NameStack::NameStack() :
-  extraLevel(0),indentLevel(0)
+  depth(0),extraLevel(0),indentLevel(0)
   /*!
     Constructor
   */
 {}
 
 NameStack::NameStack(const NameStack& A) :
-  key(A.key),Class(A.Class),Method(A.Method),
-  Extra(A.Extra),extraLevel(A.extraLevel),
-  indentLevel(A.indentLevel)
+  depth(0),extraLevel(0),indentLevel(0)
   /*!
     Copy Constructor
     \param A :: NameStack to copy
   */
-{}
+{
+  *this=A;
+}
 
 NameStack&
 NameStack::operator=(const NameStack& A) 
   /*!
     Assignment operator
+    Owned strings are copied and the pointers reset to them.
     \param A :: NameStack to copy
     \return *this
   */
 {
   if (this!=&A)
     {
-      key=A.key;
-      Class=A.Class;
-      Method=A.Method;
+      depth=A.depth;
+      for(size_t i=0;i<depth && i<maxDepth;i++)
+	{
+	  const nameItem& AI(A.Items[i]);
+	  nameItem& NI(Items[i]);
+	  NI.classStr=AI.classStr;
+	  NI.methodStr=AI.methodStr;
+	  NI.classPtr=(AI.classPtr==AI.classStr.c_str()) ?
+	    NI.classStr.c_str() : AI.classPtr;
+	  NI.methodPtr=(AI.methodPtr==AI.methodStr.c_str()) ?
+	    NI.methodStr.c_str() : AI.methodPtr;
+	}
       Extra=A.Extra;
       extraLevel=A.extraLevel;
       indentLevel=A.indentLevel;
@@ -72,9 +84,7 @@ NameStack::clear()
    Clear the stack
  */
 {
-  key.erase(key.begin(),key.end());
-  Class.clear();
-  Method.clear();
+  depth=0;
   Extra.clear();
   extraLevel=0;
   indentLevel=0;
@@ -85,32 +95,21 @@ void
 NameStack::addComp(const std::string& CN,
 		   const std::string& MN)
   /*!
-    Adds a component to the class names series
+    Adds a component to the class names series.
+    The strings are copied into the slot store
     \param CN :: Class name
     \param MN :: Method name
   */
 {
-  Class.push_back(CN);
-  Method.push_back(MN);
-  return;
-}
-  
-void
-NameStack::popBack() 
-  /*!
-    Pop back a item
-  */
-{
-  if (!Class.empty())
+  if (depth<maxDepth)
     {
-      if (extraLevel==Class.size())
-	{
-	  Extra.clear();
-	  extraLevel=0;
-	}
-      Class.pop_back();
-      Method.pop_back();
+      nameItem& NI(Items[depth]);
+      NI.classStr=CN;
+      NI.methodStr=MN;
+      NI.classPtr=NI.classStr.c_str();
+      NI.methodPtr=NI.methodStr.c_str();
     }
+  depth++;
   return;
 }
 
@@ -122,7 +121,7 @@ NameStack::setExtra(const std::string& A)
    */
 {
   Extra=A;
-  extraLevel=Class.size();
+  extraLevel=depth;
   return;
 }
 
@@ -135,6 +134,19 @@ NameStack::getExtra() const
 {
   return Extra;
 }
+
+std::string
+NameStack::itemStr(const size_t Index) const
+  /*!
+    Get the Class::Method string of an item
+    \param Index :: Item [less than depth]
+    \return Class::Method / "..." if not recorded
+  */
+{
+  if (Index>=maxDepth)
+    return "...";
+  return std::string(Items[Index].classPtr)+"::"+Items[Index].methodPtr;
+}
   
 std::string
 NameStack::getBase() const 
@@ -143,8 +155,7 @@ NameStack::getBase() const
     \return BaseItem
   */
 {
-  return (Class.empty()) ?  
-    "" : Class.back()+"::"+Method.back();
+  return (!depth) ? "" : itemStr(depth-1);
 }
 
 std::string
@@ -156,17 +167,15 @@ NameStack::getItem(const long int Index) const
     \return BaseItem
   */
 {
-  if (Class.empty()) return "";
+  if (!depth) return "";
   if (!Index) 
-    return Class.back()+"::"+Method.back();
+    return itemStr(depth-1);
   
-  const size_t CSize=Class.size();
- 
   const size_t itx( (Index<0) 
-		    ? (CSize-static_cast<size_t>(1-Index)) 
+		    ? (depth-static_cast<size_t>(1-Index)) 
 		    : static_cast<size_t>(Index));
 
-  return (itx<CSize) ? Class[itx]+"::"+Method[itx] : "";
+  return (itx<depth) ? itemStr(itx) : "";
 } 
 
 std::string
@@ -176,13 +185,12 @@ NameStack::getFull() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
-  std::string Out=*vc+"::"+*ac;
-  for(ac++,vc++;vc!=Class.end();vc++,ac++)
+  if (!depth) return "";
+  std::string Out=itemStr(0);
+  for(size_t i=1;i<depth && i<=maxDepth;i++)
     {
       Out+="#";
-      Out+=*vc+"::"+*ac;
+      Out+=itemStr(i);
     }
   if (!Extra.empty())
     {
@@ -199,15 +207,14 @@ NameStack::getFullTree() const
     \return BaseItem
   */
 {
-  std::vector<std::string>::const_iterator vc(Class.begin());
-  std::vector<std::string>::const_iterator ac(Method.begin());
+  if (!depth) return "";
   size_t indent(2);
-  std::string Out=*vc+"::"+*ac;
-  for(ac++,vc++;vc!=Class.end();vc++,ac++,indent+=2)
+  std::string Out=itemStr(0);
+  for(size_t i=1;i<depth && i<=maxDepth;i++,indent+=2)
     {
       Out+='\n';
       Out+=std::string(indent,' ');
-      Out+=*vc+"::"+*ac;
+      Out+=itemStr(i);
     }
   if (!Extra.empty())
     {
@@ -3,7 +3,7 @@
  
  * File:   log/RegMethod.cxx
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2018 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,7 +33,21 @@
 namespace ELog
 {
 
-NameStack RegMethod::Base;
+thread_local NameStack* RegMethod::BasePtr(0);
+
+NameStack&
+RegMethod::createStack()
+  /*!
+    Create the stack for the current thread. The pointer
+    is held separately so that the inline access does not
+    need the thread_local initialization guard.
+    \return NameStack for this thread
+  */
+{
+  static thread_local NameStack Base;
+  BasePtr=&Base;
+  return Base;
+}
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
@@ -44,7 +58,7 @@ RegMethod::RegMethod(const std::string& CN,
     \param MN :: Method name
   */
 {
-  Base.addComp(CN,MN);
+  getStack().addComp(CN,MN);
 
 }
 
@@ -61,17 +75,7 @@ RegMethod::RegMethod(const std::string& CN,
 {
   std::ostringstream cx;
   cx<<"<"<<param<<">";
-  Base.addComp(CN+cx.str(),MN);
-}
-
-RegMethod::~RegMethod() 
-  /*!
-    Destructor removes one from the stack
-  */
-{
-  Base.popBack();
-  if (indentLevel) 
-    Base.addIndent(-indentLevel);
+  getStack().addComp(CN+cx.str(),MN);
 }
 
 void
@@ -82,7 +86,7 @@ RegMethod::setTrack(const std::string& ES)
     \param ES :: Extra string
   */
 {
-  Base.setExtra(ES);
+  getStack().setExtra(ES);
   return;
 }
 
@@ -92,7 +96,7 @@ RegMethod::clearTrack()
     Clear the extra track
    */
 {
-  Base.clearExtra();
+  getStack().clearExtra();
   return;
 }
   
@@ -103,7 +107,7 @@ RegMethod::incIndent()
   */
 {
   indentLevel+=2;
-  Base.addIndent(2);
+  getStack().addIndent(2);
   return;
 }
 
@@ -114,7 +118,7 @@ RegMethod::decIndent()
   */
 {
   indentLevel-=2;
-  Base.addIndent(-2);
+  getStack().addIndent(-2);
   return;
 }
 
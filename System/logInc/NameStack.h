@@ -3,7 +3,7 @@
  
  * File:   logInc/NameStack.h
  *
- * Copyright (c) 2004-2015 by Stuart Ansell
+ * Copyright (c) 2004-2018 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -28,20 +28,38 @@ namespace ELog
     \class NameStack 
     \brief Holds a list of items for a calling stack
     \author S. Ansell
-    \version 1.0
-    \date June 2009
+    \version 1.1
+    \date June 2018
+
+    Items are held in a fixed array as character pointers.
+    Names given as literals are stored without copying;
+    names built as strings are copied into the owned
+    string of the array slot. Calls deeper than maxDepth
+    are counted but not recorded.
   */
 class NameStack
 {
  private:
 
-  std::map<std::string,int> key;        ///< Key names
-  std::vector<std::string> Class;       ///< Class Name
-  std::vector<std::string> Method;      ///< Method Name
+  static const size_t maxDepth=512;     ///< Recorded depth
+
+  /// Single stack item
+  struct nameItem
+  {
+    const char* classPtr;    ///< Class name
+    const char* methodPtr;   ///< Method name
+    std::string classStr;    ///< Store for non-literal class
+    std::string methodStr;   ///< Store for non-literal method
+  };
+
+  nameItem Items[maxDepth];             ///< Stack items
+  size_t depth;                         ///< Current depth
   std::string Extra;                    ///< Extra tag if neeed
   size_t extraLevel;                    ///< Extra tag if neeed
   long int indentLevel;                 ///< Indent level
 
+  std::string itemStr(const size_t) const;
+
  public:
 
   NameStack();
@@ -55,9 +73,32 @@ class NameStack
   void setExtra(const std::string&);
   /// Remove extra output for exception [early]
   void clearExtra() { Extra.clear(); }
+
+  /// Add a component [literals : not copied]
+  void addComp(const char* CN,const char* MN)
+    {
+      if (depth<maxDepth)
+	{
+	  Items[depth].classPtr=CN;
+	  Items[depth].methodPtr=MN;
+	}
+      depth++;
+    }
   void addComp(const std::string&,const std::string&);
-  void popBack();
 
+  /// Remove the last component
+  void popBack()
+    {
+      if (depth)
+	{
+	  if (extraLevel==depth)
+	    {
+	      Extra.clear();
+	      extraLevel=0;
+	    }
+	  depth--;
+	}
+    }
   
   std::string getBase() const;
   std::string getItem(const long int) const;
@@ -66,7 +107,7 @@ class NameStack
   const std::string& getExtra() const;
 
   /// Access depth of function:
-  size_t getDepth() const { return Class.size(); }
+  size_t getDepth() const { return depth; }
 
   void addIndent(const long int);
   /// Output of the indent level
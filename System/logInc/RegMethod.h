@@ -3,7 +3,7 @@
  
  * File:   logInc/RegMethod.h
  *
- * Copyright (c) 2004-2016 by Stuart Ansell
+ * Copyright (c) 2004-2018 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,13 +33,20 @@ namespace ELog
 
     This class is called as a registration class.
     It keeps location etc possible for 
+    exception backtraces. Literal names are registered
+    without allocation.
   */
 
 class RegMethod
 {
  private:
 
-  static NameStack Base;           ///< Singleton of base to register
+  static thread_local NameStack* BasePtr;  ///< Stack of base [per thread]
+
+  static NameStack& createStack();
+  /// Access the stack of this thread
+  static NameStack& getStack()
+    { return (BasePtr) ? *BasePtr : createStack(); }
 
   int indentLevel;                 ///< Additional indent
   /// \cond NOWRITTEN
@@ -50,26 +57,62 @@ class RegMethod
  public:
 
   /// Access NameStack pointer
-  NameStack* getBasePtr() { return &Base; }
+  NameStack* getBasePtr() { return &getStack(); }
+  /// Constructor [literals]
+  RegMethod(const char* CN,const char* MN) :
+    indentLevel(0) { getStack().addComp(CN,MN); }
   RegMethod(const std::string&,const std::string&);
   RegMethod(const std::string&,const std::string&,const int);
-  ~RegMethod();
+  /// Destructor removes one from the stack
+  ~RegMethod()
+    {
+      getStack().popBack();
+      if (indentLevel) 
+	getStack().addIndent(-indentLevel);
+    }
 
   void setTrack(const std::string&);
   void clearTrack();
   
   /// Access string
-  static std::string getBase() { return Base.getBase(); }
+  static std::string getBase() { return getStack().getBase(); }
   /// Access string
-  static std::string getFull() { return Base.getFullTree(); }
+  static std::string getFull() { return getStack().getFullTree(); }
   /// Access particular item 
-  static std::string getItem(const int I) { return Base.getItem(I); }
+  static std::string getItem(const int I) { return getStack().getItem(I); }
 
   void incIndent();
   void decIndent();
 
 };
 
+#ifdef NO_HOTREG
+/*!
+  \class RegHot
+  \brief Registration for hot paths [compiled out]
+  \author S. Ansell
+  \date June 2018
+  \version 1.0
+
+  Used in place of RegMethod in small functions called
+  inside tracking loops. With NO_HOTREG the function is
+  not registered and a backtrace ends at its caller.
+*/
+
+class RegHot
+{
+ public:
+
+  /// Constructor [no action]
+  RegHot(const char*,const char*) {}
+};
+
+#else
+
+typedef RegMethod RegHot;     ///< Hot path registration
+
+#endif
+
 }
 
 #endif
@@ -1123,77 +1123,60 @@ int
 Acomp::makePI(std::vector<BnId>& DNFobj) const
   /*!
     This method finds the principle implicants.
+    The work list is sorted by true count so only
+    items in adjacent true count groups are compared.
     \param DNFobj :: A vector of Binary ID from a true 
     vectors of keyvalues.
     \returns number of PIs found.
-    \todo  Can we set this up to get non-pairs
-    i.e. one pass.
-    
   */
 {
   if (DNFobj.empty())   // no work to do return.
     return 0;
   // Note: need to store PI components separately
   // since we don't want to loop continuously through them
-  std::vector<BnId> Work;       // Working copy
-  std::vector<BnId> PIComp;     // Store for PI componends
-  std::vector<BnId> Tmod;       // store modified components
-  int changeCount(0);           // Number change
-  std::vector<BnId>::iterator uend;     // itor to remove unique
-  // Need to make an initial copy.
-  Work=DNFobj;
-
-  int cnt(0);
+  std::vector<BnId> Work(DNFobj);   // Working copy
+  std::vector<BnId> PIComp;         // Store for PI componends
+  std::vector<BnId> Tmod;           // store modified components
+  BnId Combined;                    // combined pair
+
   do
     {
-      cnt++;
-      // Deal with tri-state objects ??
       sort(Work.begin(),Work.end());
-      uend=unique(Work.begin(),Work.end());
-      Work.erase(uend,Work.end());
+      Work.erase(unique(Work.begin(),Work.end()),Work.end());
       Tmod.clear();                  // erase all at the start
 
       //set PI status to 1
-      for_each( Work.begin(),Work.end(),
-		std::bind2nd(std::mem_fun_ref(&BnId::setPI),1) );
-
-      //Collect into pairs which have a difference of +/- one 
-      // object
-      // Can sort this realive to 
-      std::vector<BnId>::iterator vc;
-      for(vc=Work.begin();vc!=Work.end();vc++)
-	{
-	  const size_t GrpIndex(vc->TrueCount()+1);
-	  std::vector<BnId>::iterator oc=vc+1;
+      for(BnId& BI : Work)
+	BI.setPI(1);
 
-	  for(oc=vc+1;oc!=Work.end();oc++)
-	    {
-	      const size_t OCnt=oc->TrueCount();
-			
-
-	      if (OCnt>GrpIndex)
-		break;
-	      if (OCnt==GrpIndex)
-	        {
-		  std::pair<int,BnId> cVal=vc->makeCombination(*oc);
-		  if (cVal.first==1)   // was complementary
-		    {
-		      Tmod.push_back(cVal.second);
-		      oc->setPI(0);         
-		      vc->setPI(0);
-		      changeCount++;       // 1 changed
-		    }
+      // Collect into pairs which have a difference of +/- one
+      // object : group [gA,gB) with next group [gB,gC)
+      std::vector<BnId>::iterator gA=Work.begin();
+      while(gA!=Work.end())
+	{
+	  const size_t GrpIndex(gA->TrueCount());
+	  std::vector<BnId>::iterator gB;
+	  for(gB=gA;gB!=Work.end() && gB->TrueCount()==GrpIndex;gB++) ;
+	  std::vector<BnId>::iterator gC;
+	  for(gC=gB;gC!=Work.end() && gC->TrueCount()==GrpIndex+1;gC++) ;
+
+	  for(std::vector<BnId>::iterator vc=gA;vc!=gB;vc++)
+	    for(std::vector<BnId>::iterator oc=gB;oc!=gC;oc++)
+	      if (vc->combine(*oc,Combined))   // was complementary
+		{
+		  Tmod.push_back(Combined);
+		  oc->setPI(0);         
+		  vc->setPI(0);
 		}
-	    }
+	  gA=gB;
 	}
 
       for(const BnId& BI : Work)
 	if (BI.PIstatus()==1)
 	  PIComp.push_back(BI);
       
-      Work=Tmod;
-    } while (!Tmod.empty());
-  // Copy over the unit.
+      Work.swap(Tmod);
+    } while (!Work.empty());
 
   return makeEPI(DNFobj,PIComp);
 }
@@ -1206,6 +1189,7 @@ Acomp::makeEPI(std::vector<BnId>& DNFobj,
     Creates an essentual PI list (note: this is 
     not unique).
     Given the list form the EPI based on the Quine-McClusky method.
+    The PI / DNF cover table is held as a bitset for each PI.
 
     \param DNFobj :: Object in DNF form 
     \param PIform :: List of rules in Prime Implicant form
@@ -1221,13 +1205,13 @@ Acomp::makeEPI(std::vector<BnId>& DNFobj,
   
   std::vector<BnId> EPI;  // Created Here.
 
-  std::vector<int> EPIvalue;
-  // Make zeroed matrix.
-  Geometry::MatrixBase<int> Grid(PIform.size(),DNFobj.size()); 
-  std::vector<size_t> DNFactive(DNFobj.size());       // DNF that active
+  const size_t wordBits(BnId::maxSize);
+  const size_t nWord((DNFobj.size()+wordBits-1)/wordBits);
+  // Cover[pc*nWord+i] : DNF items that PIform[pc] covers
+  std::vector<unsigned long int> Cover(PIform.size()*nWord,0UL);
+  std::vector<unsigned long int> Remain(nWord,0UL);   // DNF not covered
   std::vector<size_t> PIactive(PIform.size());        // PI that are active
   std::vector<int> DNFscore(DNFobj.size());        // Number in each channel
-  std::vector<int> PIscore(DNFobj.size());        // Number in each channel
   
   //Populate
   for(size_t pc=0;pc!=PIform.size();pc++)
@@ -1235,12 +1219,14 @@ Acomp::makeEPI(std::vector<BnId>& DNFobj,
   
   for(size_t ic=0;ic!=DNFobj.size();ic++)
     {
-      DNFactive[ic]=ic;                            //populate (avoid a loop)
+      const unsigned long int bit(1UL << (ic % wordBits));
+      const size_t word(ic/wordBits);
+      Remain[word]|=bit;
       for(size_t pc=0;pc!=PIform.size();pc++)
 	{
 	  if (PIform[pc].equivalent(DNFobj[ic]))
 	    {
-	      Grid[pc][ic]=1;
+	      Cover[pc*nWord+word]|=bit;
 	      DNFscore[ic]++;
 	    }
 	}
@@ -1255,79 +1241,60 @@ Acomp::makeEPI(std::vector<BnId>& DNFobj,
 	  return 0;
 	}
     }
-  /// DEBUG PRINT 
-  //  printImplicates(PIform,Grid);
-  /// END DEBUG
 
-  std::vector<size_t>::iterator dx;
-  std::vector<size_t>::iterator ddx;    // DNF active iterator
   std::vector<size_t>::iterator px;     // PIactive iterator
 
   // 
   // First remove singlets:
   // 
-  for(dx=DNFactive.begin();dx!=DNFactive.end();dx++)
+  for(size_t ic=0;ic!=DNFobj.size();ic++)
     {
-      if (*dx!=ULONG_MAX && DNFscore[*dx]==1)        // EPI (definately)
+      const unsigned long int bit(1UL << (ic % wordBits));
+      const size_t word(ic/wordBits);
+      if ((Remain[word] & bit) && DNFscore[ic]==1)        // EPI (definately)
 	{
 	  for(px=PIactive.begin();
-	      px!=PIactive.end() && !Grid[*px][*dx];px++) ;
+	      px!=PIactive.end() && !(Cover[*px*nWord+word] & bit);px++) ;
 	  if (px!=PIactive.end())
 	    {
 	      EPI.push_back(PIform[*px]);
 	      // remove all minterm that the EPI covered
-	      for(ddx=DNFactive.begin();ddx!=DNFactive.end();ddx++)
-		if (*ddx!=ULONG_MAX && Grid[*px][*ddx])
-		  *ddx= ULONG_MAX;      //mark for deletion (later)
+	      for(size_t i=0;i<nWord;i++)
+		Remain[i]&= ~Cover[*px*nWord+i];
 	      // Can remove PIactive now.
-	      PIactive.erase(px,px+1);
+	      PIactive.erase(px);
 	    }
 	}
     }
-  // Remove dead items from active list
-  DNFactive.erase(
-    remove_if(DNFactive.begin(),DNFactive.end(),
-	      std::bind(std::equal_to<size_t>(),
-			std::placeholders::_1,ULONG_MAX)),
-    DNFactive.end());
 
+  // Ok -- now the hard work...
+  // need to find shortest "combination" that spans
+  // the remaining table.
+  
+  // Cover of the active PI over the remaining DNF items
+  const size_t Psize(PIactive.size());
+  std::vector<unsigned long int> Cmat(Psize*nWord);
+  for(size_t cm=0;cm<Psize;cm++)
+    for(size_t i=0;i<nWord;i++)
+      Cmat[cm*nWord+i]=Cover[PIactive[cm]*nWord+i] & Remain[i];
 
   /// DEBUG PRINT 
   if (debug)
     {
-      for(px=PIactive.begin();px!=PIactive.end();px++)
+      for(size_t cm=0;cm<Psize;cm++)
 	{
-	  ELog::EM<<PIform[*px]<<":";
-	  for(ddx=DNFactive.begin();ddx!=DNFactive.end();ddx++)
-	    ELog::EM<<((Grid[*px][*ddx]) ? " 1" : " 0");
+	  ELog::EM<<PIform[PIactive[cm]]<<":";
+	  for(size_t ic=0;ic!=DNFobj.size();ic++)
+	    if ((Remain[ic/wordBits] >> (ic % wordBits)) & 1UL)
+	      ELog::EM<<(((Cmat[cm*nWord+ic/wordBits] >>
+			   (ic % wordBits)) & 1UL) ? " 1" : " 0");
 	  ELog::EM<<ELog::endDebug;
 	}
       ELog::EM<<"END OF TABLE "<<ELog::endDebug;
     }
 
-  // Ok -- now the hard work...
-  // need to find shortest "combination" that spans
-  // the remaining table.
-  
-  // First Make a new matrix for speed.  Useful ???
-  Geometry::MatrixBase<int> Cmat(PIactive.size(),DNFactive.size());  // corrolation matrix
-  size_t cm(0);
-  for(px=PIactive.begin();px!=PIactive.end();px++)
-    {
-      size_t dm(0);
-      for(ddx=DNFactive.begin();ddx!=DNFactive.end();ddx++)
-	{
-	  if (Grid[*px][*ddx])
-	    Cmat[cm][dm]=1;
-	  dm++;
-	} 
-      cm++;
-    }
-
-  const size_t Dsize(DNFactive.size());
-  const size_t Psize(PIactive.size());
   //icount == depth of search ie 
-
+  std::vector<unsigned long int> Span(nWord);
   for(size_t Icount=1;Icount<Psize;Icount++)
     {
       // This counter is a ripple counter, ie 1,2,3 where no numbers 
@@ -1335,21 +1302,21 @@ Acomp::makeEPI(std::vector<BnId>& DNFobj,
       // index by A, A+1 ,A+2  etc
       RotaryCounter<size_t> Index(Icount,Psize);
       do {
-	size_t di;
-	for(di=0;di<Dsize;di++)   //check each orignal position
+	std::fill(Span.begin(),Span.end(),0UL);
+	for(size_t vecI=0;vecI<Icount;vecI++)
 	  {
-	    size_t vecI;
-	    for(vecI=0;vecI<Icount &&
-		  !Cmat[Index[vecI]][di];vecI++) ;
-	    if (vecI==Icount)
-	      break;
+	    const unsigned long int* CPtr=&Cmat[Index[vecI]*nWord];
+	    for(size_t i=0;i<nWord;i++)
+	      Span[i]|=CPtr[i];
 	  }
-	if (di==Dsize)          // SUCCESS!!!!!
+	size_t i;
+	for(i=0;i<nWord && Span[i]==Remain[i];i++) ;
+	if (i==nWord)          // SUCCESS!!!!!
 	  {
 	    for(size_t iout=0;iout<Icount;iout++)
-	      EPI.push_back(PIform[Index[iout]]);
+	      EPI.push_back(PIform[PIactive[Index[iout]]]);
 	    DNFobj=EPI;
-	    return 1;;
+	    return 1;
 	  }
       } while(!(++Index));
     }
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <bitset>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -44,6 +45,7 @@
 
 /// Setter form
 int BnId::fullOut(0);
+const size_t BnId::maxSize;
 
 std::ostream&
 operator<<(std::ostream& OX,const BnId& A) 
@@ -59,36 +61,28 @@ operator<<(std::ostream& OX,const BnId& A)
 }
 
 BnId::BnId() :
-  size(0),PI(1),Tnum(0),Znum(0)
+  size(0),PI(1),Tnum(0),Znum(0),care(0),value(0)
   /*!
     Standard Constructor
   */
 {}
 
 BnId::BnId(const size_t TSize,const size_t X) :
-  size(TSize),PI(1),Tnum(0),Znum(0),Tval(TSize)
+  size(TSize),PI(1),Tnum(0),Znum(0),
+  care(sizeMask(TSize)),value(X & care)
   /*!
     Constructer that creates a true/false mapping
     without the  undetermined option
-    \param TSize :: size of the vector Tval. (number of surfaces)
+    \param TSize :: number of variables (number of surfaces)
     \param X :: integer for of the binary representation 
   */
 {
-  size_t cnt=1;
-  long int sum(0);
-  for(size_t i=0;i<size;cnt*=2,i++)
-    { 
-      Tval[i] = (X & cnt) ? 1 : -1;
-      sum+=Tval[i];
-    }
-  // counts number of true numbers
-  Tnum=static_cast<size_t>((sum+static_cast<long>(size))/2);
-  Znum=size-Tnum;
+  setCounters();
 }
 
 BnId::BnId(const BnId& A) :
-  size(A.size),PI(A.PI),Tnum(A.Tnum),
-  Znum(A.Znum),Tval(A.Tval),MinTerm(A.MinTerm)
+  size(A.size),PI(A.PI),Tnum(A.Tnum),Znum(A.Znum),
+  care(A.care),value(A.value),MinTerm(A.MinTerm)
   /*!
     Standard Copy Constructor
     \param A :: Object to copy
@@ -109,7 +103,8 @@ BnId::operator=(const BnId& A)
       PI=A.PI;
       Tnum=A.Tnum;
       Znum=A.Znum;
-      Tval=A.Tval;
+      care=A.care;
+      value=A.value;
       MinTerm=A.MinTerm;
     }
   return *this;
@@ -121,6 +116,19 @@ BnId::~BnId()
    */
 {}
 
+unsigned long int
+BnId::sizeMask(const size_t N)
+  /*!
+    Mask of the first N bits
+    \param N :: Number of variables
+    \return mask
+  */
+{
+  if (N>maxSize)
+    throw ColErr::RangeError<size_t>(N,0,maxSize,"BnId::sizeMask");
+  return (N==maxSize) ? ~0UL : (1UL << N)-1UL;
+}
+
 int
 BnId::operator==(const BnId& A) const
   /*!
@@ -130,19 +138,7 @@ BnId::operator==(const BnId& A) const
     \retval 0 == not equal 
   */
 {
-  if (A.size!=size || A.Tnum!=Tnum
-      || A.Znum!=Znum)
-    return 0;
-  std::vector<int>::const_iterator vc;
-  std::vector<int>::const_iterator ac=A.Tval.begin();
-  for(vc=Tval.begin();vc!=Tval.end();vc++,ac++)
-    {
-      if (ac==A.Tval.end())     // This should neve happen
-	return 0;
-      if (*vc!=*ac)
-	return 0;
-    }
-  return 1;
+  return (A.size==size && A.care==care && A.value==value) ? 1 : 0;
 }
 
 int
@@ -157,15 +153,10 @@ BnId::equivalent(const BnId& A) const
 {
   if (A.size!=size)
     return 0;
-  int retval=1;
-  for(size_t i=0;i<size;i++)
-    {
-      if (Tval[i]*A.Tval[i]<0)          //true * false == -1.
-        return 0;
-      if (Tval[i]!=A.Tval[i]) 
-	retval=2;
-    }
-  return retval;
+  // true/false in the same place
+  if ((value ^ A.value) & care & A.care)
+    return 0;
+  return (care==A.care) ? 1 : 2;
 }
 
 int 
@@ -185,7 +176,7 @@ BnId::operator<(const BnId& A) const
     Tri-state return of the ordering of number of true states
     \param A :: BnId object to compare
     \returns Size<A.size, N of True<A.N of True,
-       IntVal<A.IntVal
+       Tval<A.Tval from the highest bit
   */
 {
   if (A.size!=size)
@@ -194,16 +185,20 @@ BnId::operator<(const BnId& A) const
   if (Tnum!=A.Tnum)
     return (Tnum<A.Tnum) ? 1 : 0;
 
-  std::vector<int>::const_reverse_iterator tvc=Tval.rbegin();
-  std::vector<int>::const_reverse_iterator avc=A.Tval.rbegin();
-  while(tvc!=Tval.rend())
-    {
-      if (*tvc!=*avc)
-	return *tvc<*avc;
-      tvc++;
-      avc++;
-    }
-  return 0;
+  unsigned long int diff=(value ^ A.value) | (care ^ A.care);
+  if (!diff)
+    return 0;
+  // reduce to highest differing bit
+  for(unsigned int shift=1;shift<maxSize;shift*=2)
+    diff|=diff>>shift;
+  diff^=diff>>1;
+
+  // order is false : don't care : true
+  if (value & diff)
+    return 0;
+  if (A.value & diff)
+    return 1;
+  return (care & diff) ? 1 : 0;
 }
 
 int
@@ -211,13 +206,16 @@ BnId::operator[](const size_t A) const
   /*!
     Returns the particular rule value
     \param A :: array offset 0->size-1
-    \returns -99 on err, Tval[A] normally
+    \returns Tval[A] [1/0/-1]
   */
 {
   if (A>=size)
     throw ColErr::IndexError<size_t>(A,size,"BnId::operator[]"+
 				     ELog::RegMethod::getFull());
-  return Tval[A];
+  const unsigned long int bit(1UL << A);
+  if (!(care & bit))
+    return 0;
+  return (value & bit) ? 1 : -1;
 }
 
 int 
@@ -242,21 +240,11 @@ BnId::operator++()
     \retval 1 :: no loop occored
   */
 {
-  std::vector<int>::iterator vc;
-  for(vc=Tval.begin();vc!=Tval.end() && (*vc)!=-1;vc++)
-    {
-      if (*vc==1)
-	{
-	  Tnum--;
-	  *vc= -1;
-	}
-    }
-  if (vc==Tval.end())
-    return 0;
-  // Normal exit
-  *vc=1;
-  Tnum++;
-  return 1;
+  // carry passes through the don't-care bits
+  const int flag((value==care) ? 0 : 1);
+  value=((value | ~care)+1UL) & care;
+  setCounters();
+  return flag;
 }
 
 int 
@@ -281,19 +269,10 @@ BnId::operator--()
     \retval 1 :: no loop occored
   */
 {
-  std::vector<int>::iterator vc;
-  for(vc=Tval.begin();vc!=Tval.end() && (*vc)!=1;vc++)
-    if (*vc== -1)
-      {
-	*vc= 1;
-	Tnum++;
-      }
-  if (vc==Tval.end())       // Loop took place
-    return 0;
-
-  *vc= -1;
-  Tnum--;
-  return 1;
+  const int flag((value) ? 1 : 0);
+  value=(value-1UL) & care;
+  setCounters();
+  return flag;
 }
 
 void
@@ -303,8 +282,12 @@ BnId::setMinTerm(const int MT)
     \param MT :: Value to set
    */
 {
-  MinTerm.erase(MinTerm.begin(),MinTerm.end());
-  MinTerm.insert(MT);
+  if (MT<0)
+    throw ColErr::IndexError<int>(MT,0,"BnId::setMinTerm");
+
+  const size_t index(static_cast<size_t>(MT));
+  MinTerm.assign(index/maxSize+1,0UL);
+  MinTerm.back()=1UL << (index % maxSize);
   return;
 }
     
@@ -316,7 +299,10 @@ BnId::addMinTerm(const BnId& A)
     \param A :: BnId item to associate
    */
 {
-  MinTerm.insert(A.MinTerm.begin(),A.MinTerm.end());
+  if (MinTerm.size()<A.MinTerm.size())
+    MinTerm.resize(A.MinTerm.size(),0UL);
+  for(size_t i=0;i<A.MinTerm.size();i++)
+    MinTerm[i]|=A.MinTerm[i];
   return;
 }
 
@@ -328,8 +314,11 @@ BnId::hasMinTerm(const int Index) const
     \return True if index is found
    */
 {
-  std::set<int>::const_iterator sv=MinTerm.find(Index);
-  return (sv==MinTerm.end()) ? 0 : 1;
+  if (Index<0) return 0;
+  const size_t index(static_cast<size_t>(Index));
+  const size_t word(index/maxSize);
+  return (word<MinTerm.size() &&
+	  ((MinTerm[word] >> (index % maxSize)) & 1UL)) ? 1 : 0;
 }
 
 void
@@ -338,16 +327,8 @@ BnId::setCounters()
     Sets the counters Tnum and Znum
   */
 {
-  std::vector<int>::const_iterator vc;
-  Tnum=0;
-  Znum=0;
-  for(vc=Tval.begin();vc!=Tval.end();vc++)
-    {
-      if (*vc==1)
-	Tnum++;
-      else if (*vc==0)
-	Znum++;
-    }
+  Tnum=std::bitset<maxSize>(value).count();
+  Znum=size-std::bitset<maxSize>(care).count();
   return;
 }
 
@@ -359,14 +340,7 @@ BnId::intValue() const
     \returns lowest bit in the BnId vector
   */
 {
-  size_t out(0);
-  std::vector<int>::const_reverse_iterator vc;
-  for(vc=Tval.rbegin();vc!=Tval.rend();vc++)
-    {
-      out<<=1;
-      out+=((*vc)==1) ? 1 : 0;
-    }
-  return out;
+  return value;
 }
 
 void
@@ -379,7 +353,7 @@ BnId::mapState(const std::vector<int>& Index,
   */ 
 {
   for(size_t i=0;i<Index.size();i++)
-    Base[Index[i]]=(Tval[i]==1) ? 1 : 0;    
+    Base[Index[i]]=static_cast<int>((value >> i) & 1UL);
 
   return;
 }
@@ -393,24 +367,47 @@ BnId::setState(const std::vector<int>& Index,
     \param Base :: map to be used
   */ 
 {
-  std::map<int,int>::const_iterator mc;
-  Tnum=0;
-  Znum=0;
-  size=0;
-  for(size_t i=0;i<Index.size() && Tval.size();i++)
+  if (!size) return;
+
+  size=Index.size();
+  care=sizeMask(size);
+  value=0;
+  for(size_t i=0;i<size;i++)
     {
-      mc=Base.find(Index[i]);
-      Tval[i]=(mc->second) ? 1 : -1;
+      std::map<int,int>::const_iterator mc=Base.find(Index[i]);
+      if (mc==Base.end())
+	throw ColErr::InContainerError<int>(Index[i],"BnId::setState");
       if (mc->second)
-	Tnum++;
-      else
-	Znum++;
-      size++;
+	value|=1UL << i;
     }
+  setCounters();
   return;
 }
 
-
+int
+BnId::combine(const BnId& A,BnId& PIout) const
+  /*!
+    Find if A and this differ by one 1/-1 bit and
+    if so make PIout with a 0 value for that bit.
+    \param A :: value to check
+    \param PIout :: combined value [set if complement found]
+    \return 1 :: complement found / 0 otherwise
+  */
+{
+  if (size!=A.size || care!=A.care)
+    return 0;
+  // exactly one bit different
+  const unsigned long int diff(value ^ A.value);
+  if (!diff || (diff & (diff-1UL)))
+    return 0;
+  
+  PIout=*this;
+  PIout.care&= ~diff;
+  PIout.value&= ~diff;
+  PIout.setCounters();
+  PIout.addMinTerm(A);
+  return 1;
+}
 
 std::pair<int,BnId>
 BnId::makeCombination(const BnId& A) const
@@ -431,42 +428,13 @@ BnId::makeCombination(const BnId& A) const
     return std::pair<int,BnId>(-1,BnId());
 
   // Zero unequal or 1 value to far apart
-  if ((Tnum-A.Tnum)*(Tnum-A.Tnum)>1)
+  if (Tnum>A.Tnum+1 || A.Tnum>Tnum+1)
     return std::pair<int,BnId>(-1,BnId());
 
-  // no difference 
-  if (Tnum==A.Tnum)
-    return std::pair<int,BnId>(0,BnId());
-
-  int flag(0);         // numb of diff
-  std::pair<int,int> Tcnt(0,0);        // this counter 
-  std::pair<int,int> Acnt(0,0);        // A counter 
-  std::vector<int>::const_iterator tvc;
-  std::vector<int>::const_iterator avc=A.Tval.begin();
-  std::vector<int>::const_iterator chpt;   // change point
-  for(tvc=Tval.begin();tvc!=Tval.end();tvc++,avc++)
-    {
-      if ((*avc * *tvc)<0)       // false/true
-	{
-	  if (flag)           // failed
-	    return std::pair<int,BnId>(0,BnId());;
-	  flag=1;  //inc change counter
-	  chpt=tvc;
-	}
-      else if (*avc!= *tvc)       // failed on a 0 : value
-	return std::pair<int,BnId>(0,BnId());;
-    }
-  // Good value
-  if (flag)
-    {
-      BnId PIout(*this);
-      PIout.Tval[static_cast<size_t>(chpt-Tval.begin())]=0;
-      PIout.setCounters();
-      PIout.addMinTerm(A);
-      return std::pair<int,BnId>(1,PIout);
-    }
-  // Nothing to do.
-  return std::pair<int,BnId>(0,BnId());
+  std::pair<int,BnId> Out(0,BnId());
+  if (Tnum!=A.Tnum)
+    Out.first=combine(A,Out.second);
+  return Out;
 }
 
 void
@@ -476,8 +444,8 @@ BnId::reverse()
     Transform 1 -> -1
   */
 {
-  transform(Tval.begin(),Tval.end(),Tval.begin(),
-	    std::bind2nd(std::multiplies<int>(),-1));
+  value= ~value & care;
+  setCounters();
   return;
 }
 
@@ -490,13 +458,12 @@ BnId::display() const
    */
 {
   std::string Out;
-  std::vector<int>::const_reverse_iterator vc;
-  std::ostringstream cx;
-  for(vc=Tval.rbegin();vc!=Tval.rend();vc++)
+  for(size_t i=size;i>0;i--)
     {
-      if (*vc==0)
+      const unsigned long int bit(1UL << (i-1));
+      if (!(care & bit))
 	Out+="-";
-      else if (*vc==1)
+      else if (value & bit)
 	Out+="1";
       else
 	Out+="0";
@@ -504,12 +471,15 @@ BnId::display() const
 
   if (fullOut)
     {
+      std::ostringstream cx;
       cx<<"[";
-      copy(MinTerm.begin(),MinTerm.end(),
-	   std::ostream_iterator<int>(cx,","));
+      for(size_t i=0;i<MinTerm.size()*maxSize;i++)
+	if ((MinTerm[i/maxSize] >> (i % maxSize)) & 1UL)
+	  cx<<i<<",";
       cx<<"]("<<Tnum<<":"<<Znum<<")";
+      Out+=cx.str();
     }
-  return Out+cx.str();
+  return Out;
 }
 
 void
@@ -34,6 +34,7 @@
 #include <iterator>
 #include <numeric>
 #include <tuple>
+#include <mutex>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -54,13 +55,20 @@
 namespace ModelSupport
 {
 
-DBMaterial::DBMaterial() 
+namespace
+{
+  /// Serialises the first use build of materials [threads]
+  std::mutex storeLock;
+}
+
+DBMaterial::DBMaterial() :
+  endf7Flag(0)
   /*!
-    Constructor
+    Constructor : the built-in materials are
+    held unparsed until used
   */
 {
   initMaterial();
-  initMXUnits();
 }
 
 DBMaterial&
@@ -74,6 +82,27 @@ DBMaterial::Instance()
   return DObj;
 }
 
+void
+DBMaterial::reset()
+  /*!
+    Big reset : back to the unparsed built-in materials.
+    Not to be called while other threads use the data base.
+  */
+{
+  ELog::RegMethod RegA("DBMaterial","reset");
+
+  IndexMap.clear();
+  MStore.clear();
+  DStore.clear();
+  NStore.clear();
+  endf7Flag=0;
+  deactive.clear();
+  active.clear();
+  clearAttnTable();
+  initMaterial();
+  return;
+}
+
 void
 DBMaterial::checkNameIndex(const int MIndex,const std::string& MName) const
   /*!
@@ -83,7 +112,8 @@ DBMaterial::checkNameIndex(const int MIndex,const std::string& MName) const
     \param MName :: Material name
   */
 {
-  if ( MStore.find(MIndex)!=MStore.end() )
+  if ( MStore.find(MIndex)!=MStore.end() ||
+       DStore.find(MIndex)!=DStore.end() )
     throw ColErr::InContainerError<int>(MIndex,"MIndex");
   if ( IndexMap.find(MName)!=IndexMap.end() )
     throw ColErr::InContainerError<std::string>(MName,"MName");
@@ -98,9 +128,10 @@ DBMaterial::getFreeNumber() const
    */
 {
   ELog::RegMethod RegA("DBMaterial","getFreeNumber");
-  int FNum(static_cast<int>(MStore.size()));  
+  int FNum(static_cast<int>(MStore.size()+DStore.size()));  
   FNum++;               // Avoid possible zero
-  while(MStore.find(FNum)!=MStore.end())
+  while(MStore.find(FNum)!=MStore.end() ||
+	DStore.find(FNum)!=DStore.end())
     {
       FNum++;
     }
@@ -108,6 +139,75 @@ DBMaterial::getFreeNumber() const
   
 }
 
+void
+DBMaterial::clearAttnTable()
+  /*!
+    Remove the attenuation table [material changed]
+  */
+{
+  attnTable.clear();
+  meanATable.clear();
+  return;
+}
+
+void
+DBMaterial::buildAttnTable() const
+  /*!
+    Build the attenuation tables indexed by material number.
+    Numbers without a material have an attenuation of -1.0
+    and negative numbers [InValid] are not held.
+  */
+{
+  ELog::RegMethod RegA("DBMaterial","buildAttnTable");
+
+  // MStore is ordered so the last item is the largest
+  buildStore();
+  const int maxIndex=(MStore.empty()) ? 0 : MStore.rbegin()->first;
+  const size_t NSize(static_cast<size_t>(std::max(maxIndex,0))+1);
+  attnTable.assign(NSize,-1.0);
+  meanATable.assign(NSize,0.0);
+  for(const MTYPE::value_type& MT : MStore)
+    {
+      if (MT.first>=0)
+	{
+	  const size_t index(static_cast<size_t>(MT.first));
+	  const double AMean=MT.second.getMeanA();
+	  meanATable[index]=AMean;
+	  attnTable[index]=std::pow(AMean,0.66)*MT.second.getAtomDensity();
+	}
+    }
+  return;
+}
+
+const std::vector<double>&
+DBMaterial::getAttnTable() const
+  /*!
+    Get the energy independent attenuation coefficient
+    [density*A^0.66] of each material indexed by material
+    number. Built on first use after a material is set.
+    \return attenuation table [-1.0 for no material]
+  */
+{
+  std::lock_guard<std::mutex> lockGuard(storeLock);
+  if (attnTable.empty())
+    buildAttnTable();
+  return attnTable;
+}
+
+const std::vector<double>&
+DBMaterial::getMeanATable() const
+  /*!
+    Get the mean atomic mass of each material indexed
+    by material number.
+    \return mean A table
+  */
+{
+  std::lock_guard<std::mutex> lockGuard(storeLock);
+  if (meanATable.empty())
+    buildAttnTable();
+  return meanATable;
+}
+
 void
 DBMaterial::readFile(const std::string& FName)
   /*!
@@ -206,6 +306,94 @@ DBMaterial::overwriteMaterial(const std::string& original,
   return;
 }
   
+void
+DBMaterial::setMaterial(const matDef& MD)
+  /*!
+    Store an unparsed material in the data base
+    \param MD :: Material definition
+   */
+{
+  ELog::RegMethod RegA("DBMaterial","setMaterial(matDef)");
+
+  checkNameIndex(MD.index,MD.name);
+  DStore.emplace(MD.index,MD);
+  IndexMap.emplace(MD.name,MD.index);
+  return;
+}
+
+DBMaterial::MTYPE::iterator
+DBMaterial::findMaterial(const int MIndex) const
+  /*!
+    Find a material : thread safe as a material
+    may be built on first use
+    \param MIndex :: Material number
+    \return iterator / MStore.end() if not present
+   */
+{
+  std::lock_guard<std::mutex> lockGuard(storeLock);
+  return buildMaterial(MIndex);
+}
+
+DBMaterial::MTYPE::iterator
+DBMaterial::buildMaterial(const int MIndex) const
+  /*!
+    Find a material : an unparsed material is built and
+    given the modifications (MX/ENDF7/particle) already
+    applied to the built materials. The caller holds
+    the store lock.
+    \param MIndex :: Material number
+    \return iterator / MStore.end() if not present
+   */
+{
+  MTYPE::iterator mc=MStore.find(MIndex);
+  if (mc!=MStore.end())
+    return mc;
+
+  DTYPE::iterator dc=DStore.find(MIndex);
+  if (dc==DStore.end())
+    return MStore.end();
+
+  const matDef& MD=dc->second;
+  MonteCarlo::Material MObj;
+  MObj.setMaterial(MD.index,MD.name,MD.zaidLine,MD.mtLine,MD.libLine);
+  if (std::abs(MD.density)>0.0)
+    MObj.setDensity(MD.density);
+  initMXUnits(MObj);
+  if (endf7Flag)
+    MObj.setENDF7();
+  for(const std::string& P : deactive)
+    {
+      MObj.removeMX(P);
+      MObj.removeLib(P);
+    }
+  DStore.erase(dc);
+  return MStore.emplace(MIndex,MObj).first;
+}
+
+void
+DBMaterial::buildStore() const
+  /*!
+    Build all the unparsed materials. The caller 
+    holds the store lock.
+  */
+{
+  while(!DStore.empty())
+    buildMaterial(DStore.begin()->first);
+  return;
+}
+
+const DBMaterial::MTYPE&
+DBMaterial::getStore() const
+  /*!
+    Get the data store [builds all the unparsed materials]
+    \return material store
+  */
+{
+  std::lock_guard<std::mutex> lockGuard(storeLock);
+  buildStore();
+  return MStore;
+}
+
 void
 DBMaterial::setMaterial(const MonteCarlo::Material& MO)
   /*!
@@ -220,6 +408,7 @@ DBMaterial::setMaterial(const MonteCarlo::Material& MO)
   checkNameIndex(MIndex,MName);
   MStore.insert(MTYPE::value_type(MIndex,MO));
   IndexMap.insert(SCTYPE::value_type(MName,MIndex));
+  clearAttnTable();
   return;
 }
   
@@ -425,7 +614,7 @@ DBMaterial::removeThermal(const std::string& matName)
     throw ColErr::InContainerError<std::string>
       (matName,"No material available");
 
-  MTYPE::iterator mc=MStore.find(mIc->second);
+  MTYPE::iterator mc=findMaterial(mIc->second);
   mc->second.removeSQW();
   return;
 }
@@ -443,28 +632,30 @@ DBMaterial::resetMaterial(const MonteCarlo::Material& MO)
   const std::string& MName=MO.getName();
   const int MIndex=MO.getNumber();
 
-  MTYPE::iterator mc=MStore.find(MIndex);
-  if (mc!=MStore.end()) MStore.erase(mc);
+  MStore.erase(MIndex);
+  DStore.erase(MIndex);
   SCTYPE::iterator sc=IndexMap.find(MName);
   if (sc!=IndexMap.end()) IndexMap.erase(sc);
 
   MStore.insert(MTYPE::value_type(MIndex,MO));
   IndexMap.insert(SCTYPE::value_type(MName,MIndex));
+  clearAttnTable();
   return;
 }
 
 
 void
-DBMaterial::initMXUnits()
+DBMaterial::initMXUnits(MonteCarlo::Material& MObj)
   /*!
-    Initialize the MX options
+    Initialize the MX options of a built-in material
+    \param MObj :: Material to set
   */
 {
   ELog::RegMethod RegA("DBMaterial","initMXUnits");
 
   typedef std::tuple<size_t,size_t,char,std::string,
 		     std::string> MXTYPE;
-  std::vector<MXTYPE> mxVec=
+  static const std::vector<MXTYPE> mxVec=
     {
       MXTYPE(6000,70,'c',"h","6012.70h"),
       MXTYPE(4009,24,'c',"h","model"),
@@ -486,13 +677,9 @@ DBMaterial::initMXUnits()
   //  mxVec.push_back(MXTYPE(6000,70,'c',"u","6012.70u"));
   
   for(const MXTYPE& vc : mxVec)
-    {
-      MTYPE::iterator mc;  
-      for(mc=MStore.begin();mc!=MStore.end();mc++)
-	mc->second.setMXitem(std::get<0>(vc),std::get<1>(vc),
-			     std::get<2>(vc),std::get<3>(vc),
-			     std::get<4>(vc));
-    }
+    MObj.setMXitem(std::get<0>(vc),std::get<1>(vc),
+		   std::get<2>(vc),std::get<3>(vc),
+		   std::get<4>(vc));
   return;
 }
 
@@ -506,7 +693,7 @@ DBMaterial::getMaterial(const int MIndex) const
 {
   ELog::RegMethod RegA("DBMaterial","getMaterial<int>");
 
-  MTYPE::const_iterator mc=MStore.find(MIndex);
+  MTYPE::const_iterator mc=findMaterial(MIndex);
   if (mc==MStore.end())
     throw ColErr::InContainerError<int>(MIndex,"MIndex in MStore");
   return mc->second;
@@ -551,9 +738,10 @@ DBMaterial::hasKey(const int KeyNum) const
   */
 {
   ELog::RegMethod RegA("DBMaterial","hasKey<int>");
-  
-  MTYPE::const_iterator mc=MStore.find(KeyNum);
-  return (mc==MStore.end()) ? 0 : 1;
+
+  std::lock_guard<std::mutex> lockGuard(storeLock);
+  return (MStore.find(KeyNum)==MStore.end() &&
+	  DStore.find(KeyNum)==DStore.end()) ? 0 : 1;
 }
 
 const std::string&
@@ -566,7 +754,7 @@ DBMaterial::getKey(const int KeyNum) const
 {
   ELog::RegMethod RegA("DBMaterial","getKey");
   
-  MTYPE::const_iterator mc=MStore.find(KeyNum);
+  MTYPE::const_iterator mc=findMaterial(KeyNum);
   if (mc==MStore.end())
     throw ColErr::InContainerError<int>(KeyNum,"KeyNum");
   
@@ -666,6 +854,8 @@ DBMaterial::setENDF7()
   MTYPE::iterator mc;
   for(mc=MStore.begin();mc!=MStore.end();mc++)
     mc->second.setENDF7();
+  // unparsed materials are converted when built
+  endf7Flag=1;
   return;
 }
 
@@ -686,7 +876,7 @@ DBMaterial::writeCinder(std::ostream& OX) const
     {
       if (*sc)
 	{
-	  MTYPE::const_iterator mx=MStore.find(*sc);
+	  MTYPE::const_iterator mx=findMaterial(*sc);
 	  if (mx==MStore.end())
 	    throw ColErr::InContainerError<int>(*sc,"MStore");	  
 	  mx->second.writeCinder(OX);
@@ -713,6 +903,7 @@ DBMaterial::deactivateParticle(const std::string& P)
           MT.second.removeMX(P);
           MT.second.removeLib(P);
         }
+      deactive.insert(P);
     }
 
   return;
@@ -732,7 +923,7 @@ DBMaterial::writeMCNPX(std::ostream& OX) const
     {
       if (sActive)
 	{
-	  MTYPE::const_iterator mp=MStore.find(sActive);
+	  MTYPE::const_iterator mp=findMaterial(sActive);
 	  if (mp==MStore.end())
 	    throw ColErr::InContainerError<int>(sActive,"MStore find(active item)");
 	  mp->second.write(OX);
@@ -755,7 +946,7 @@ DBMaterial::writePHITS(std::ostream& OX) const
     {
       if (sActive)
 	{
-	  MTYPE::const_iterator mp=MStore.find(sActive);
+	  MTYPE::const_iterator mp=findMaterial(sActive);
 	  if (mp==MStore.end())
 	    throw ColErr::InContainerError<int>
               (sActive,"MStore find(active item)");
@@ -779,7 +970,7 @@ DBMaterial::writeFLUKA(std::ostream& OX) const
     {
       if (sActive)
 	{
-	  MTYPE::const_iterator mp=MStore.find(sActive);
+	  MTYPE::const_iterator mp=findMaterial(sActive);
 	  if (mp==MStore.end())
 	    throw ColErr::InContainerError<int>(sActive,"MStore find(active item)");
 	  
@@ -802,7 +993,7 @@ DBMaterial::writePOVRay(std::ostream& OX) const
     {
       if (sActive)
 	{
-	  MTYPE::const_iterator mp=MStore.find(sActive);
+	  MTYPE::const_iterator mp=findMaterial(sActive);
 	  if (mp==MStore.end())
 	    throw ColErr::InContainerError<int>
 	      (sActive,"MStore find(active item)");
@@ -1448,7 +1448,7 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
     \returns number of substitutions
   */
 {
-  ELog::RegMethod RegA("HeadRule","substitueSurf");
+  ELog::RegMethod RegA("HeadRule","substituteSurf");
 
   // Quick check:
   if (SurfN==newSurfN) return 0;
@@ -1465,6 +1465,50 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
   return cnt;
 }
 
+int
+HeadRule::substituteSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the rule in a single pass.
+    Each surface is changed once so RMap can be a 
+    permutation [e.g. a->b and b->a]. The surface pointers
+    are kept [the surfaces are renamed not replaced].
+    \param RMap :: Map of old surface number : new number [+ve]
+    \returns number of substitutions
+  */
+{
+  ELog::RegMethod RegA("HeadRule","substituteSurf");
+
+  if (!HeadNode || RMap.empty()) return 0;
+
+  int cnt(0);
+  std::stack<Rule*> TreeLine;
+  TreeLine.push(HeadNode);
+  while(!TreeLine.empty())
+    {
+      Rule* RPtr=TreeLine.top();
+      TreeLine.pop();
+      SurfPoint* SP=dynamic_cast<SurfPoint*>(RPtr);
+      if (SP)
+	{
+	  std::map<int,int>::const_iterator mc=RMap.find(SP->getKeyN());
+	  if (mc!=RMap.end() && mc->first!=mc->second)
+	    {
+	      SP->setKeyN(SP->getSign()*mc->second);
+	      cnt++;
+	    }
+	}
+      else
+	{
+	  // complement groups have the same leaf for 0/1
+	  if (RPtr->leaf(0))
+	    TreeLine.push(RPtr->leaf(0));
+	  if (RPtr->type() && RPtr->leaf(1))
+	    TreeLine.push(RPtr->leaf(1));
+	}
+    }
+  return cnt;
+}
+
 void
 HeadRule::makeComplement()
   /*!
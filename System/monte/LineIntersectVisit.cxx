@@ -63,6 +63,7 @@
 #include "General.h"
 #include "Torus.h"
 #include "Line.h"
+#include "LineKernel.h"
 #include "SurInter.h"
 #include "neutron.h"
 #include "Rules.h"
@@ -161,8 +162,10 @@ LineIntersectVisit::Accept(const Geometry::Plane& Surf)
     \param Surf :: Surface to use int line Interesect
   */
 {
-  ATrack.intersect(PtOut,Surf);
-  procTrack(&Surf);
+  double L[2];
+  const size_t nL=LineKernel::planeRoots(Surf,ATrack.getOrigin(),
+					ATrack.getDirect(),L);
+  procRoots(&Surf,nL,L);
   return;
 }
 
@@ -185,8 +188,10 @@ LineIntersectVisit::Accept(const Geometry::Cone& Surf)
     \param Surf :: Surface to use in the line Interesect
   */
 {
-  ATrack.intersect(PtOut,Surf);
-  procTrack(&Surf);
+  double L[2];
+  const size_t nL=LineKernel::coneRoots(Surf,ATrack.getOrigin(),
+					ATrack.getDirect(),L);
+  procRoots(&Surf,nL,L);
   return;
 }
 
@@ -209,8 +214,10 @@ LineIntersectVisit::Accept(const Geometry::Cylinder& Surf)
     \param Surf :: Surface to use int line Interesect
   */
 {
-  ATrack.intersect(PtOut,Surf);
-  procTrack(&Surf);
+  double L[2];
+  const size_t nL=LineKernel::cylinderRoots(Surf,ATrack.getOrigin(),
+					ATrack.getDirect(),L);
+  procRoots(&Surf,nL,L);
   return;
 }
 
@@ -233,8 +240,10 @@ LineIntersectVisit::Accept(const Geometry::Sphere& Surf)
     \param Surf :: Surface to use int line Interesect
   */
 {
-  ATrack.intersect(PtOut,Surf);
-  procTrack(&Surf);
+  double L[2];
+  const size_t nL=LineKernel::sphereRoots(Surf,ATrack.getOrigin(),
+					ATrack.getDirect(),L);
+  procRoots(&Surf,nL,L);
   return;
 }
 
@@ -273,6 +282,45 @@ LineIntersectVisit::Accept(const Geometry::Torus&)
   return;
 }
 
+void
+LineIntersectVisit::Accept(const LineKernel::surfBatch& SB,
+			   const std::vector<const Geometry::Surface*>& SList)
+  /*!
+    Process an intersect track with all the surfaces of a
+    batch. The points are added in surface order [as
+    calling Accept on each surface of SList].
+    \param SB :: Batch of surfaces
+    \param SList :: Surface of each batch index
+  */
+{
+  batchL.clear();
+  batchI.clear();
+  const size_t nRoot=
+    SB.intersect(ATrack.getOrigin(),ATrack.getDirect(),batchL,batchI);
+
+  // the roots of a surface are together and in order :
+  // stable counting sort on the surface index
+  batchOrder.assign(SList.size()+1,0);
+  for(const size_t index : batchI)
+    batchOrder[index+1]++;
+  for(size_t i=1;i<batchOrder.size();i++)
+    batchOrder[i]+=batchOrder[i-1];
+
+  const size_t offset(DOut.size());
+  PtOut.resize(offset+nRoot);
+  DOut.resize(offset+nRoot);
+  SurfIndex.resize(offset+nRoot);
+  for(size_t i=0;i<nRoot;i++)
+    {
+      const size_t index(batchI[i]);
+      const size_t outI(offset+batchOrder[index]++);
+      PtOut[outI]=ATrack.getPoint(batchL[i]);
+      DOut[outI]=batchL[i];
+      SurfIndex[outI]=SList[index];
+    }
+  return;
+}
+
 void
 LineIntersectVisit::procTrack(const Geometry::Surface* surfID) 
   /*!
@@ -294,6 +342,25 @@ LineIntersectVisit::procTrack(const Geometry::Surface* surfID)
   return;
 }
 
+void
+LineIntersectVisit::procRoots(const Geometry::Surface* surfID,
+			      const size_t nL,const double* L)
+  /*!
+    Add the points from a kernel intersection
+    \param surfID :: surface ID
+    \param nL :: Number of roots
+    \param L :: Line parameters of the roots
+  */
+{
+  for(size_t i=0;i<nL;i++)
+    {
+      PtOut.push_back(ATrack.getPoint(L[i]));
+      DOut.push_back(L[i]);
+      SurfIndex.push_back(surfID);
+    }
+  return;
+}
+
 // ACCESSORS:
 double
 LineIntersectVisit::getDist(const Geometry::Surface* SPtr) 
@@ -49,14 +49,18 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Track.h"
 #include "Line.h"
+#include "LineKernel.h"
 #include "LineIntersectVisit.h"
 #include "Surface.h"
 #include "surfIndex.h"
 #include "surfImplicates.h"
 #include "Rules.h"
 #include "HeadRule.h"
+#include "RuleBox.h"
+#include "RuleProgram.h"
 #include "Token.h"
 #include "neutron.h"
 #include "objectRegister.h"
@@ -170,7 +174,8 @@ Object::startLine(const std::string& Line)
 Object::Object() :
   ObjName(0),listNum(-1),Tmp(300),MatN(-1),trcl(0),
   imp(1),density(0.0),placehold(0),populated(0),
-  activeMag(0),objSurfValid(0)
+  activeMag(0),boxPtr(0),progPtr(0),batchPtr(0),
+  objSurfValid(0)
    /*!
      Defaut constuctor, set temperature to 300C and material to vacuum
    */
@@ -180,7 +185,8 @@ Object::Object(const int N,const int M,
 	       const double T,const std::string& Line) :
   ObjName(N),listNum(-1),Tmp(T),MatN(M),trcl(0),
   imp(1),density(0.0),placehold(0),
-  populated(0),activeMag(0),objSurfValid(0)
+  populated(0),activeMag(0),boxPtr(0),progPtr(0),batchPtr(0),
+  objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -196,7 +202,8 @@ Object::Object(const std::string& FCName,const int N,const int M,
 	       const double T,const std::string& Line) :
   FCUnit(FCName),ObjName(N),listNum(-1),Tmp(T),MatN(M),trcl(0),
   imp(1),density(0.0),placehold(0),
-  populated(0),activeMag(0),objSurfValid(0)
+  populated(0),activeMag(0),boxPtr(0),progPtr(0),batchPtr(0),
+  objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -214,7 +221,11 @@ Object::Object(const Object& A) :
   trcl(A.trcl),imp(A.imp),
   density(A.density),placehold(A.placehold),populated(A.populated),
   activeMag(A.activeMag),magVec(A.magVec),
-  HRule(A.HRule),objSurfValid(0),SurList(A.SurList),SurSet(A.SurSet)
+  HRule(A.HRule),boxPtr(0),
+  progPtr((A.progPtr) ? new RuleProgram(*A.progPtr) : 0),
+  batchPtr((A.batchPtr) ? new LineKernel::surfBatch(*A.batchPtr) : 0),
+  objSurfValid(0),
+  SurList(A.SurList),SurSet(A.SurSet)
   /*!
     Copy constructor
     \param A :: Object to copy
@@ -244,9 +255,14 @@ Object::operator=(const Object& A)
       activeMag=A.activeMag;
       magVec=A.magVec;
       HRule=A.HRule;
+      clearBoundBox();
+      delete progPtr;
+      progPtr=(A.progPtr) ? new RuleProgram(*A.progPtr) : 0;
       objSurfValid=0;
       SurList=A.SurList;
       SurSet=A.SurSet;
+      delete batchPtr;
+      batchPtr=(A.batchPtr) ? new LineKernel::surfBatch(*A.batchPtr) : 0;
     }
   return *this;
 }
@@ -255,7 +271,11 @@ Object::~Object()
   /*!
     Delete operator : removes Object tree
   */
-{}
+{
+  delete boxPtr;
+  delete progPtr;
+  delete batchPtr;
+}
 
 Object*
 Object::clone() const 
@@ -315,6 +335,8 @@ Object::complementaryObject(const int Cnum,std::string& Ln)
 
   SurList.clear();
   SurSet.erase(SurSet.begin(),SurSet.end());
+  clearBoundBox();
+  compileRule();
   Ln.erase(posA-1,posB+1);  //Delete brackets ( Part ) .
   std::ostringstream CompCell;
   CompCell<<Cnum<<" ";
@@ -413,6 +435,8 @@ Object::setObject(std::string Ln)
     {
       SurList.clear();
       SurSet.erase(SurSet.begin(),SurSet.end());
+      clearBoundBox();
+      compileRule();
       objSurfValid=0;
       return 1;
     }
@@ -432,6 +456,8 @@ Object::procString(const std::string& cellStr)
 {
   populated=0;
   objSurfValid=0;
+  clearBoundBox();
+  compileRule();
   return HRule.procString(cellStr);
 }
 
@@ -444,6 +470,8 @@ Object::procHeadRule(const HeadRule& cellRule)
    */
 {
   populated=0;
+  clearBoundBox();
+  compileRule();
   HRule=cellRule;
   return 1;
 }
@@ -475,6 +503,8 @@ Object::setObject(const int N,const int matNum,
     {
       SurList.clear();
       SurSet.erase(SurSet.begin(),SurSet.end());
+      clearBoundBox();
+      compileRule();
       objSurfValid=0;
       return 1;
     }
@@ -497,7 +527,83 @@ Object::populate()
   if (!populated) 
     {
       HRule.populateSurf();
+      clearBoundBox();
       populated=1;
+      compileRule();
+    }
+  return;
+}
+
+const Geometry::BoundBox&
+Object::getBoundBox() const
+  /*!
+    Get the conservative axis aligned box of the object.
+    Calculated on first use from the rule tree and cached
+    until the rule/surfaces are changed.
+    \return bounding box [infinite if unbounded]
+  */
+{
+  if (!boxPtr)
+    {
+      boxPtr=new Geometry::BoundBox(RuleBox::ruleBox(HRule.getTopRule()));
+      boxPtr->grow(Geometry::shiftTol);
+    }
+  return *boxPtr;
+}
+
+void
+Object::clearBoundBox()
+  /*!
+    Remove the cached bounding box and rebuild the
+    kernel batch [e.g. surfaces moved]
+  */
+{
+  delete boxPtr;
+  boxPtr=0;
+  createSurfBatch();
+  return;
+}
+
+void
+Object::createSurfBatch()
+  /*!
+    Build the kernel batch of SurList used by trackCell.
+    No batch is held if a surface has no kernel.
+  */
+{
+  delete batchPtr;
+  batchPtr=0;
+  if (SurList.empty()) return;
+
+  LineKernel::surfBatch* SB=new LineKernel::surfBatch();
+  for(const Geometry::Surface* SPtr : SurList)
+    if (!SB->addSurface(SPtr))
+      {
+	delete SB;
+	return;
+      }
+  batchPtr=SB;
+  return;
+}
+
+void
+Object::compileRule()
+  /*!
+    Rebuild the compiled form of HRule used by isValid.
+    Only a populated rule is compiled, otherwise (or if
+    the rule has object components) isValid uses the tree.
+  */
+{
+  delete progPtr;
+  progPtr=0;
+  if (populated)
+    {
+      progPtr=new RuleProgram();
+      if (!progPtr->compile(HRule.getTopRule()))
+	{
+	  delete progPtr;
+	  progPtr=0;
+	}
     }
   return;
 }
@@ -514,7 +620,9 @@ Object::rePopulate()
 {
   ELog::RegMethod RegA("Object","rePopulate");
   HRule.populateSurf();
+  clearBoundBox();
   populated=1;
+  compileRule();
   return;
 }
 
@@ -539,9 +647,51 @@ Object::addSurfString(const std::string& XE)
   Tmp=Temp;      
   populated=0;
   objSurfValid=0;
+  clearBoundBox();
+  compileRule();
   return flag;
 }
 
+int
+Object::addIntersection(const HeadRule& AHead)
+  /*!
+    Intersect the cell with a rule. The rule tree is
+    copied directly so no string is written or parsed.
+    If the object is populated the new surfaces are
+    populated and added to the surface list.
+    \param AHead :: Rule to add
+    \return 1 on success
+  */
+{
+  ELog::RegMethod RegA("Object","addIntersection");
+
+  if (!AHead.hasRule()) return 1;
+
+  HeadRule ARule(AHead);
+  if (populated)
+    ARule.populateSurf();
+  HRule.addIntersection(ARule);
+
+  if (populated && !SurList.empty())
+    {
+      std::ostringstream debugCX;
+      addSurfaceList(ARule.getTopRule(),debugCX);
+      std::sort(SurList.begin(),SurList.end());
+      SurList.erase(std::unique(SurList.begin(),SurList.end()),
+		    SurList.end());
+      createLogicOpp();
+    }
+  else
+    {
+      SurList.clear();
+      SurSet.erase(SurSet.begin(),SurSet.end());
+    }
+  objSurfValid=0;
+  clearBoundBox();
+  compileRule();
+  return 1;
+}
+
 void
 Object::setMagField(const Geometry::Vec3D& M)
   /*!
@@ -664,7 +814,7 @@ Object::isValid(const Geometry::Vec3D& Pt) const
   \returns 1 if true and 0 if false
 */
 {
-  return HRule.isValid(Pt);
+  return (progPtr) ? progPtr->isValid(Pt) : HRule.isValid(Pt);
 }
 
 int
@@ -826,24 +976,17 @@ Object::pairValid(const int SN,const Geometry::Vec3D& Pt) const
   return HRule.pairValid(SN,Pt);
 }
 
-int
-Object::createSurfaceList()
+void
+Object::addSurfaceList(const Rule* RPtr,std::ostream& debugCX)
   /*! 
-    Uses the topRule* to create a surface list
-    by iterating throught the tree.    
-    \return 1 (should be number of surfaces)
+    Add the surfaces of a rule tree to SurList/SurSet.
+    SurList is not sorted.
+    \param RPtr :: Top rule to add
+    \param debugCX :: Stream for surfaces without a key
   */
 { 
-  ELog::RegMethod RegA("Object","createSurfaceList");
-  
-  populate();  // checked in populate
-  std::ostringstream debugCX;
-
-  SurList.clear();
-  SurSet.erase(SurSet.begin(),SurSet.end());
-
   std::stack<const Rule*> TreeLine;
-  TreeLine.push(HRule.getTopRule());
+  TreeLine.push(RPtr);
   while(!TreeLine.empty())
     {
       const Rule* tmpA=TreeLine.top();
@@ -872,6 +1015,26 @@ Object::createSurfaceList()
 	    }
 	}
     }
+  return;
+}
+
+int
+Object::createSurfaceList()
+  /*! 
+    Uses the topRule* to create a surface list
+    by iterating throught the tree.    
+    \return 1 (should be number of surfaces)
+  */
+{ 
+  ELog::RegMethod RegA("Object","createSurfaceList");
+  
+  populate();  // checked in populate
+  std::ostringstream debugCX;
+
+  SurList.clear();
+  SurSet.erase(SurSet.begin(),SurSet.end());
+  addSurfaceList(HRule.getTopRule(),debugCX);
+
   sort(SurList.begin(),SurList.end());
   
   std::vector<const Geometry::Surface*>::iterator sc=
@@ -892,6 +1055,7 @@ Object::createSurfaceList()
     }
 
   createLogicOpp();
+  createSurfBatch();
   return 1;
 }
 
@@ -963,6 +1127,8 @@ Object::removeSurface(const int SurfN)
   const int cnt=HRule.removeItems(SurfN);
   if (cnt>0)
     {
+      clearBoundBox();
+      compileRule();
       createSurfaceList();
       objSurfValid=0;
     }
@@ -990,6 +1156,30 @@ Object::substituteSurf(const int SurfN,const int NsurfN,
   if ( out )
     {
       populated=0;
+      clearBoundBox();
+      populate();
+      createSurfaceList();
+    }
+  return out;
+}
+
+int
+Object::substituteSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber the surfaces in the cell from a map
+    and re-build the cell. The surfaces must already
+    be renumbered in the surfIndex.
+    \param RMap :: Map of old surface number : new number
+    \return number of surfaces substituted
+  */
+{ 
+  ELog::RegMethod RegA("Object","substituteSurf");
+
+  const int out=HRule.substituteSurf(RMap);
+  if ( out )
+    {
+      populated=0;
+      clearBoundBox();
       populate();
       createSurfaceList();
     }
@@ -1142,9 +1332,18 @@ Object::trackCell(const MonteCarlo::neutron& N,double& D,
 {
   ELog::RegMethod RegA("Object","trackCell[D,dir]");
 
-  MonteCarlo::LineIntersectVisit LI(N);
-  for(const Geometry::Surface* isptr : SurList)
-    isptr->acceptVisitor(LI);
+  // scratch space : reused so no allocation once grown
+  static thread_local MonteCarlo::LineIntersectVisit
+    LI(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0));
+  static thread_local std::vector<size_t> Order;
+
+  LI.setLine(N);
+  LI.clearTrack();
+  if (batchPtr)
+    LI.Accept(*batchPtr,SurList);
+  else
+    for(const Geometry::Surface* isptr : SurList)
+      isptr->acceptVisitor(LI);
 
   const std::vector<Geometry::Vec3D>& IPts(LI.getPoints());
   const std::vector<double>& dPts(LI.getDistance());
@@ -1153,32 +1352,35 @@ Object::trackCell(const MonteCarlo::neutron& N,double& D,
   D=1e38;
   surfPtr=0;
   int touchUnit(0);
+  int bestPairValid(0);
   // NOTE: we only check for and exiting surface by going
   // along the line.
-  int bestPairValid(0);
-  for(size_t i=0;i<dPts.size();i++)
+  if (direction<0)
     {
-      // Is point possible closer
-      if ( ( surfIndex[i]->getName()!=startSurf || 
-	     dPts[i]>10.0*Geometry::zeroTol) &&
-	   (dPts[i]>0.0 && dPts[i]<D) )
+      // forward points in increasing distance [ties : surface order]
+      Order.clear();
+      for(size_t i=0;i<dPts.size();i++)
+	if ( ( surfIndex[i]->getName()!=startSurf || 
+	       dPts[i]>10.0*Geometry::zeroTol) && dPts[i]>0.0)
+	  Order.push_back(i);
+      std::sort(Order.begin(),Order.end(),
+		[&dPts](const size_t A,const size_t B)
+		{ return (dPts[A]<dPts[B]) || (dPts[A]==dPts[B] && A<B); });
+
+      // first out going surface beyond the touch distance is the exit
+      for(const size_t i : Order)
 	{
 	  const int NS=surfIndex[i]->getName();	    // NOT SIGNED
-	  const int pAB=isDirectionValid(IPts[i],NS);
-	  const int mAB=isDirectionValid(IPts[i],-NS);
-	  const int normD=surfIndex[i]->sideDirection(IPts[i],N.uVec);
-          
-	  if (direction<0)
+	  if (isDirectionValid(IPts[i],NS)!=isDirectionValid(IPts[i],-NS))
 	    {
-	      if (pAB!=mAB)  // out going positive surface
+	      bestPairValid=surfIndex[i]->sideDirection(IPts[i],N.uVec);
+	      surfPtr=surfIndex[i];
+	      if (dPts[i]>Geometry::zeroTol)
 		{
-		  bestPairValid=normD;
-		  if (dPts[i]>Geometry::zeroTol)
-		    D=dPts[i];
-		  else
-		    touchUnit=1;
-		  surfPtr=surfIndex[i];
+		  D=dPts[i];
+		  break;
 		}
+	      touchUnit=1;
 	    }
 	}
     }
@@ -1265,6 +1467,8 @@ Object::makeComplement()
    */
 {
   HRule.makeComplement();
+  clearBoundBox();
+  compileRule();
   return;
 }
 
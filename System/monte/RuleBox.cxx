@@ -0,0 +1,302 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleBox.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <stack>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "Sphere.h"
+#include "Cylinder.h"
+#include "Rules.h"
+#include "RuleBox.h"
+
+namespace RuleBox
+{
+
+size_t
+axisIndex(const Geometry::Vec3D& N)
+  /*!
+    Determine if a unit normal is exactly along an axis.
+    Nearly aligned planes are not accepted [unlike
+    Plane::planeType] since clipping at their distance
+    is out by |N_off-axis| x extent.
+    \param N :: Unit normal
+    \return axis index [0-2] or 3 if not an axis
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (std::abs(N[(i+1) % 3])<axisTol &&
+	std::abs(N[(i+2) % 3])<axisTol)
+      return i;
+  return 3;
+}
+
+Geometry::BoundBox
+surfBox(const Geometry::Surface* SPtr,const int sign)
+  /*!
+    Calculate a conservative box for the half space
+    of a surface.
+    \param SPtr :: Surface
+    \param sign :: side of the surface that is valid
+    \return box containing the half space
+  */
+{
+  Geometry::BoundBox Out;
+  if (!SPtr) return Out;
+
+  const Geometry::Plane* PPtr=
+    dynamic_cast<const Geometry::Plane*>(SPtr);
+  if (PPtr)
+    {
+      // valid region : sign*(N.x-D) >= 0
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      const size_t i=axisIndex(N);
+      if (i<3)
+	{
+	  const double D=PPtr->getDistance()/N[i];
+	  if (N[i]*sign>0)
+	    Out.clipLow(i,D);
+	  else
+	    Out.clipHigh(i,D);
+	}
+      return Out;
+    }
+
+  // Only the inside of closed quadratics is bounded
+  if (sign>0) return Out;
+
+  const Geometry::Sphere* SpherePtr=
+    dynamic_cast<const Geometry::Sphere*>(SPtr);
+  if (SpherePtr)
+    {
+      const Geometry::Vec3D& C=SpherePtr->getCentre();
+      const double R=SpherePtr->getRadius();
+      return Geometry::BoundBox(C-Geometry::Vec3D(R,R,R),
+				C+Geometry::Vec3D(R,R,R));
+    }
+
+  const Geometry::Cylinder* CylPtr=
+    dynamic_cast<const Geometry::Cylinder*>(SPtr);
+  if (CylPtr)
+    {
+      // bounded only perpendicular to the axis
+      const Geometry::Vec3D& C=CylPtr->getCentre();
+      const Geometry::Vec3D& N=CylPtr->getNormal();
+      const double R=CylPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	{
+	  if (std::abs(N[i])<axisTol)
+	    {
+	      Out.clipLow(i,C[i]-R);
+	      Out.clipHigh(i,C[i]+R);
+	    }
+	}
+    }
+  return Out;
+}
+
+Geometry::BoundBox
+planeBox(const std::vector<Geometry::Vec3D>& NVec,
+	 const std::vector<double>& DVec,
+	 const Geometry::BoundBox& ABox)
+  /*!
+    Calculate the box of the convex polyhedron
+    N.x <= D for all planes and within ABox.
+    The finite faces of ABox are added as planes. If the
+    polyhedron is bounded the box of its vertices is returned
+    [intersected with ABox], otherwise ABox.
+    \param NVec :: Unit normals [outward]
+    \param DVec :: Distances
+    \param ABox :: Current box
+    \return Box of polyhedron
+  */
+{
+  std::vector<Geometry::Vec3D> N(NVec);
+  std::vector<double> D(DVec);
+  for(size_t i=0;i<3;i++)
+    {
+      Geometry::Vec3D Axis;
+      Axis[i]=1.0;
+      if (!std::isinf(ABox.high(i)))
+	{
+	  N.push_back(Axis);
+	  D.push_back(ABox.high(i));
+	}
+      if (!std::isinf(ABox.low(i)))
+	{
+	  N.push_back(-Axis);
+	  D.push_back(-ABox.low(i));
+	}
+    }
+  const size_t NP(N.size());
+  if (NP<4 || NP>maxVertexPlanes)
+    return ABox;
+
+  // Bounded test : no recession direction d with N.d <= 0.
+  // Extreme rays of the cone lie along N_i x N_j
+  const double rayTol(1e-10);
+  int fullRank(0);
+  for(size_t i=0;i<NP && !fullRank;i++)
+    for(size_t j=i+1;j<NP && !fullRank;j++)
+      {
+	const Geometry::Vec3D C=N[i]*N[j];
+	for(size_t k=j+1;k<NP && !fullRank;k++)
+	  if (std::abs(C.dotProd(N[k]))>rayTol)
+	    fullRank=1;
+      }
+  if (!fullRank) return ABox;
+
+  for(size_t i=0;i<NP;i++)
+    for(size_t j=i+1;j<NP;j++)
+      {
+	const Geometry::Vec3D C=N[i]*N[j];
+	const double CA=C.abs();
+	if (CA<rayTol) continue;
+	int posFlag(1);
+	int negFlag(1);
+	for(size_t k=0;k<NP && (posFlag || negFlag);k++)
+	  {
+	    const double CN=C.dotProd(N[k]);
+	    if (CN>rayTol*CA) posFlag=0;
+	    if (-CN>rayTol*CA) negFlag=0;
+	  }
+	if (posFlag || negFlag)
+	  return ABox;
+      }
+
+  // Vertices of three planes [Cramer]
+  const double vTol(1e-6);
+  Geometry::BoundBox VBox(Geometry::BoundBox::emptyBox());
+  for(size_t i=0;i<NP;i++)
+    for(size_t j=i+1;j<NP;j++)
+      {
+	const Geometry::Vec3D CIJ=N[i]*N[j];
+	for(size_t k=j+1;k<NP;k++)
+	  {
+	    const double det=CIJ.dotProd(N[k]);
+	    if (std::abs(det)<rayTol) continue;
+	    const Geometry::Vec3D Pt=
+	      ((N[j]*N[k])*D[i]+(N[k]*N[i])*D[j]+CIJ*D[k])/det;
+	    size_t m;
+	    for(m=0;m<NP && N[m].dotProd(Pt)<=D[m]+vTol;m++) ;
+	    if (m==NP)
+	      VBox.addPoint(Pt);
+	  }
+      }
+  if (VBox.isEmpty())
+    return ABox;
+
+  VBox&=ABox;
+  return VBox;
+}
+
+Geometry::BoundBox
+ruleBox(const Rule* RPtr)
+  /*!
+    Calculate a conservative box for a rule tree.
+    \param RPtr :: Rule to process
+    \return Box [infinite if unknown]
+  */
+{
+  if (!RPtr) return Geometry::BoundBox();
+
+  const int T=RPtr->type();
+  if (T==-1)
+    {
+      Geometry::BoundBox Out=ruleBox(RPtr->leaf(0));
+      Out|=ruleBox(RPtr->leaf(1));
+      return Out;
+    }
+  if (T==1)
+    {
+      // flatten the intersection chain
+      Geometry::BoundBox Out;
+      std::vector<Geometry::Vec3D> NVec;
+      std::vector<double> DVec;
+      int generalPlane(0);
+
+      std::stack<const Rule*> RStack;
+      RStack.push(RPtr);
+      while(!RStack.empty())
+	{
+	  const Rule* R=RStack.top();
+	  RStack.pop();
+	  if (!R) continue;
+	  if (R->type()==1)
+	    {
+	      RStack.push(R->leaf(0));
+	      RStack.push(R->leaf(1));
+	      continue;
+	    }
+	  const SurfPoint* SP=dynamic_cast<const SurfPoint*>(R);
+	  const Geometry::Plane* PPtr=(SP) ?
+	    dynamic_cast<const Geometry::Plane*>(SP->getKey()) : 0;
+	  if (PPtr)
+	    {
+	      // valid side : sign*(N.x-D)>=0 => -sign N.x <= -sign D
+	      const double S(SP->getSign());
+	      NVec.push_back(PPtr->getNormal()*(-S));
+	      DVec.push_back(-S*PPtr->getDistance());
+	      if (axisIndex(PPtr->getNormal())>2) generalPlane=1;
+	      Out&=surfBox(PPtr,SP->getSign());
+	    }
+	  else if (SP)
+	    Out&=surfBox(SP->getKey(),SP->getSign());
+	  else
+	    Out&=ruleBox(R);
+	}
+      if (generalPlane && !Out.isEmpty())
+	return planeBox(NVec,DVec,Out);
+      return Out;
+    }
+
+  const SurfPoint* SP=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SP)
+    return surfBox(SP->getKey(),SP->getSign());
+
+  return Geometry::BoundBox();
+}
+
+}  // NAMESPACE RuleBox
@@ -0,0 +1,303 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleProgram.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Rules.h"
+#include "RuleProgram.h"
+
+std::ostream&
+operator<<(std::ostream& OX,const RuleProgram& A)
+  /*!
+    Standard output stream
+    \param OX :: Output stream
+    \param A :: RuleProgram to write
+    \return Current state of stream
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+const int RuleProgram::acceptOp;
+const int RuleProgram::rejectOp;
+const size_t RuleProgram::maxCache;
+
+RuleProgram::RuleProgram() :
+  reuse(0)
+  /*!
+    Constructor
+  */
+{}
+
+RuleProgram::RuleProgram(const RuleProgram& A) :
+  reuse(A.reuse),Ops(A.Ops),Slots(A.Slots)
+  /*!
+    Copy constructor
+    \param A :: RuleProgram to copy
+  */
+{}
+
+RuleProgram&
+RuleProgram::operator=(const RuleProgram& A)
+  /*!
+    Assignment operator
+    \param A :: RuleProgram to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      reuse=A.reuse;
+      Ops=A.Ops;
+      Slots=A.Slots;
+    }
+  return *this;
+}
+
+void
+RuleProgram::clear()
+  /*!
+    Remove the program
+  */
+{
+  reuse=0;
+  Ops.clear();
+  Slots.clear();
+  Labels.clear();
+  return;
+}
+
+int
+RuleProgram::newLabel()
+  /*!
+    Create an unbound jump label
+    \return label index
+  */
+{
+  Labels.push_back(rejectOp-1);
+  return static_cast<int>(Labels.size()-1);
+}
+
+long int
+RuleProgram::getSlot(const Geometry::Surface* SPtr)
+  /*!
+    Get the slot for a surface [added if new]
+    \param SPtr :: Surface
+    \return slot index
+  */
+{
+  std::vector<const Geometry::Surface*>::const_iterator vc=
+    std::find(Slots.begin(),Slots.end(),SPtr);
+  if (vc!=Slots.end())
+    {
+      reuse=1;
+      return static_cast<long int>(vc-Slots.begin());
+    }
+  Slots.push_back(SPtr);
+  return static_cast<long int>(Slots.size()-1);
+}
+
+void
+RuleProgram::addOp(const long int slot,const int sign,
+		   const int TLabel,const int FLabel)
+  /*!
+    Add an instruction [jumps are labels until compile ends]
+    \param slot :: Surface slot / -1 for constant
+    \param sign :: Surface sign / constant value
+    \param TLabel :: Label if true
+    \param FLabel :: Label if false
+  */
+{
+  ruleOp Op;
+  Op.slot=slot;
+  Op.sign=sign;
+  Op.onTrue=TLabel;
+  Op.onFalse=FLabel;
+  Ops.push_back(Op);
+  return;
+}
+
+int
+RuleProgram::compileNode(const Rule* RPtr,const int TLabel,
+			 const int FLabel)
+  /*!
+    Compile a rule so that it jumps to TLabel if
+    valid and FLabel if not.
+    \param RPtr :: Rule [null is false]
+    \param TLabel :: Label on true
+    \param FLabel :: Label on false
+    \return 1 on success / 0 if the rule cannot be compiled
+  */
+{
+  if (!RPtr)
+    {
+      addOp(-1,0,TLabel,FLabel);
+      return 1;
+    }
+
+  const int T=RPtr->type();
+  if (T==1 || T==-1)
+    {
+      // second leaf starts at BLabel
+      const int BLabel=newLabel();
+      const int flag=(T==1) ?
+	compileNode(RPtr->leaf(0),BLabel,FLabel) :
+	compileNode(RPtr->leaf(0),TLabel,BLabel);
+      if (!flag) return 0;
+      Labels[static_cast<size_t>(BLabel)]=static_cast<int>(Ops.size());
+      return compileNode(RPtr->leaf(1),TLabel,FLabel);
+    }
+
+  const SurfPoint* SP=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SP)
+    {
+      if (!SP->getKey()) return 0;
+      addOp(getSlot(SP->getKey()),SP->getSign(),TLabel,FLabel);
+      return 1;
+    }
+  if (dynamic_cast<const CompGrp*>(RPtr))
+    return compileNode(RPtr->leaf(0),FLabel,TLabel);
+  if (dynamic_cast<const ContGrp*>(RPtr))
+    return compileNode(RPtr->leaf(0),TLabel,FLabel);
+  if (dynamic_cast<const BoolValue*>(RPtr))
+    {
+      addOp(-1,(RPtr->isValid(Geometry::Vec3D())) ? 1 : 0,TLabel,FLabel);
+      return 1;
+    }
+  // CompObj/ContObj depend on other objects
+  return 0;
+}
+
+int
+RuleProgram::compile(const Rule* RPtr)
+  /*!
+    Build the program from a populated rule tree.
+    \param RPtr :: Top rule
+    \return 1 on success / 0 if tree has unsupported
+    components [program empty]
+  */
+{
+  ELog::RegMethod RegA("RuleProgram","compile");
+
+  clear();
+  if (!RPtr) return 0;
+
+  // labels 0/1 are the final results
+  Labels.push_back(acceptOp);
+  Labels.push_back(rejectOp);
+  if (!compileNode(RPtr,0,1))
+    {
+      clear();
+      return 0;
+    }
+
+  for(ruleOp& Op : Ops)
+    {
+      Op.onTrue=Labels[static_cast<size_t>(Op.onTrue)];
+      Op.onFalse=Labels[static_cast<size_t>(Op.onFalse)];
+    }
+  Labels.clear();
+  return 1;
+}
+
+int
+RuleProgram::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Run the program on a point [equivalent to Rule::isValid]
+    \param Pt :: Point to test
+    \return 1 if valid [inside or on surface] / 0 if not
+  */
+{
+  // side cache : 0 not calculated / side+2
+  signed char sideCache[maxCache];
+  const int useCache(reuse && Slots.size()<=maxCache);
+  if (useCache)
+    std::fill(sideCache,sideCache+Slots.size(),0);
+
+  int index(0);
+  while(index>=0)
+    {
+      const ruleOp& Op=Ops[static_cast<size_t>(index)];
+      int flag;
+      if (Op.slot<0)
+	flag=Op.sign;
+      else
+	{
+	  const size_t slot(static_cast<size_t>(Op.slot));
+	  int side;
+	  if (!useCache)
+	    side=Slots[slot]->side(Pt);
+	  else if (sideCache[slot])
+	    side=sideCache[slot]-2;
+	  else
+	    {
+	      side=Slots[slot]->side(Pt);
+	      sideCache[slot]=static_cast<signed char>(side+2);
+	    }
+	  flag=(side*Op.sign>=0);
+	}
+      index=(flag) ? Op.onTrue : Op.onFalse;
+    }
+  return (index==acceptOp) ? 1 : 0;
+}
+
+void
+RuleProgram::write(std::ostream& OX) const
+  /*!
+    Write out the program [debug]
+    \param OX :: Output stream
+  */
+{
+  for(size_t i=0;i<Ops.size();i++)
+    {
+      const ruleOp& Op=Ops[i];
+      OX<<i<<" : ";
+      if (Op.slot<0)
+	OX<<"const "<<Op.sign;
+      else
+	OX<<Op.sign*Slots[static_cast<size_t>(Op.slot)]->getName();
+      OX<<" T->"<<Op.onTrue<<" F->"<<Op.onFalse<<std::endl;
+    }
+  return;
+}
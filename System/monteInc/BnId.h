@@ -27,19 +27,23 @@
   \brief Tri-state variable 
   \author S. Ansell
   \date April 2005
-  \version 1.0
+  \version 2.0
 
-  
   This class holds a tri-state variable 
   of -1 (false) 0 (not-important) 1 (true) against
-  each of the possible input desisions. It has
-  arbiatary length (unlike using a long integer)
-  \todo Could be improved by using a set of 
-  unsigned integers. 
+  each of the possible input desisions. The states are
+  packed into two words : care [bit set if the variable is
+  1/-1] and value [bit set if the variable is 1] so the
+  size is limited to maxSize variables. The MinTerm list is
+  a bitset.
 */
 
 class BnId
 {
+ public:
+
+  static const size_t maxSize=64;   ///< Max number of variables
+
  private:
 
   static int fullOut;       ///< Full output for display
@@ -48,9 +52,11 @@ class BnId
   int PI;                   ///< Prime Implicant
   size_t Tnum;              ///< True number (1 in Tval)
   size_t Znum;              ///< Zero number (0 in Tval)
-  std::vector<int> Tval;    ///< Truth values
-  std::set<int> MinTerm;    ///< Minterms list
+  unsigned long int care;   ///< Bit set if not don't-care
+  unsigned long int value;  ///< Bit set if true
+  std::vector<unsigned long int> MinTerm;    ///< Minterms bitset
 
+  static unsigned long int sizeMask(const size_t);
   void setCounters();    
 
  public:
@@ -83,6 +89,7 @@ class BnId
   size_t intValue() const;              
   std::pair<int,BnId> 
     makeCombination(const BnId&) const;  
+  int combine(const BnId&,BnId&) const;
 
   /// Total requiring expression
   size_t expressCount() const { return size-Znum; } 
@@ -90,6 +97,10 @@ class BnId
   size_t Size() const { return size; }   
   /// Access true count
   size_t TrueCount() const { return Tnum; }
+  /// Bits that are not don't-care
+  unsigned long int careMask() const { return care; }
+  /// Bits that are true
+  unsigned long int valueMask() const { return value; }
   
   void mapState(const std::vector<int>&,std::map<int,int>&) const;
   void setState(const std::vector<int>&,const std::map<int,int>&);
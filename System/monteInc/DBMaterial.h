@@ -36,6 +36,9 @@ namespace ModelSupport
   \author S. Ansell
   \date December 2009
   \brief Storage fo all the surfaces in the problem
+
+  The built-in materials are held unparsed [DStore] and are
+  built into MStore on first use.
 */
 
 class DBMaterial
@@ -49,13 +52,48 @@ class DBMaterial
   /// Storage type for Neut Materials
   typedef std::map<int,scatterSystem::neutMaterial*> NTYPE;
 
-  SCTYPE IndexMap;   ///< Map of indexes
-  MTYPE  MStore;     ///< Store of materials
-  NTYPE  NStore;     ///< Store of neutron materials [if exist]
+  /*!
+    \struct matDef
+    \brief Unparsed built-in material
+    
+    Takes the same arguments as Material so the built-in
+    list is only parsed when a material is used.
+  */
+  struct matDef
+  {
+    int index;              ///< Material number
+    std::string name;       ///< Material name
+    std::string zaidLine;   ///< Zaid line
+    std::string mtLine;     ///< Treatment line
+    std::string libLine;    ///< Library line
+    double density;         ///< Density [0 : from zaids]
+
+    /// Set the material [as Material::setMaterial]
+    void setMaterial(const int I,const std::string& N,
+		     const std::string& ZL,const std::string& MTL,
+		     const std::string& LL)
+      { index=I; name=N; zaidLine=ZL; mtLine=MTL; libLine=LL; density=0.0; }
+    /// Set the density [as Material::setDensity]
+    void setDensity(const double D) { density=D; }
+  };
+  
+  /// Storage type for unparsed materials
+  typedef std::map<int,matDef> DTYPE;
+
+  SCTYPE IndexMap;        ///< Map of indexes
+  mutable MTYPE  MStore;  ///< Store of materials
+  mutable DTYPE  DStore;  ///< Unparsed materials [not in MStore]
+  NTYPE  NStore;          ///< Store of neutron materials [if exist]
+
+  int endf7Flag;                   ///< setENDF7 has been called
+  std::set<std::string> deactive;  ///< Deactivated particles
 
   /// Active list
   std::set<int> active;
 
+  mutable std::vector<double> attnTable;   ///< density*A^0.66 [-1 no mat]
+  mutable std::vector<double> meanATable;  ///< Mean A [by number]
+
   DBMaterial();
 
   ///\cond SINGLETON
@@ -64,9 +102,15 @@ class DBMaterial
   ///\endcond SINGLETON
 
   void initMaterial();
-  void initMXUnits();
+  static void initMXUnits(MonteCarlo::Material&);
+  void setMaterial(const matDef&);
+  MTYPE::iterator findMaterial(const int) const;
+  MTYPE::iterator buildMaterial(const int) const;
+  void buildStore() const;
   void checkNameIndex(const int,const std::string&) const;
   int getFreeNumber() const;
+  void buildAttnTable() const;
+  void clearAttnTable();
 
   int createOrthoParaMix(const std::string&,const double);
   int createMix(const std::string&,const std::string&,
@@ -79,14 +123,18 @@ class DBMaterial
   static DBMaterial& Instance();
   
   ~DBMaterial() {}  ///< Destructor
+
+  void reset();
   
-  /// get data store
-  const MTYPE& getStore() const { return MStore; }
+  const MTYPE& getStore() const;
   /// Get neutron material list
   const NTYPE& getNeutMat() const { return NStore; }
   const MonteCarlo::Material& getMaterial(const int) const;
   const MonteCarlo::Material& getMaterial(const std::string&) const;
 
+  const std::vector<double>& getAttnTable() const;
+  const std::vector<double>& getMeanATable() const;
+
   void resetMaterial(const MonteCarlo::Material&);
   void setMaterial(const MonteCarlo::Material&);
   void setNeutMaterial(const int,const scatterSystem::neutMaterial&);
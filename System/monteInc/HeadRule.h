@@ -118,6 +118,7 @@ class HeadRule
   void isolateSurfNum(const std::set<int>&);
   int removeTopItem(const int);
   int substituteSurf(const int,const int,const Geometry::Surface*);
+  int substituteSurf(const std::map<int,int>&);
   void removeCommon();
   
   void makeComplement();
@@ -22,6 +22,10 @@
 #ifndef LineIntersectVisit_h
 #define LineIntersectVisit_h
 
+namespace LineKernel
+{
+  class surfBatch;
+}
 
 namespace MonteCarlo
 {
@@ -47,7 +51,12 @@ class LineIntersectVisit : public Global::BaseVisit
     std::vector<const Geometry::Surface*> SurfIndex;           ///< SurfNames
     int neutIndex;                        ///< Neutron number
 
+    std::vector<double> batchL;           ///< Batch roots [scratch]
+    std::vector<size_t> batchI;           ///< Batch surface index [scratch]
+    std::vector<size_t> batchOrder;       ///< Batch root order [scratch]
+
     void procTrack(const Geometry::Surface*);
+    void procRoots(const Geometry::Surface*,const size_t,const double*);
     ///\cond PRIVATE
     LineIntersectVisit(const LineIntersectVisit&);
     LineIntersectVisit& operator=(const LineIntersectVisit&);
@@ -74,6 +83,8 @@ class LineIntersectVisit : public Global::BaseVisit
     void Accept(const Geometry::Plane&);
     void Accept(const Geometry::Sphere&);
     void Accept(const Geometry::Torus&);
+    void Accept(const LineKernel::surfBatch&,
+		const std::vector<const Geometry::Surface*>&);
 
     /// Clear track
     void clearTrack() 
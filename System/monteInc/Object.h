@@ -23,6 +23,17 @@
 #define MonteCarlo_Object_h
 
 class Token;
+class RuleProgram;
+
+namespace Geometry
+{
+  class BoundBox;
+}
+
+namespace LineKernel
+{
+  class surfBatch;
+}
 
 namespace MonteCarlo
 {
@@ -64,6 +75,13 @@ class Object
   
   /// Set of surfaces that are logically opposite in the rule.
   std::set<const Geometry::Surface*> logicOppSurf;
+
+  mutable Geometry::BoundBox* boxPtr;   ///< Cached bounding box [0 if not calc]
+  RuleProgram* progPtr;                 ///< Compiled HRule [0 if not compiled]
+  LineKernel::surfBatch* batchPtr;      ///< Kernel batch of SurList [0 if none]
+
+  void compileRule();
+  void createSurfBatch();
  
   int checkSurfaceValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
   int checkExteriorValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
@@ -79,6 +97,7 @@ class Object
   std::set<int> SurSet;              ///< set of surfaces in cell [signed]
 
   int trackDirection(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
+  void addSurfaceList(const Rule*,std::ostream&);
 
   bool keyUnit(std::string&,std::string&,std::string&);
 
@@ -144,11 +163,17 @@ class Object
   void rePopulate();
   int createSurfaceList();
   void createLogicOpp();
+  const Geometry::BoundBox& getBoundBox() const;
+  void clearBoundBox();
+  /// Access compiled rule [0 if not compiled]
+  const RuleProgram* getProgram() const { return progPtr; }
   int isObjSurfValid() const { return objSurfValid; }  ///< Check validity needed
   void setObjSurfValid()  { objSurfValid=1; }          ///< set as valid
   int addSurfString(const std::string&);   
+  int addIntersection(const HeadRule&);
   int removeSurface(const int);        
   int substituteSurf(const int,const int,Geometry::Surface*);  
+  int substituteSurf(const std::map<int,int>&);
   void makeComplement();
 
   bool hasSurface(const int) const;
@@ -0,0 +1,65 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RuleBox.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RuleBox_h
+#define RuleBox_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+  class BoundBox;
+}
+
+/*!
+  \namespace RuleBox
+  \version 1.0
+  \author S. Ansell
+  \date June 2018
+  \brief Conservative axis aligned boxes of rule trees
+
+  Boxes are built bottom up: intersections intersect the boxes
+  of their leaves, unions enclose them. Plane groups within an
+  intersection are clipped against the current box and, if the
+  resulting polyhedron is bounded, replaced by the box of its
+  vertices.
+*/
+
+namespace RuleBox
+{
+  /// Max planes in a vertex calculation [O(N^3)]
+  const size_t maxVertexPlanes(48);
+  /// Off-axis normal component for an exact axis plane
+  const double axisTol(1e-12);
+
+  size_t axisIndex(const Geometry::Vec3D&);
+  Geometry::BoundBox surfBox(const Geometry::Surface*,const int);
+
+  Geometry::BoundBox
+  planeBox(const std::vector<Geometry::Vec3D>&,
+	   const std::vector<double>&,
+	   const Geometry::BoundBox&);
+
+  Geometry::BoundBox ruleBox(const Rule*);
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RuleProgram.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RuleProgram_h
+#define RuleProgram_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+  class Vec3D;
+}
+
+/*!
+  \class RuleProgram
+  \brief Flat compiled form of a populated rule tree
+  \author S. Ansell
+  \version 1.0
+  \date June 2018
+
+  Each surface leaf becomes one instruction holding a
+  surface slot, a sign and two jump targets [true/false].
+  Intersections and unions are encoded as jumps so
+  evaluation is a short-circuit loop over a contiguous
+  array. Surfaces used more than once share a slot and
+  are only evaluated once per point.
+*/
+
+class RuleProgram
+{
+ private:
+
+  /// Single test instruction
+  struct ruleOp
+  {
+    long int slot;     ///< Surface slot [-1 for constant]
+    int sign;          ///< Surface sign / constant value
+    int onTrue;        ///< Next op if true [-ve : result]
+    int onFalse;       ///< Next op if false [-ve : result]
+  };
+
+  static const int acceptOp=-1;     ///< Jump : point valid
+  static const int rejectOp=-2;     ///< Jump : point not valid
+  static const size_t maxCache=256; ///< Max slots for side cache
+
+  int reuse;                                   ///< Slot used twice
+  std::vector<ruleOp> Ops;                     ///< Program
+  std::vector<const Geometry::Surface*> Slots; ///< Unique surfaces
+
+  std::vector<int> Labels;                     ///< Label positions
+
+  int newLabel();
+  long int getSlot(const Geometry::Surface*);
+  void addOp(const long int,const int,const int,const int);
+  int compileNode(const Rule*,const int,const int);
+
+ public:
+
+  RuleProgram();
+  RuleProgram(const RuleProgram&);
+  RuleProgram& operator=(const RuleProgram&);
+  ~RuleProgram() {}    ///< Destructor
+
+  /// Has a program
+  int isActive() const { return !Ops.empty(); }
+  /// Number of instructions
+  size_t nOps() const { return Ops.size(); }
+  /// Number of unique surfaces
+  size_t nSlots() const { return Slots.size(); }
+
+  void clear();
+  int compile(const Rule*);
+
+  int isValid(const Geometry::Vec3D&) const;
+
+  void write(std::ostream&) const;
+};
+
+std::ostream&
+operator<<(std::ostream&,const RuleProgram&);
+
+#endif
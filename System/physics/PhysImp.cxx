@@ -379,6 +379,35 @@ PhysImp::renumberCell(const int oldCellN,const int newCellN)
   return; 
 }
 
+void
+PhysImp::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumbers a set of cells in one pass [RMap can be 
+    a permutation]
+    \param RMap :: Map of old cell number : new cell number
+  */
+{
+  ELog::RegMethod RegA("PhysImp","renumberCell");
+  if (impNum.empty() || RMap.empty()) return;
+
+  typedef std::map<int,double> ITYPE;
+  for(const std::map<int,int>::value_type& RM : RMap)
+    if (RM.first!=RM.second && impNum.find(RM.first)==impNum.end())
+      throw ColErr::InContainerError<int>(RM.first,"Old cell not found "+
+					  RegA.getFull());    
+
+  ITYPE newImpNum;
+  for(const ITYPE::value_type& IV : impNum)
+    {
+      const std::map<int,int>::const_iterator mc=RMap.find(IV.first);
+      const int CN=(mc==RMap.end()) ? IV.first : mc->second;
+      if (!newImpNum.insert(ITYPE::value_type(CN,IV.second)).second)
+	throw ColErr::InContainerError<int>(CN,"New cell exists");
+    }
+  impNum.swap(newImpNum);
+  return; 
+}
+
 int
 PhysImp::removeParticle(const std::string& PT)
   /*!
@@ -995,6 +995,26 @@ PhysicsCards::substituteCell(const int oldCell,const int newCell)
 
   return;
 }
+
+void
+PhysicsCards::substituteCell(const std::map<int,int>& RMap)
+  /*!
+    Substitute a set of cells in all physics cards that use cells
+    \param RMap :: Map of old cell number : new cell number
+   */
+{
+  ELog::RegMethod RegA("PhysicsCards","substituteCell");
+  histpCells.changeItem(RMap);
+  for(PhysImp& PI : ImpCards)
+    PI.renumberCell(RMap);
+  Volume.renumberCell(RMap);
+  for(const std::map<int,int>::value_type& RM : RMap)
+    {
+      PWTCard->renumberCell(RM.first,RM.second);
+      ExtCard->renumberCell(RM.first,RM.second);
+    }
+  return;
+}
   
 void
 PhysicsCards::setMode(std::string Particles) 
@@ -1079,6 +1099,21 @@ PhysicsCards::writeHelp(const std::string& keyName) const
   return;
 }
 
+void
+PhysicsCards::writeRND(std::ostream& OX) const
+  /*!
+    Write out the card that holds the random number seed
+    [dbcn for MCNPX / RAND for MCNP6] as written by write
+    \param OX :: Output stream
+  */
+{
+  if (mcnpVersion==10)
+    dbCard->write(OX);
+  else
+    RAND->write(OX);
+  return;
+}
+
 void
 PhysicsCards::writeFLUKA(std::ostream& OX) const
   /*!
@@ -176,10 +176,12 @@ class PhysicsCards
 
   void rotateMaster();
   void substituteCell(const int,const int);
+  void substituteCell(const std::map<int,int>&);
   //  void substituteSurface(const int,const int); 
 
   void writeHelp(const std::string&) const;
   
+  void writeRND(std::ostream&) const;
   void writeFLUKA(std::ostream&) const;
   void writePHITS(std::ostream&);
   void write(std::ostream&,const std::vector<int>&,
@@ -312,7 +312,7 @@ LineTrack::updateDistance(MonteCarlo::Object* OPtr,
     \return 1 if distance insufficient / 0 if at end of line
    */
 {
-  ELog::RegMethod RegA("LineTrack","updateDistance");
+  ELog::RegHot RegA("LineTrack","updateDistance");
 
   Cells.push_back(OPtr->getName());
   ObjVec.push_back(OPtr);
@@ -429,20 +429,19 @@ LineTrack::createAttenPath(std::vector<long int>& cVec,
     \param aVec :: Attenuation 
   */
 {
-  const ModelSupport::DBMaterial& DB=
-    ModelSupport::DBMaterial::Instance();
+  const std::vector<double>& attnTable=
+    ModelSupport::DBMaterial::Instance().getAttnTable();
 
   for(size_t i=0;i<Cells.size();i++)
     {
       const int matN=(!ObjVec[i]) ? -1 : ObjVec[i]->getMat();
       if (matN>0)
 	{
-	  const MonteCarlo::Material& matInfo=DB.getMaterial(matN);
-	  const double density=matInfo.getAtomDensity();
-	  const double A=matInfo.getMeanA();
-	  const double sigma=segmentLen[i]*density*std::pow(A,0.66);
+	  const size_t index(static_cast<size_t>(matN));
+	  if (index>=attnTable.size() || attnTable[index]<0.0)
+	    throw ColErr::InContainerError<size_t>(index,"matN in attnTable");
 	  cVec.push_back(ObjVec[i]->getName());
-	  aVec.push_back(sigma);
+	  aVec.push_back(segmentLen[i]*attnTable[index]);
 	}
     }
   return;
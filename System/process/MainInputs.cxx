@@ -167,12 +167,16 @@ createInputs(inputParam& IParam)
   IParam.regItem("volCard","volCard");
   IParam.regDefItem<int>("VN","volNum",1,20000);
   IParam.regMulti("volCell","volCells",100,1,100);
+  IParam.regItem("volType","volType",1,2);
+  IParam.regItem("volErr","volErr",1);
+  IParam.regItem("volThread","volThread",1);
     
   IParam.regFlag("void","void");
   IParam.regMulti("voidObject","voidObject",1000);
   IParam.regItem("vtkMesh","vtkMesh",1);
   IParam.regItem("vtk","vtk",0);
-  IParam.regItem("vtkType","vtkType",1);
+  IParam.regItem("vtkType","vtkType",1,2);
+  IParam.regItem("vtkThread","vtkThread",1);
   std::vector<std::string> VItems(15,"");
   IParam.regDefItemList<std::string>("vmat","vmat",15,VItems);
 
@@ -285,8 +289,15 @@ createInputs(inputParam& IParam)
   IParam.setDesc("volume","Create volume about point/radius for f4 tally");
   IParam.setDesc("volCells","Cells [object/range]");
   IParam.setDesc("volCard","set/delete the vol card");
+  IParam.setDesc("volType","Volume sampling : random/halton/sobol/"
+		 "strat [nStrata]");
+  IParam.setDesc("volErr","Relative error to stop volume sampling");
+  IParam.setDesc("volThread","Number of threads for volume sampling");
   IParam.setDesc("vtk","Write out VTK plot mesh");
   IParam.setDesc("vtkMesh","Define mesh for MD5/VTK");
+  IParam.setDesc("vtkType","VTK data [cell/material/density] "
+		  "and format [ascii/binary/xml]");
+  IParam.setDesc("vtkThread","Number of threads to populate VTK mesh");
   IParam.setDesc("vmat","Material sections to be written by vtk output");
   IParam.setDesc("VN","Number of points in the volume integration");
   IParam.setDesc("validCheck","Run simulation to check for validity");
@@ -535,7 +535,6 @@ buildFullSimFLUKA(SimFLUKA* SimFLUKAPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimFLUKA");
 
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
   if (IParam.flag("noVariables"))
     SimFLUKAPtr->setNoVariables();
@@ -554,12 +553,7 @@ buildFullSimFLUKA(SimFLUKA* SimFLUKAPtr,
   //  SimFLUKAPtr->masterSourceRotation();
   // Ensure we done loop
 
-  do
-    {
-      SimProcess::writeIndexSimFLUKA(*SimFLUKAPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSimFLUKA(*SimFLUKAPtr,OName,multi);
 
   return;
 }
@@ -617,7 +611,6 @@ buildFullSimMCNP(SimMCNP* SimMCPtr,
    */
 {
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
   
@@ -636,12 +629,7 @@ buildFullSimMCNP(SimMCNP* SimMCPtr,
   SDef::sourceSelection(*SimMCPtr,IParam);
   //  SimMCPtr->masterSourceRotation();
   // Ensure we done loop
-  do
-    {
-      SimProcess::writeIndexSim(*SimMCPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSim(*SimMCPtr,OName,multi);
 
   return;
 }
@@ -258,7 +258,7 @@ ObjSurfMap::findNextObject(const int SN,
     \return Next Object Ptr / 0 on point not valid
   */
 {
-  ELog::RegMethod RegA("ObjSurfMap","findNextObject");
+  ELog::RegHot RegA("ObjSurfMap","findNextObject");
 
   const STYPE& MVec=getObjects(SN);
 
@@ -363,6 +363,66 @@ ObjSurfMap::removeObject(const MonteCarlo::Object* OPtr)
   return;
 }
   
+void
+ObjSurfMap::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Change the surface numbers [after a renumber]
+    \param RMap :: Map of old surface number : new number [+ve]
+  */
+{
+  ELog::RegMethod RegA("ObjSurfMap","renumberSurf");
+
+  if (RMap.empty()) return;
+  
+  OMTYPE newSMap;
+  for(OMTYPE::value_type& SV : SMap)
+    {
+      const int SN(SV.first);
+      const std::map<int,int>::const_iterator mc=
+	RMap.find((SN>0) ? SN : -SN);
+      const int newSN=(mc==RMap.end()) ? SN :
+	((SN>0) ? mc->second : -mc->second);
+      newSMap[newSN].swap(SV.second);
+    }
+  SMap.swap(newSMap);
+
+  for(OSTYPE::value_type& OS : OSurfMap)
+    {
+      surfTYPE newSet;
+      for(const int SN : OS.second)
+	{
+	  const std::map<int,int>::const_iterator mc=
+	    RMap.find((SN>0) ? SN : -SN);
+	  newSet.insert((mc==RMap.end()) ? SN :
+			((SN>0) ? mc->second : -mc->second));
+	}
+      OS.second.swap(newSet);
+    }
+  return;
+}
+
+void
+ObjSurfMap::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Change the cell numbers [after a renumber]
+    \param RMap :: Map of old cell number : new number
+  */
+{
+  ELog::RegMethod RegA("ObjSurfMap","renumberCell");
+
+  if (RMap.empty()) return;
+
+  OSTYPE newOSurfMap;
+  for(OSTYPE::value_type& OS : OSurfMap)
+    {
+      const std::map<int,int>::const_iterator mc=RMap.find(OS.first);
+      const int CN=(mc==RMap.end()) ? OS.first : mc->second;
+      newOSurfMap[CN].swap(OS.second);
+    }
+  OSurfMap.swap(newOSurfMap);
+  return;
+}
+
 const std::set<int>&
 ObjSurfMap::connectedObjects(const int cellNumber) const
   /*!
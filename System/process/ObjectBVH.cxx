@@ -0,0 +1,282 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   process/ObjectBVH.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <memory>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "BoundBox.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "ObjectBVH.h"
+
+namespace ModelSupport
+{
+
+const size_t ObjectBVH::leafSize;
+
+ObjectBVH::ObjectBVH() :
+  active(0)
+  /*!
+    Constructor
+  */
+{}
+
+ObjectBVH::ObjectBVH(const ObjectBVH& A) :
+  active(A.active),Nodes(A.Nodes),ItemBox(A.ItemBox),
+  Items(A.Items),Unbound(A.Unbound)
+  /*!
+    Copy constructor
+    \param A :: ObjectBVH to copy
+  */
+{}
+
+ObjectBVH&
+ObjectBVH::operator=(const ObjectBVH& A)
+  /*!
+    Assignment operator
+    \param A :: ObjectBVH to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      active=A.active;
+      Nodes=A.Nodes;
+      ItemBox=A.ItemBox;
+      Items=A.Items;
+      Unbound=A.Unbound;
+    }
+  return *this;
+}
+
+void
+ObjectBVH::clearAll()
+  /*!
+    Remove the tree : findCell users fall back to a full search
+  */
+{
+  active=0;
+  Nodes.clear();
+  ItemBox.clear();
+  Items.clear();
+  Unbound.clear();
+  return;
+}
+
+size_t
+ObjectBVH::buildNode(const size_t first,const size_t last)
+  /*!
+    Build a node for the items [first,last) and recurse
+    \param first :: first item
+    \param last :: one past the last item
+    \return node index
+  */
+{
+  const size_t nodeIndex(Nodes.size());
+  Nodes.push_back(bvhNode());
+
+  Geometry::BoundBox NBox(Geometry::BoundBox::emptyBox());
+  Geometry::BoundBox CBox(Geometry::BoundBox::emptyBox());
+  for(size_t i=first;i<last;i++)
+    {
+      NBox|=ItemBox[i];
+      CBox.addPoint(ItemBox[i].getCentre());
+    }
+  Nodes[nodeIndex].Box=NBox;
+
+  if (last-first<=leafSize)
+    {
+      Nodes[nodeIndex].index=first;
+      Nodes[nodeIndex].count=last-first;
+      return nodeIndex;
+    }
+
+  // split on the median centre of the longest axis
+  const size_t axis=CBox.longAxis();
+  const size_t mid=first+(last-first)/2;
+
+  std::vector<size_t> Order(last-first);
+  for(size_t i=0;i<Order.size();i++)
+    Order[i]=first+i;
+  std::nth_element(Order.begin(),Order.begin()+
+		   static_cast<long int>(mid-first),Order.end(),
+		   [this,axis](const size_t A,const size_t B)
+		   {
+		     return (ItemBox[A].low(axis)+ItemBox[A].high(axis))<
+		       (ItemBox[B].low(axis)+ItemBox[B].high(axis));
+		   });
+
+  std::vector<Geometry::BoundBox> tmpBox;
+  std::vector<MonteCarlo::Object*> tmpItem;
+  for(const size_t index : Order)
+    {
+      tmpBox.push_back(ItemBox[index]);
+      tmpItem.push_back(Items[index]);
+    }
+  std::copy(tmpBox.begin(),tmpBox.end(),
+	    ItemBox.begin()+static_cast<long int>(first));
+  std::copy(tmpItem.begin(),tmpItem.end(),
+	    Items.begin()+static_cast<long int>(first));
+
+  Nodes[nodeIndex].count=0;
+  buildNode(first,mid);                     // left is nodeIndex+1
+  const size_t rightIndex=buildNode(mid,last);
+  Nodes[nodeIndex].index=rightIndex;
+  return nodeIndex;
+}
+
+void
+ObjectBVH::build(const std::map<int,MonteCarlo::Object*>& OList)
+  /*!
+    Build the tree from the object map
+    \param OList :: Map of cells
+  */
+{
+  ELog::RegMethod RegA("ObjectBVH","build");
+
+  clearAll();
+  for(const std::map<int,MonteCarlo::Object*>::value_type& MV : OList)
+    {
+      MonteCarlo::Object* OPtr=MV.second;
+      if (!OPtr->isPlaceHold())
+	{
+	  const Geometry::BoundBox& BBox=OPtr->getBoundBox();
+	  if (BBox.isFinite())
+	    {
+	      Items.push_back(OPtr);
+	      ItemBox.push_back(BBox);
+	    }
+	  else if (!BBox.isEmpty())
+	    Unbound.push_back(OPtr);
+	}
+    }
+  if (!Items.empty())
+    buildNode(0,Items.size());
+
+  active=1;
+  return;
+}
+
+void
+ObjectBVH::getCandidates(const Geometry::Vec3D& Pt,
+			 std::vector<MonteCarlo::Object*>& Out) const
+  /*!
+    Get all the objects whose box contains the point
+    \param Pt :: Point to test
+    \param Out :: Objects that may contain the point [added to]
+  */
+{
+  Out.insert(Out.end(),Unbound.begin(),Unbound.end());
+  if (Nodes.empty()) return;
+
+  size_t stack[128];
+  size_t sIndex(0);
+  stack[sIndex++]=0;
+  while(sIndex)
+    {
+      const bvhNode& N=Nodes[stack[--sIndex]];
+      if (N.Box.isValid(Pt))
+	{
+	  if (N.count)
+	    {
+	      for(size_t i=N.index;i<N.index+N.count;i++)
+		if (ItemBox[i].isValid(Pt))
+		  Out.push_back(Items[i]);
+	    }
+	  else if (sIndex+2<=128)
+	    {
+	      const size_t nodeIndex=
+		static_cast<size_t>(&N-&Nodes.front());
+	      stack[sIndex++]=N.index;
+	      stack[sIndex++]=nodeIndex+1;
+	    }
+	  else
+	    throw ColErr::IndexError<size_t>(sIndex,128,"BVH stack depth");
+	}
+    }
+  return;
+}
+
+MonteCarlo::Object*
+ObjectBVH::findCell(const Geometry::Vec3D& Pt) const
+  /*!
+    Find the object containing the point. If more than
+    one object is valid the lowest cell number is returned
+    to match a full ordered search.
+    \param Pt :: Point to find
+    \return Object / 0 if no object found
+  */
+{
+  std::vector<MonteCarlo::Object*> Cand;
+  getCandidates(Pt,Cand);
+
+  std::sort(Cand.begin(),Cand.end(),
+	    [](const MonteCarlo::Object* A,const MonteCarlo::Object* B)
+	    {
+	      return A->getName()<B->getName();
+	    });
+
+  for(MonteCarlo::Object* OPtr : Cand)
+    if (OPtr->isValid(Pt))
+      return OPtr;
+
+  return 0;
+}
+
+void
+ObjectBVH::write(std::ostream& OX) const
+  /*!
+    Write out summary of the tree
+    \param OX :: Output stream
+  */
+{
+  OX<<"BVH : bounded "<<Items.size()<<" unbounded "<<Unbound.size()
+    <<" nodes "<<Nodes.size();
+  if (!Nodes.empty())
+    OX<<" root "<<Nodes.front().Box;
+  OX<<std::endl;
+  return;
+}
+
+}  // NAMESPACE ModelSupport
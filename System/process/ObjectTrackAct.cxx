@@ -157,6 +157,20 @@ ObjectTrackAct::getAttnSum(const long int objN) const
 
   const ModelSupport::DBMaterial& DB=
     ModelSupport::DBMaterial::Instance();
+  return getAttnSum(objN,DB.getAttnTable());
+}
+
+double
+ObjectTrackAct::getAttnSum(const long int objN,
+			   const std::vector<double>& attnTable) const
+  /*!
+    Calculate the sum of the attenuation
+    \param objN :: Cell number to use
+    \param attnTable :: Attenuation of each material [by number]
+    \return sum of distance*attenuation in non-void
+  */
+{
+  ELog::RegHot RegA("ObjectTrackAct","getAttnSum(table)");
 
   std::map<long int,LineTrack>::const_iterator mc=Items.find(objN);
   if (mc==Items.end())
@@ -170,28 +184,75 @@ ObjectTrackAct::getAttnSum(const long int objN) const
   double sum(0.0);
   for(size_t i=0;i<TVec.size();i++)
     {
-      const long int matN=OVec[i]->getMat();
+      const size_t matN=static_cast<size_t>(OVec[i]->getMat());
       if (matN)
 	{
-	  const MonteCarlo::Material& matInfo=
-	    DB.getMaterial(static_cast<int>(matN));
-	  const double density=matInfo.getAtomDensity();
-	  const double AMean=matInfo.getMeanA();
-	  sum+=TVec[i]*std::pow(AMean,0.66)*density;
+	  if (matN>=attnTable.size() || attnTable[matN]<0.0)
+	    throw ColErr::InContainerError<size_t>(matN,"matN in attnTable");
+	  sum+=TVec[i]*attnTable[matN];
 	}
     }
   return sum;
 }
 
+std::vector<double>
+ObjectTrackAct::getAttnTable(const double E)
+  /*!
+    Get the attenuation of each material at an energy
+    indexed by material number
+    \param E :: Energy [MeV] : 0 for energy independent
+    \return density*A^0.66*energyFactor of each material
+      [negative for no material]
+  */
+{
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+
+  std::vector<double> Out(DB.getAttnTable());
+  if (E>0.0)
+    {
+      const std::vector<double>& AVec=DB.getMeanATable();
+      for(size_t i=0;i<Out.size();i++)
+	Out[i]*=energyFactor(AVec[i],E);
+    }
+  return Out;
+}
+
 double
-ObjectTrackAct::getAttnSum(const long int objN,const double E) const
+ObjectTrackAct::energyFactor(const double AMean,const double E)
   /*!
-    Calculate the sum in the material
+    Energy scaling of the geometric A^0.66 cross section.
+    Uses sigma=2pi(R+lambda)^2 with R=1.4A^1/3 fm and lambda
+    the reduced neutron wavelength [4.55/sqrt(E) fm], limited
+    to the low energy potential scattering value 4piR^2.
+    \param AMean :: Mean atomic mass
+    \param E :: Energy [MeV] : zero for no scaling
+    \return factor [1 at high energy to 2 at low energy]
+  */
+{
+  if (E<=0.0 || AMean<=0.0)
+    return 1.0;
+
+  const double R=1.4*std::cbrt(AMean);
+  const double lambda=4.55/std::sqrt(E);
+  const double F=(1.0+lambda/R)*(1.0+lambda/R);
+  return (F>2.0) ? 2.0 : F;
+}
+
+void
+ObjectTrackAct::getMatAttn(const long int objN,
+			   std::vector<double>& AVec,
+			   std::vector<double>& attnVec) const
+  /*!
+    Calculate the energy independent attenuation of each
+    material on the track. This allows the attenuation at
+    many energies without re-tracking.
     \param objN :: Cell number to use
-    \return sum of distance in non-void
+    \param AVec :: Mean atomic mass of each material
+    \param attnVec :: Sum of distance*density*A^0.66 in material
   */
 {
-  ELog::RegMethod RegA("ObjectTrackAct","getAttnSum(E)");
+  ELog::RegMethod RegA("ObjectTrackAct","getMatAttn");
 
   const ModelSupport::DBMaterial& DB=
     ModelSupport::DBMaterial::Instance();
@@ -200,26 +261,57 @@ ObjectTrackAct::getAttnSum(const long int objN,const double E) const
   if (mc==Items.end())
     throw ColErr::InContainerError<long int>(objN,"objN in Items");
   
-  // Get Two Paired Vectors
   const std::vector<MonteCarlo::Object*>& OVec=
     mc->second.getObjVec();
   const std::vector<double>& TVec=mc->second.getSegmentLen();
-  
-  double sum(0.0);
+
+  const std::vector<double>& attnTable=DB.getAttnTable();
+  const std::vector<double>& meanATable=DB.getMeanATable();
+  std::vector<size_t> matVec;
+  const size_t offset(attnVec.size());
   for(size_t i=0;i<TVec.size();i++)
     {
-      const long int matN=OVec[i]->getMat();
+      const size_t matN=static_cast<size_t>(OVec[i]->getMat());
       if (matN)
 	{
-	  const MonteCarlo::Material& matInfo=
-	    DB.getMaterial(static_cast<int>(matN));
-	  const double density=matInfo.getAtomDensity();
-	  const double AMean=matInfo.getMeanA();
-	  sum+=TVec[i]*std::pow(AMean,0.66)*density;
+	  if (matN>=attnTable.size() || attnTable[matN]<0.0)
+	    throw ColErr::InContainerError<size_t>(matN,"matN in attnTable");
+	  const size_t index=static_cast<size_t>
+	    (std::find(matVec.begin(),matVec.end(),matN)-matVec.begin());
+	  if (index==matVec.size())
+	    {
+	      matVec.push_back(matN);
+	      AVec.push_back(meanATable[matN]);
+	      attnVec.push_back(0.0);
+	    }
+	  attnVec[offset+index]+=TVec[i]*attnTable[matN];
 	}
     }
-  
-  return (E>Geometry::zeroTol) ? sum : sum;
+  return;
+}
+
+double
+ObjectTrackAct::getAttnSum(const long int objN,const double E) const
+  /*!
+    Calculate the sum in the material at an energy
+    \param objN :: Cell number to use
+    \param E :: Energy [MeV] : 0 for energy independent
+    \return sum of attenuation
+  */
+{
+  ELog::RegMethod RegA("ObjectTrackAct","getAttnSum(E)");
+
+  if (E<=0.0)
+    return getAttnSum(objN);
+
+  std::vector<double> AVec;
+  std::vector<double> attnVec;
+  getMatAttn(objN,AVec,attnVec);
+
+  double sum(0.0);
+  for(size_t i=0;i<AVec.size();i++)
+    sum+=attnVec[i]*energyFactor(AVec[i],E);
+  return sum;
 }
 
 double
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -33,6 +34,8 @@
 #include <iterator>
 #include <memory>
 #include <array>
+#include <atomic>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -43,6 +46,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "threadSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -73,6 +77,107 @@
 namespace SimProcess
 {
   
+int
+writeSeedDecks(const std::string& Deck,const std::string& seedCard,
+	       const std::vector<std::string>& FName,
+	       const std::vector<std::string>& Card)
+  /*!
+    Write a set of files that are copies of a rendered deck
+    with only the random number seed card changed. The files 
+    are written in parallel.
+    \param Deck :: Deck as written to file 
+    \param seedCard :: Seed card as written in Deck
+    \param FName :: File names
+    \param Card :: Seed card for each file
+    \return 0 if the seed card is not at the start of a line in Deck
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeSeedDecks");
+
+  if (seedCard.empty()) return 0;
+  // seed card is in the physics cards at the end of the deck
+  const size_t pos=Deck.rfind("\n"+seedCard);
+  if (pos==std::string::npos) return 0;
+
+  const char* DPtr=Deck.c_str();
+  const size_t headLen(pos+1);
+  const size_t tailPos(headLen+seedCard.size());
+
+  auto writeUnit=[&](const size_t index)
+    {
+      std::ofstream OX(FName[index].c_str());
+      OX.write(DPtr,static_cast<std::streamsize>(headLen));
+      OX.write(Card[index].c_str(),
+	       static_cast<std::streamsize>(Card[index].size()));
+      OX.write(DPtr+tailPos,
+	       static_cast<std::streamsize>(Deck.size()-tailPos));
+      OX.close();
+      if (OX.fail())
+	throw ColErr::FileError(0,FName[index],"Deck write failed");
+    };
+
+  const size_t nThread=
+    std::min(ThreadSupport::defaultThreads(),FName.size());
+  if (nThread<2)
+    {
+      for(size_t i=0;i<FName.size();i++)
+	writeUnit(i);
+      return 1;
+    }
+  
+  std::atomic<size_t> nextIndex(0);
+  ThreadSupport::runThreads(nThread,[&]()
+    {
+      for(size_t i=nextIndex++;i<FName.size();i=nextIndex++)
+	writeUnit(i);
+    });
+  return 1;
+}
+
+void
+writeSeedSim(SimMCNP& System,const std::string& OName,
+	     const std::vector<long int>& Seed)
+  /*!
+    Writes out many files that differ only by the random
+    number seed. The deck is rendered once and the seed card
+    substituted for each file.
+    \param System :: Simuation object [prepared for write]
+    \param OName :: basic filename [OName1.x etc]
+    \param Seed :: Seed for each file
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeSeedSim");
+
+  if (Seed.empty()) return;
+  
+  physicsSystem::PhysicsCards& PC=System.getPC();
+  std::vector<std::string> FName;
+  std::vector<std::string> Card;
+  for(size_t i=0;i<Seed.size();i++)
+    {
+      std::ostringstream cx;
+      PC.setRND(Seed[i]);
+      PC.writeRND(cx);
+      FName.push_back(OName+std::to_string(i+1)+".x");
+      Card.push_back(cx.str());
+    }
+  
+  PC.setRND(Seed.front());
+  std::ostringstream cx;
+  System.writeDeck(cx);
+  if (!writeSeedDecks(cx.str(),Card.front(),FName,Card))
+    {
+      // seed card not found : full write of each file
+      for(size_t i=0;i<Seed.size();i++)
+	{
+	  PC.setRND(Seed[i]);
+	  System.write(FName[i]);
+	}
+    }
+  PC.setRND(Seed.back());
+  return;
+}
+
 void
 writeMany(SimMCNP& System,const std::string& OName,const int Number)
    /*!
@@ -83,13 +188,20 @@ writeMany(SimMCNP& System,const std::string& OName,const int Number)
      \param Number :: number to write
    */
 {
+  ELog::RegMethod RegA("SimProcess[F]","writeMany");
+  
   physicsSystem::PhysicsCards& PC=System.getPC();
+  // increase the RND seed by 10
+  std::vector<long int> Seed;
+  long int seedValue(PC.getRNDseed());
   for(int i=0;i<Number;i++)
     {
-      System.write(OName+std::to_string(i+1)+".x");
-      // increase the RND seed by 10
-      PC.setRND(PC.getRNDseed()+10);
+      Seed.push_back(seedValue);
+      seedValue+=10;
     }
+  writeSeedSim(System,OName,Seed);
+  if (Number>0)
+    PC.setRND(seedValue);
   return;
 }
 
@@ -118,6 +230,40 @@ writeIndexSim(SimMCNP& System,
   return;
 }
 
+void
+writeMultiSim(SimMCNP& System,
+	      const std::string& OName,
+	      const int multi)
+  /*!
+    Writes out the same files as writeIndexSim for index
+    0 to multi-1 [at least one file] but only renders the
+    deck once.
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of files to write
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSim");
+  
+  physicsSystem::PhysicsCards& PC=System.getPC();
+  // RND seed increased by N*10 for each index N
+  std::vector<long int> Seed;
+  long int seedValue(PC.getRNDseed());
+  int index(0);
+  do
+    {
+      seedValue+=index*10;
+      Seed.push_back(seedValue);
+      index++;
+    }
+  while(index<multi);
+  
+  System.prepareWrite();
+  System.makeObjectsDNForCNF();
+  writeSeedSim(System,OName,Seed);
+  return;
+}
+
 void
 writeIndexSimFLUKA(SimFLUKA& System,
 		   const std::string& OName,
@@ -138,6 +284,56 @@ writeIndexSimFLUKA(SimFLUKA& System,
   
   return;
 }
+
+void
+writeMultiSimFLUKA(SimFLUKA& System,
+		   const std::string& OName,
+		   const int multi)
+  /*!
+    Writes out the same files as writeIndexSimFLUKA for index
+    0 to multi-1 [at least one file] but only renders the
+    deck once. 
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of files to write
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSimFLUKA");
+
+  // RND seed increased by N*11 for each index N
+  std::vector<long int> Seed;
+  std::vector<std::string> FName;
+  std::vector<std::string> Card;
+  long int seedValue(System.getRNDseed());
+  int index(0);
+  do
+    {
+      std::ostringstream cx;
+      seedValue+=index*11;
+      System.setRND(seedValue);
+      System.writeRND(cx);
+      Seed.push_back(seedValue);
+      FName.push_back(OName+std::to_string(index+1)+".inp");
+      Card.push_back(cx.str());
+      index++;
+    }
+  while(index<multi);
+  
+  System.prepareWrite();
+  System.setRND(Seed.front());
+  std::ostringstream cx;
+  System.writeDeck(cx);
+  if (!writeSeedDecks(cx.str(),Card.front(),FName,Card))
+    {
+      for(size_t i=0;i<Seed.size();i++)
+	{
+	  System.setRND(Seed[i]);
+	  System.write(FName[i]);
+	}
+    }
+  System.setRND(Seed.back());
+  return;
+}
   
 void
 writeIndexSimPHITS(SimPHITS& System,const std::string& FName,
@@ -30,7 +30,11 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <array>
 #include <memory>
+#include <atomic>
+#include <functional>
+#include <algorithm>
 #include <boost/format.hpp>
 
 #include "Exception.h"
@@ -42,6 +46,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "threadSupport.h"
 #include "mathSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
@@ -67,6 +72,7 @@
 #include "Simulation.h"
 #include "SimMCNP.h"
 #include "LineTrack.h"
+#include "SimTrack.h"
 #include "volUnit.h"
 #include "VolSum.h"
 
@@ -79,8 +85,10 @@ VolSum::VolSum(const Geometry::Vec3D& OPt,
 	       const Geometry::Vec3D& AxisRange) : 
   Origin(OPt),X(std::abs(AxisRange[0]),0,0),
   Y(0,std::abs(AxisRange[1]),0),Z(0,0,std::abs(AxisRange[2])),
-  fullVol(0.0),totalDist(0),nTracks(0)
-  /*!g
+  fullVol(0.0),totalDist(0),nTracks(0),
+  sampleType(volType::random),nStrata({10,10,10}),
+  batchSize(10000),nThread(0),seed(1)
+  /*!
     Constructor
     \param OPt :: Centre
     \param AxisRange :: X/Y/Z extent
@@ -91,7 +99,9 @@ VolSum::VolSum(const VolSum& A) :
   Origin(A.Origin),X(A.X),Y(A.Y),Z(A.Z),
   fracX(A.fracX),fracY(A.fracY),
   fullVol(A.fullVol),totalDist(A.totalDist),
-  nTracks(A.nTracks),tallyVols(A.tallyVols)
+  nTracks(A.nTracks),tallyVols(A.tallyVols),
+  sampleType(A.sampleType),nStrata(A.nStrata),
+  batchSize(A.batchSize),nThread(A.nThread),seed(A.seed)
   /*!
     Copy constructor
     \param A :: VolSum to copy
@@ -116,6 +126,11 @@ VolSum::operator=(const VolSum& A)
       totalDist=A.totalDist;
       nTracks=A.nTracks;
       tallyVols=A.tallyVols;
+      sampleType=A.sampleType;
+      nStrata=A.nStrata;
+      batchSize=A.batchSize;
+      nThread=A.nThread;
+      seed=A.seed;
     }
   return *this;
 }
@@ -294,6 +309,80 @@ VolSum::reset()
   return;
 }
 
+void
+VolSum::setSampleType(const volType& T)
+  /*!
+    Set the point sampling method of sampleRun
+    \param T :: Sampling method
+  */
+{
+  sampleType=T;
+  return;
+}
+
+void
+VolSum::setStrata(const size_t NX,const size_t NY,const size_t NZ)
+  /*!
+    Set the sub-grid for stratified sampling : each batch
+    is one point in each sub-box
+    \param NX :: Number of x divisions
+    \param NY :: Number of y divisions
+    \param NZ :: Number of z divisions
+  */
+{
+  ELog::RegMethod RegA("VolSum","setStrata");
+
+  if (!NX || !NY || !NZ)
+    throw ColErr::EmptyValue<size_t>("Zero strata");
+  nStrata={NX,NY,NZ};
+  return;
+}
+
+void
+VolSum::setBatchSize(const size_t N)
+  /*!
+    Set the number of points in a batch [not strat]
+    \param N :: Number of points
+  */
+{
+  ELog::RegMethod RegA("VolSum","setBatchSize");
+
+  if (!N)
+    throw ColErr::EmptyValue<size_t>("Zero batch size");
+  batchSize=N;
+  return;
+}
+
+void
+VolSum::endBatch(const size_t N)
+  /*!
+    Close a batch in all the tallies
+    \param N :: Number of points/tracks in the batch
+  */
+{
+  if (!N) return;
+  const double D(1.0/static_cast<double>(N));
+  for(tvTYPE::value_type& TV : tallyVols)
+    TV.second.endBatch(D);
+  return;
+}
+
+double
+VolSum::maxError() const
+  /*!
+    Get the largest relative error of the tallies.
+    Tallies with no contribution are skipped since their
+    error cannot fall [e.g. cells outside the sample volume]
+    \return max relative error
+  */
+{
+  double maxErr(0.0);
+  for(const tvTYPE::value_type& TV : tallyVols)
+    if (!TV.second.isEmpty())
+      maxErr=std::max(maxErr,TV.second.calcError());
+  return maxErr;
+}
+
 void
 VolSum::pointRun(const Simulation& System,const size_t N) 
   /*!
@@ -311,6 +400,9 @@ VolSum::pointRun(const Simulation& System,const size_t N)
   // Note for sphere that you can use X,Y,Z in any orthogonal 
   // directiron
 
+  // ten batches for the error estimate
+  const size_t BSize((N+9)/10);
+  size_t batchStart(0);
   for(size_t i=0;i<N;i++)
     { 
       Geometry::Vec3D Pt(Origin+
@@ -318,12 +410,241 @@ VolSum::pointRun(const Simulation& System,const size_t N)
 			 Y*(RNG.rand()-0.5)+
 			 Z*(RNG.rand()-0.5));
       OPtr=System.findCell(Pt,OPtr);
-      addDistance(OPtr->getName(),1.0);
+      if (OPtr)
+	addDistance(OPtr->getName(),1.0);
+      if (i+1-batchStart==BSize || i+1==N)
+	{
+	  endBatch(i+1-batchStart);
+	  batchStart=i+1;
+	}
     }
   nTracks+=N;
   return;
 }
 
+double
+VolSum::radicalInverse(size_t index,const size_t base)
+  /*!
+    Van der Corput radical inverse of an index
+    \param index :: Index of sequence
+    \param base :: Prime base
+    \return value [0-1)
+  */
+{
+  const double invBase(1.0/static_cast<double>(base));
+  double fraction(invBase);
+  double Out(0.0);
+  while(index)
+    {
+      Out+=static_cast<double>(index % base)*fraction;
+      index/=base;
+      fraction*=invBase;
+    }
+  return Out;
+}
+
+void
+VolSum::sobolPoint(const size_t index,double* U)
+  /*!
+    Get a point of the three dimensional Sobol sequence 
+    [Joe-Kuo direction numbers]. The index order is not 
+    the gray code order but each block of 2^m points
+    is the same set.
+    \param index :: Index of sequence
+    \param U :: three values [0-1) [output]
+  */
+{
+  static const std::array<std::array<uint32_t,32>,3> V=[]()
+    {
+      std::array<std::array<uint32_t,32>,3> Out;
+      // dim 0 : van der Corput base 2
+      for(size_t i=0;i<32;i++)
+	Out[0][i]=static_cast<uint32_t>(1U << (31-i));
+      // dim 1 : s=1 a=0 m={1} / dim 2 : s=2 a=1 m={1,3}
+      Out[1][0]=1U << 31;
+      Out[2][0]=1U << 31;
+      Out[2][1]=3U << 30;
+      for(size_t i=1;i<32;i++)
+	Out[1][i]=Out[1][i-1] ^ (Out[1][i-1] >> 1);
+      for(size_t i=2;i<32;i++)
+	Out[2][i]=Out[2][i-2] ^ (Out[2][i-2] >> 2) ^ Out[2][i-1];
+      return Out;
+    }();
+
+  uint32_t XV[3]={0,0,0};
+  size_t N(index);
+  for(size_t i=0;N && i<32;i++,N>>=1)
+    if (N & 1)
+      for(size_t j=0;j<3;j++)
+	XV[j]^=V[j][i];
+
+  for(size_t j=0;j<3;j++)
+    U[j]=static_cast<double>(XV[j])/4294967296.0;
+  return;
+}
+
+size_t
+VolSum::getBatchSize() const
+  /*!
+    Get the number of points in a batch
+    \return batch size [strata size if stratified]
+  */
+{
+  return (sampleType==volType::strat) ?
+    nStrata[0]*nStrata[1]*nStrata[2] : batchSize;
+}
+
+void
+VolSum::batchPoints(const size_t bIndex,
+		    std::vector<Geometry::Vec3D>& Pts) const
+  /*!
+    Get the points of a batch. The points depend only on the
+    batch index so batches can be run in any order/thread.
+    \param bIndex :: Batch index
+    \param Pts :: Points [output]
+  */
+{
+  const size_t BSize=getBatchSize();
+  Pts.resize(BSize);
+
+  double U[3];
+  if (sampleType==volType::halton || sampleType==volType::sobol)
+    {
+      for(size_t i=0;i<BSize;i++)
+	{
+	  const size_t index(bIndex*BSize+i);
+	  if (sampleType==volType::sobol)
+	    sobolPoint(index,U);
+	  else
+	    {
+	      U[0]=radicalInverse(index+1,2);
+	      U[1]=radicalInverse(index+1,3);
+	      U[2]=radicalInverse(index+1,5);
+	    }
+	  Pts[i]=Origin+X*(U[0]-0.5)+Y*(U[1]-0.5)+Z*(U[2]-0.5);
+	}
+      return;
+    }
+
+  // separate stream for each batch
+  MTRand RX(static_cast<MTRand::uint32>(seed+bIndex));
+  if (sampleType==volType::strat)
+    {
+      size_t index(0);
+      for(size_t i=0;i<nStrata[0];i++)
+	for(size_t j=0;j<nStrata[1];j++)
+	  for(size_t k=0;k<nStrata[2];k++)
+	    {
+	      U[0]=(static_cast<double>(i)+RX.rand())/
+		static_cast<double>(nStrata[0]);
+	      U[1]=(static_cast<double>(j)+RX.rand())/
+		static_cast<double>(nStrata[1]);
+	      U[2]=(static_cast<double>(k)+RX.rand())/
+		static_cast<double>(nStrata[2]);
+	      Pts[index++]=Origin+X*(U[0]-0.5)+Y*(U[1]-0.5)+Z*(U[2]-0.5);
+	    }
+      return;
+    }
+  
+  for(size_t i=0;i<BSize;i++)
+    {
+      U[0]=RX.rand();
+      U[1]=RX.rand();
+      U[2]=RX.rand();
+      Pts[i]=Origin+X*(U[0]-0.5)+Y*(U[1]-0.5)+Z*(U[2]-0.5);
+    }
+  return;
+}
+
+size_t
+VolSum::sampleRun(const Simulation& System,const size_t NMax,
+		  const double targetErr) 
+  /*!
+    Calculate the volumes by point sampling in batches. 
+    The run stops when the relative error of every tally 
+    is below targetErr or NMax points are used. Each batch 
+    has its own point stream and the batches are added in 
+    order, so the result does not depend on the number of threads.
+    \param System :: Simulation to use
+    \param NMax :: Maximum number of points
+    \param targetErr :: Relative error to stop at [0 to run NMax]
+    \return number of points used
+  */
+{
+  ELog::RegMethod RegA("VolSum","sampleRun");
+
+  // batches before the error estimate is used
+  // [and before an unhit tally is taken as empty]
+  const size_t minBatch(5);
+  
+  reset();
+  fullVol=X.abs()*Y.abs()*Z.abs();
+
+  const size_t BSize=getBatchSize();
+  const size_t maxBatch=std::max<size_t>(1,(NMax+BSize-1)/BSize);
+  const size_t NT=std::max<size_t>(1,nThread);
+
+  size_t bIndex(0);
+  while(bIndex<maxBatch)
+    {
+      const size_t nRound(std::min(NT,maxBatch-bIndex));
+      std::vector<std::map<int,double>> CellCount(nRound);
+
+      auto runBatch=[&](const size_t i)
+	{
+	  std::vector<Geometry::Vec3D> Pts;
+	  batchPoints(bIndex+i,Pts);
+	  MonteCarlo::Object* OPtr(0);
+	  for(const Geometry::Vec3D& Pt : Pts)
+	    {
+	      OPtr=System.findCell(Pt,OPtr);
+	      if (OPtr)
+		CellCount[i][OPtr->getName()]+=1.0;
+	    }
+	};
+      
+      if (nRound<2)
+	runBatch(0);
+      else
+	{
+	  std::atomic<size_t> nextBatch(0);
+	  ThreadSupport::runThreads(nRound,[&]()
+	    {
+	      ModelSupport::SimTrack::Instance().addSim(&System);
+	      for(size_t i=nextBatch++;i<nRound;i=nextBatch++)
+		runBatch(i);
+	    });
+	}
+
+      for(size_t i=0;i<nRound;i++)
+	{
+	  for(const std::map<int,double>::value_type& CC : CellCount[i])
+	    addDistance(CC.first,CC.second);
+	  endBatch(BSize);
+	  nTracks+=BSize;
+	  bIndex++;
+	  if (targetErr>0.0 && bIndex>=minBatch &&
+	      maxError()<=targetErr)
+	    {
+	      // unhit tallies are not in maxError
+	      std::vector<int> unHit;
+	      for(const tvTYPE::value_type& TV : tallyVols)
+		if (TV.second.isEmpty())
+		  unHit.push_back(TV.first);
+	      if (!unHit.empty())
+		{
+		  ELog::EM<<"Tallies with no contribution :";
+		  for(const int TN : unHit)
+		    ELog::EM<<" "<<TN;
+		  ELog::EM<<ELog::endWarn;
+		}
+	      return nTracks;
+	    }
+	}
+    }
+  return nTracks;
+}
+
 Geometry::Vec3D
 VolSum::getCubePoint() const
   /*!
@@ -384,6 +705,9 @@ VolSum::trackRun(const Simulation& System,const size_t N)
   // Note for sphere that you can use X,Y,Z in any orthogonal 
   // directiron
 
+  // ten batches for the error estimate
+  const size_t BSize((N+9)/10);
+  size_t batchStart(0);
   for(size_t i=0;i<N;i++)
     {
       const Geometry::Vec3D Pt=getCubePoint();
@@ -402,6 +726,11 @@ VolSum::trackRun(const Simulation& System,const size_t N)
 
       const double trackDistance=Pt.Distance(XPt);
       totalDist+=trackDistance;
+      if (i+1-batchStart==BSize || i+1==N)
+	{
+	  endBatch(i+1-batchStart);
+	  batchStart=i+1;
+	}
     }
   ELog::EM<<"Total Dist == "<<totalDist<<ELog::endTrace;  
   nTracks+=N;
@@ -427,6 +756,22 @@ VolSum::calcVolume(const int TN) const
   return 0.0;
 }
 
+double
+VolSum::calcError(const int TN) const
+  /*!
+    Calcuate the relative error of the volume of a tally unit
+    \param TN :: Tally number
+    \return relative error
+   */
+{
+  ELog::RegMethod RegA("VolSum","calcError");
+
+  tvTYPE::const_iterator mc=tallyVols.find(TN);
+  if (mc==tallyVols.end())
+    throw ColErr::InContainerError<int>(TN,"Tally number");
+  return mc->second.calcError();
+}
+
 
 void 
 VolSum::write(const std::string& OFile) const
@@ -436,12 +781,12 @@ VolSum::write(const std::string& OFile) const
   */
 {
   ELog::RegMethod RegA("VolSum","write");
-  boost::format FMTI3("%3d  %11.5e %c  mat%3d %s");
+  boost::format FMTI3("%3d  %11.5e %8.2e %c  mat%3d %s");
   
   std::ofstream OX(OFile.c_str());
   
-  OX<<"FluxName   Volume(cc)  Sf Matrl  Description"<<std::endl;
-  OX<<"========  ============ == ====== "
+  OX<<"FluxName   Volume(cc)   RelErr  Sf Matrl  Description"<<std::endl;
+  OX<<"========  ============ ======== == ====== "
     <<"================================================ "<<std::endl;
 
   char sf='a';  
@@ -451,7 +796,7 @@ VolSum::write(const std::string& OFile) const
     {
       OX<<"tally"<<(FMTI3 % mc->first % 
 		    (fullVol*mc->second.calcVol(1.0/nT)) %
-		    sf % mc->second.getMat() % 
+		    mc->second.calcError() % sf % mc->second.getMat() % 
 		    mc->second.getComment())<<std::endl;
       sf++;
     }
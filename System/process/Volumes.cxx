@@ -25,6 +25,7 @@
 #include <cmath>
 #include <complex> 
 #include <vector>
+#include <array>
 #include <map> 
 #include <list> 
 #include <set>
@@ -90,7 +91,16 @@ calcVolumes(Simulation* SimPtr,const mainSystem::inputParam& IParam)
 	  VTally.populateTally(*SMPtr);
 	}
 
-      VTally.pointRun(*SimPtr,NP);
+      if (IParam.flag("volType") || IParam.flag("volErr") ||
+	  IParam.flag("volThread"))
+	{
+	  setSampling(IParam,VTally);
+	  const double targetErr=IParam.getDefValue<double>(0.0,"volErr");
+	  const size_t NUsed=VTally.sampleRun(*SimPtr,NP,targetErr);
+	  ELog::EM<<"Volume points used == "<<NUsed<<ELog::endDiag;
+	}
+      else
+	VTally.pointRun(*SimPtr,NP);
       ELog::EM<<"Volume == "<<Org<<" : "<<XYZ<<" : "<<NP<<ELog::endDiag;
       VTally.write("volumes");
     }
@@ -98,6 +108,41 @@ calcVolumes(Simulation* SimPtr,const mainSystem::inputParam& IParam)
   return;
 }
 
+void
+setSampling(const mainSystem::inputParam& IParam,VolSum& VTally)
+  /*!
+    Set the sampling method of the volume calculation :
+    -volType random/halton/sobol/strat [nStrata]
+    The batch streams are seeded from -random.
+    \param IParam :: Input stream
+    \param VTally :: Tally to set
+   */
+{
+  ELog::RegMethod RegA("Volumes[F]","setSampling");
+
+  const std::string VType=
+    IParam.getDefValue<std::string>("random","volType",0);
+  if (VType=="random")
+    VTally.setSampleType(VolSum::volType::random);
+  else if (VType=="halton")
+    VTally.setSampleType(VolSum::volType::halton);
+  else if (VType=="sobol")
+    VTally.setSampleType(VolSum::volType::sobol);
+  else if (VType=="strat")
+    {
+      VTally.setSampleType(VolSum::volType::strat);
+      const size_t NS=IParam.getDefValue<size_t>(10,"volType",1);
+      VTally.setStrata(NS,NS,NS);
+    }
+  else
+    throw ColErr::InContainerError<std::string>(VType,"volType");
+
+  VTally.setThreads(IParam.getDefValue<size_t>(1,"volThread"));
+  VTally.setSeed(static_cast<unsigned int>
+		 (IParam.getValue<long int>("random")));
+  return;
+}
+
 void
 populateCells(const Simulation& System,
 	      const mainSystem::inputParam& IParam,
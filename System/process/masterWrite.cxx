@@ -30,16 +30,15 @@
 #include <set>
 #include <map>
 #include <string>
-#include <boost/format.hpp>
+#include <cstdio>
+#include <algorithm>
 
 #include "Exception.h"
 #include "Vec3D.h"
 #include "masterWrite.h"
 
 masterWrite::masterWrite() :
-  zeroTol(1e-20),sigFig(6),
-  FMTdouble("%1.6g"),
-  FMTinteger("%1d")
+  zeroTol(1e-20),sigFig(6)
   /*!
     Constructor
   */
@@ -63,12 +62,9 @@ masterWrite::setSigFig(const size_t S)
     \param S :: Significant figures
   */
 {
-  if (S==0)
-    throw ColErr::IndexError<size_t>(S,0,"masterWrite::setSigFig");
-  std::ostringstream cx;
-  cx<<"\%1."<<S<<"g";
-  sigFig=S; 
-  FMTdouble=boost::format(cx.str());
+  if (S==0 || S>50)
+    throw ColErr::RangeError<size_t>(S,1,50,"masterWrite::setSigFig");
+  sigFig=static_cast<int>(S); 
   return;
 }
 
@@ -83,69 +79,137 @@ masterWrite::setZero(const double Z)
   return;
 }
 
+size_t
+masterWrite::writeNum(char* Out,const size_t len,const double& D) const
+  /*!
+    Write a double into a buffer [%g at sigFig]
+    \param Out :: Buffer [null terminated]
+    \param len :: Size of buffer [bufSize holds any number]
+    \param D :: number to process
+    \return number of characters written
+   */
+{
+  const int N=(std::abs(D)<zeroTol) ?
+    std::snprintf(Out,len,"0.0") :
+    std::snprintf(Out,len,"%.*g",sigFig,D);
+  return std::min(static_cast<size_t>(N),len-1);
+}
+
+size_t
+masterWrite::writeNum(char* Out,const size_t len,const int& I) const
+  /*!
+    Write an integer into a buffer
+    \param Out :: Buffer [null terminated]
+    \param len :: Size of buffer
+    \param I :: integer to write
+    \return number of characters written
+   */
+{
+  const int N=std::snprintf(Out,len,"%d",I);
+  return std::min(static_cast<size_t>(N),len-1);
+}
+
+size_t
+masterWrite::writeNum(char* Out,const size_t len,const size_t& I) const
+  /*!
+    Write an unsigned integer into a buffer
+    \param Out :: Buffer [null terminated]
+    \param len :: Size of buffer
+    \param I :: integer to write
+    \return number of characters written
+   */
+{
+  const int N=std::snprintf(Out,len,"%lu",static_cast<unsigned long>(I));
+  return std::min(static_cast<size_t>(N),len-1);
+}
+
+size_t
+masterWrite::writeNum(char* Out,const size_t len,
+		      const Geometry::Vec3D& V,const char sep) const
+  /*!
+    Write a vector into a buffer
+    \param Out :: Buffer [null terminated : 3*bufSize holds any vector]
+    \param len :: Size of buffer
+    \param V :: Vector to write
+    \param sep :: Separator between components
+    \return number of characters written
+   */
+{
+  size_t N(0);
+  for(size_t i=0;i<3 && N+1<len;i++)
+    {
+      if (i)
+	{
+	  Out[N++]=sep;
+	  Out[N]=0;
+	}
+      N+=writeNum(Out+N,len-N,V[i]);
+    }
+  return N;
+}
+
 std::string
-masterWrite::Num(const double& D)
+masterWrite::Num(const double& D) const
   /*!
     Write out a specific double
     \param D :: number to process
     \return formated number / 0.0 
    */
 {
-  if (std::abs(D)<zeroTol)
-    return "0.0";
-
-  return (FMTdouble % D).str();
+  char Out[bufSize];
+  return std::string(Out,writeNum(Out,bufSize,D));
 }
   
 std::string
-masterWrite::Num(const int& I)
+masterWrite::Num(const int& I) const
   /*!
-    Write out a specific double
+    Write out a specific integer
     \param I :: integer to write
     \return formated number
   */
 {
-  return (FMTinteger % I).str();
+  char Out[bufSize];
+  return std::string(Out,writeNum(Out,bufSize,I));
 }
 
 std::string
-masterWrite::Num(const Geometry::Vec3D& V)
+masterWrite::Num(const size_t& I) const
   /*!
-    Write out a specific double
+    Write out a specific unsigned integer
+    \param I :: integer to write
+    \return formated number
+  */
+{
+  char Out[bufSize];
+  return std::string(Out,writeNum(Out,bufSize,I));
+}
+
+std::string
+masterWrite::Num(const Geometry::Vec3D& V) const
+  /*!
+    Write out a vector [space separated]
     \param V :: Vector to write
     \return formated number
   */
 {
-  std::string Out;
-  for(int i=0;i<3;i++)
-    {
-      Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
-      if (i!=2) Out+=" ";
-    }
-  return Out;
+  char Out[3*bufSize];
+  return std::string(Out,writeNum(Out,3*bufSize,V,' '));
 }
 
 std::string
-masterWrite::NumComma(const Geometry::Vec3D& V)
+masterWrite::NumComma(const Geometry::Vec3D& V) const
   /*!
-    Write out a specific double
+    Write out a vector [comma separated]
     \param V :: Vector to write
     \return formated number
   */
 {
-  std::string Out;
-  for(int i=0;i<3;i++)
-    {
-      Out +=(fabs(V[i])<zeroTol) ? "0.0" :
-	(FMTdouble % V[i]).str();
-      if (i!=2) Out+=",";
-    }
-  return Out;
+  char Out[3*bufSize];
+  return std::string(Out,writeNum(Out,3*bufSize,V,','));
 }
 
 std::string
-masterWrite::NameNoDot(std::string V)
+masterWrite::NameNoDot(std::string V) const
   /*!
     Write out a name without "." which is
     forbidden in povray
@@ -161,7 +225,7 @@ masterWrite::NameNoDot(std::string V)
 
 template<typename T>
 std::string
-masterWrite::padNum(const T& V,const size_t len)
+masterWrite::padNum(const T& V,const size_t len) const
   /*!
     Write out a padded string
     \param V :: Value
@@ -169,15 +233,17 @@ masterWrite::padNum(const T& V,const size_t len)
     \return Num(T) + spaces to length
    */
 {
-  std::string Out=Num(V);
-  if (Out.size()<len)
-    Out+=std::string(len-Out.size(),' ');
-  return Out;
+  char Out[bufSize];
+  const size_t N=writeNum(Out,bufSize,V);
+  std::string PStr(Out,N);
+  if (N<len)
+    PStr.append(len-N,' ');
+  return PStr;
 }
 
 template<>
 std::string
-masterWrite::padNum(const Geometry::Vec3D& V,const size_t len)
+masterWrite::padNum(const Geometry::Vec3D& V,const size_t len) const
   /*!
     Write out a padded string for a vec
     \param V :: Value
@@ -185,19 +251,23 @@ masterWrite::padNum(const Geometry::Vec3D& V,const size_t len)
     \return Num(Vec3D) + spaces to length
    */ 
 {
-  std::string Out;
+  char Out[bufSize];
+  std::string PStr;
+  PStr.reserve(3*(len+1));
   for(size_t i=0;i<3;i++)
     {
-      Out += padNum(V[i],len);
-      if (i!=2) Out+=" ";
+      const size_t N=writeNum(Out,bufSize,V[i]);
+      PStr.append(Out,N);
+      if (N<len)
+	PStr.append(len-N,' ');
+      if (i!=2) PStr+=' ';
     }
-  return Out;
- 
+  return PStr;
 }
 
 ///\cond TEMPLATE
 
-template std::string masterWrite::padNum(const double&,const size_t);
-template std::string masterWrite::padNum(const int&,const size_t);
+template std::string masterWrite::padNum(const double&,const size_t) const;
+template std::string masterWrite::padNum(const int&,const size_t) const;
 
 ///\endcond TEMPLATE
@@ -172,7 +172,8 @@ equalSurface(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  SMAP CandMap;
+  return FTYPE::dispatch(Index,SPtr,SurI.equalMap(SPtr,CandMap));
 }
 
 Geometry::Surface*
@@ -194,7 +195,8 @@ equalSurface(Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  return FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  SMAP CandMap;
+  return FTYPE::dispatch(Index,SPtr,SurI.equalMap(SPtr,CandMap));
 }
 
 
@@ -244,7 +246,9 @@ equalSurfNum(const Geometry::Surface* SPtr)
     EqualSurface<boost::mpl::_1 , boost::mpl::_2,const Geometry::Surface*> >::type FTYPE;
   
   ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
-  const Geometry::Surface* OutPtr=FTYPE::dispatch(Index,SPtr,SurI.surMap());
+  SMAP CandMap;
+  const Geometry::Surface* OutPtr=
+    FTYPE::dispatch(Index,SPtr,SurI.equalMap(SPtr,CandMap));
   return OutPtr->getName();
 }
 
@@ -58,7 +58,8 @@ operator<<(std::ostream& OX,const volUnit& A)
 }
 
 volUnit::volUnit() : 
-  npts(0),lineSum(0.0),matNum(0)
+  npts(0),lineSum(0.0),batchStart(0.0),nBatch(0),
+  sumF(0.0),sumFSqr(0.0),matNum(0)
   /*!
     Constructor
   */
@@ -67,7 +68,8 @@ volUnit::volUnit() :
 
 volUnit::volUnit(const int MN,const std::string& CM,
 		 const std::vector<int>& CList) : 
-  npts(0),lineSum(0.0),comment(CM),matNum(MN)
+  npts(0),lineSum(0.0),batchStart(0.0),nBatch(0),
+  sumF(0.0),sumFSqr(0.0),comment(CM),matNum(MN)
   /*!
     Constructor
     \param MN :: Material number
@@ -80,7 +82,8 @@ volUnit::volUnit(const int MN,const std::string& CM,
 
 volUnit::volUnit(const volUnit& A) : 
   npts(A.npts),cells(A.cells),lineSum(A.lineSum),
-  comment(A.comment),matNum(A.matNum)
+  batchStart(A.batchStart),nBatch(A.nBatch),sumF(A.sumF),
+  sumFSqr(A.sumFSqr),comment(A.comment),matNum(A.matNum)
   /*!
     Copy constructor
     \param A :: volUnit to copy
@@ -100,6 +103,10 @@ volUnit::operator=(const volUnit& A)
       npts=A.npts;
       cells=A.cells;
       lineSum=A.lineSum;
+      batchStart=A.batchStart;
+      nBatch=A.nBatch;
+      sumF=A.sumF;
+      sumFSqr=A.sumFSqr;
       comment=A.comment;
       matNum=A.matNum;
     }
@@ -182,9 +189,45 @@ volUnit::reset()
 {
   npts=0;
   lineSum=0.0;
+  batchStart=0.0;
+  nBatch=0;
+  sumF=0.0;
+  sumFSqr=0.0;
   return;
 }
 
+void
+volUnit::endBatch(const double D)
+  /*!
+    Close a batch of tracks/points : the batch estimate
+    is the sum added since the last batch
+    \param D :: Track divider of the batch [1/nTracks in batch]
+  */
+{
+  const double F=D*(lineSum-batchStart);
+  sumF+=F;
+  sumFSqr+=F*F;
+  nBatch++;
+  batchStart=lineSum;
+  return;
+}
+
+double
+volUnit::calcError() const
+  /*!
+    Calculate the relative error of the volume from the 
+    spread of the batch estimates
+    \return relative error [1.0 if no contributions]
+  */
+{
+  if (nBatch<2 || sumF<=0.0) return 1.0;
+
+  const double NB(static_cast<double>(nBatch));
+  const double mean(sumF/NB);
+  const double var((sumFSqr/NB-mean*mean)/(NB-1.0));
+  return (var>0.0) ? std::sqrt(var)/mean : 0.0;
+}
+
 double
 volUnit::calcVol(const double D) const
   /*!
@@ -83,6 +83,8 @@ class ObjSurfMap
   
   void removeReverseSurf(const int,const int);
   void removeObject(const MonteCarlo::Object*);
+  void renumberSurf(const std::map<int,int>&);
+  void renumberCell(const std::map<int,int>&);
 
   void write(const std::string&) const;
   void write(std::ostream&) const;
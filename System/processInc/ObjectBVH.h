@@ -0,0 +1,95 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   processInc/ObjectBVH.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_ObjectBVH_h
+#define ModelSupport_ObjectBVH_h
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class ObjectBVH
+  \version 1.0
+  \author S. Ansell
+  \date June 2018
+  \brief Bounding volume hierarchy of cells for point location
+
+  Each non-placeholder cell is held with its conservative
+  axis-aligned box [Object::getBoundBox]. Cells with a finite
+  box are placed in a binary tree (median split on the longest
+  axis); unbounded cells are held in a separate list that is
+  always tested.
+*/
+
+class ObjectBVH
+{
+ private:
+
+  /// Tree node
+  struct bvhNode
+  {
+    Geometry::BoundBox Box;   ///< Box enclosing all items below
+    size_t index;             ///< First item [leaf] / right child [branch]
+    size_t count;             ///< Number of items [0 for branch]
+  };
+
+  static const size_t leafSize=4;              ///< Max items in a leaf
+
+  int active;                                  ///< Tree is built
+  std::vector<bvhNode> Nodes;                  ///< Tree [0 is root]
+  std::vector<Geometry::BoundBox> ItemBox;     ///< Boxes of bounded items
+  std::vector<MonteCarlo::Object*> Items;      ///< Bounded objects
+  std::vector<MonteCarlo::Object*> Unbound;    ///< Unbounded objects
+
+  size_t buildNode(const size_t,const size_t);
+
+ public:
+
+  ObjectBVH();
+  ObjectBVH(const ObjectBVH&);
+  ObjectBVH& operator=(const ObjectBVH&);
+  ~ObjectBVH() {}          ///< Destructor
+
+  /// Is the tree built
+  int isActive() const { return active; }
+  /// Number of unbounded objects
+  size_t nUnbound() const { return Unbound.size(); }
+  /// Number of bounded objects
+  size_t nBound() const { return Items.size(); }
+
+  void clearAll();
+  void build(const std::map<int,MonteCarlo::Object*>&);
+
+  void getCandidates(const Geometry::Vec3D&,
+		     std::vector<MonteCarlo::Object*>&) const;
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&) const;
+
+  void write(std::ostream&) const;
+};
+
+}
+
+#endif
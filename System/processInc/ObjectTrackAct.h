@@ -74,8 +74,14 @@ class ObjectTrackAct
 
   double getMatSum(const long int) const;
 
+  static double energyFactor(const double,const double);
+  static std::vector<double> getAttnTable(const double);
+  
   double getAttnSum(const long int) const;
   double getAttnSum(const long int,const double) const;
+  double getAttnSum(const long int,const std::vector<double>&) const;
+  void getMatAttn(const long int,std::vector<double>&,
+		  std::vector<double>&) const;
   double getDistance(const long int) const;
 
   /// Debug function effectivley
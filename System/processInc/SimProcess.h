@@ -39,10 +39,17 @@ class FuncDataBase;
 namespace SimProcess
 {
 
+  int writeSeedDecks(const std::string&,const std::string&,
+		     const std::vector<std::string>&,
+		     const std::vector<std::string>&);
+  void writeSeedSim(SimMCNP&,const std::string&,
+		    const std::vector<long int>&);
   void writeMany(SimMCNP&,const std::string&,const int);
   void writeIndexSim(SimMCNP&,const std::string&,const int);
+  void writeMultiSim(SimMCNP&,const std::string&,const int);
   void writeIndexSimPHITS(SimPHITS&,const std::string&,const int);
   void writeIndexSimFLUKA(SimFLUKA&,const std::string&,const int);
+  void writeMultiSimFLUKA(SimFLUKA&,const std::string&,const int);
 
   template<typename T>
   T getDefVar(const FuncDataBase&,const std::string&,const T&);
@@ -41,6 +41,12 @@ namespace ModelSupport
 						
 class VolSum
 {
+ public:
+
+  /// Point sampling method for sampleRun
+  enum class volType : int
+  { random=0,halton=1,sobol=2,strat=3 };
+  
  private:
   
   /// tally volume type
@@ -60,7 +66,20 @@ class VolSum
    
   tvTYPE tallyVols;                         ///< TallyNum:Volumes
 
+  volType sampleType;                       ///< Sampling method
+  std::array<size_t,3> nStrata;             ///< Strata in x/y/z
+  size_t batchSize;                         ///< Points per batch
+  size_t nThread;                           ///< Threads [0/1 serial]
+  unsigned int seed;                        ///< Base seed of batches
+
   Geometry::Vec3D getCubePoint() const;
+
+  static double radicalInverse(size_t,const size_t);
+  static void sobolPoint(const size_t,double*);
+  size_t getBatchSize() const;
+  void batchPoints(const size_t,std::vector<Geometry::Vec3D>&) const;
+  void endBatch(const size_t);
+  double maxError() const;
   
  public:
   
@@ -70,6 +89,15 @@ class VolSum
   ~VolSum();
 
   void reset();
+
+  void setSampleType(const volType&);
+  void setStrata(const size_t,const size_t,const size_t);
+  void setBatchSize(const size_t);
+  /// Set the number of threads for sampleRun
+  void setThreads(const size_t N) { nThread=N; }
+  /// Set the base seed for sampleRun
+  void setSeed(const unsigned int S) { seed=S; }
+  
   void addDistance(const int,const double);
   void addFlux(const int,const double&,const double&);
   
@@ -79,7 +107,9 @@ class VolSum
 
   void trackRun(const Simulation&,const size_t);
   void pointRun(const Simulation&,const size_t);
+  size_t sampleRun(const Simulation&,const size_t,const double);
   double calcVolume(const int) const;
+  double calcError(const int) const;
   void populateTally(const SimMCNP&);
   void populateAll(const Simulation&);
   void populateVSet(const Simulation&,const std::vector<int>&);
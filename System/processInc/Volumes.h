@@ -27,6 +27,7 @@ namespace ModelSupport
   class VolSum;
   
   void calcVolumes(Simulation*,const mainSystem::inputParam&);
+  void setSampling(const mainSystem::inputParam&,VolSum&);
   void populateCells(const Simulation&,const mainSystem::inputParam&,
 		     VolSum&);
 
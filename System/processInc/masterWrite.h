@@ -28,6 +28,10 @@
   \date February 2011
   \author S. Ansell
   \brief Controls the tolerance of output
+
+  Numbers are formatted with snprintf into a caller
+  buffer [writeNum]. The string functions are wrappers
+  on that.
 */
 
 class masterWrite
@@ -35,10 +39,7 @@ class masterWrite
  private:
 
   double zeroTol;         ///< All numbers below this value are zero
-  size_t sigFig;             ///< Number of significant figures
-  
-  boost::format FMTdouble;       ///< Format statement for double output
-  boost::format FMTinteger;      ///< Format statement for integer
+  int sigFig;             ///< Number of significant figures
 
   masterWrite();
 
@@ -48,6 +49,9 @@ class masterWrite
   ///\endcond SINGLETON
 
  public:
+
+  /// Buffer size that holds any number [sigFig<=50]
+  static const size_t bufSize=64;
   
   /// Desctructor
   ~masterWrite() {} 
@@ -58,17 +62,23 @@ class masterWrite
   void setZero(const double);
 
   /// access number of sig fig
-  size_t getSigFig() const { return sigFig; } 
+  size_t getSigFig() const { return static_cast<size_t>(sigFig); } 
+
+  size_t writeNum(char*,const size_t,const double&) const;
+  size_t writeNum(char*,const size_t,const int&) const;
+  size_t writeNum(char*,const size_t,const size_t&) const;
+  size_t writeNum(char*,const size_t,const Geometry::Vec3D&,
+		  const char) const;
 
   template<typename T>
-  std::string padNum(const T&,const size_t);
+  std::string padNum(const T&,const size_t) const;
 
-  std::string NameNoDot(std::string);
-  std::string NumComma(const Geometry::Vec3D&);
-  std::string Num(const Geometry::Vec3D&);
-  std::string Num(const double&);
-  std::string Num(const int&);
-  std::string Num(const size_t&);
+  std::string NameNoDot(std::string) const;
+  std::string NumComma(const Geometry::Vec3D&) const;
+  std::string Num(const Geometry::Vec3D&) const;
+  std::string Num(const double&) const;
+  std::string Num(const int&) const;
+  std::string Num(const size_t&) const;
     
 };
 
@@ -41,6 +41,11 @@ class volUnit
   std::set<int> cells;   ///< Cell units
   double lineSum;        ///< Sum of length
 
+  double batchStart;     ///< lineSum at start of batch
+  size_t nBatch;         ///< Number of batches
+  double sumF;           ///< Sum of batch fractions
+  double sumFSqr;        ///< Sum of batch fractions squared
+
   std::string comment;   ///< Description
   int matNum;            ///< Material number
 
@@ -58,9 +63,13 @@ class volUnit
   
   double calcVol(const double) const;
   double calcLine(const double) const;
+  double calcError() const;
+  void endBatch(const double);
   void addUnit(const int,const double);
   void addFlux(const int,const double,const double);
 
+  /// No batch has had a contribution
+  bool isEmpty() const { return sumF<=0.0; }
   /// access material number
   int getMat() const { return matNum; }
   /// Access comment
@@ -32,6 +32,11 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <functional>
 #ifndef NO_REGEX
 #include <boost/filesystem.hpp>
 #endif
@@ -46,10 +51,12 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "threadSupport.h"
 #include "stringCombine.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "doubleErr.h"
 #include "Triple.h"
 #include "NRange.h"
@@ -92,7 +99,8 @@ namespace SDef
 
 ActivationSource::ActivationSource() :
   SourceBase(),
-  timeStep(2),nPoints(0),nTotal(0),PPtr(0),
+  timeStep(2),nPoints(0),nTotal(0),nThread(1),runSeed(0),seed(1),
+  binaryOut(0),PPtr(0),
   r2Power(2.0),weightDist(-1.0),externalScale(1.0)
   /*!
     Constructor BUT ALL variable are left unpopulated.
@@ -102,6 +110,7 @@ ActivationSource::ActivationSource() :
 ActivationSource::ActivationSource(const ActivationSource& A) :
   SourceBase(A),
   timeStep(A.timeStep),nPoints(A.nPoints),nTotal(A.nTotal),
+  nThread(A.nThread),runSeed(A.runSeed),seed(A.seed),binaryOut(A.binaryOut),
   ABoxPt(A.ABoxPt),BBoxPt(A.BBoxPt),
   volCorrection(A.volCorrection),cellFlux(A.cellFlux),
   fluxPt(A.fluxPt),PPtr((A.PPtr) ? A.PPtr->clone() : 0),
@@ -127,6 +136,10 @@ ActivationSource::operator=(const ActivationSource& A)
       timeStep=A.timeStep;
       nPoints=A.nPoints;
       nTotal=A.nTotal;
+      nThread=A.nThread;
+      runSeed=A.runSeed;
+      seed=A.seed;
+      binaryOut=A.binaryOut;
       ABoxPt=A.ABoxPt;
       BBoxPt=A.BBoxPt;
       volCorrection=A.volCorrection;
@@ -232,83 +245,238 @@ ActivationSource::rotate(const localRotate& LR)
 }
 
   
+uint64_t
+ActivationSource::mixKey(uint64_t Z)
+  /*!
+    SplitMix64 finalizer : maps a counter to a random word
+    \param Z :: Key/counter value
+    \return mixed value
+  */
+{
+  Z=(Z ^ (Z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  Z=(Z ^ (Z >> 27)) * 0x94d049bb133111ebULL;
+  return Z ^ (Z >> 31);
+}
+
+double
+ActivationSource::streamRand(const uint64_t key,uint64_t& counter)
+  /*!
+    Counter based random number [0,1) from a stream.
+    The value depends only on the key and the counter
+    so streams can be drawn on any thread.
+    \param key :: Stream key
+    \param counter :: Draw number [incremented]
+    \return random number
+  */
+{
+  const uint64_t R=mixKey(key+(counter++)*0x9e3779b97f4a7c15ULL);
+  return static_cast<double>(R >> 11)*(1.0/9007199254740992.0);
+}
+
+size_t
+ActivationSource::sampleCell(const MonteCarlo::Object& Obj,
+			     const Geometry::BoundBox& BBox,
+			     const uint64_t key,
+			     const size_t maxTrial,
+			     const size_t nAccept,
+			     uint64_t& counter,
+			     std::vector<Geometry::Vec3D>& Pts)
+  /*!
+    Rejection sample points within a cell from its box
+    until either maxTrial points are tried or Pts has 
+    nAccept points.
+    \param Obj :: Cell to sample
+    \param BBox :: Finite box containing the sampled part of the cell
+    \param key :: Stream key of the cell
+    \param maxTrial :: Max trial points [0 for no limit]
+    \param nAccept :: Required size of Pts
+    \param counter :: Stream counter 
+    \param Pts :: Accepted points [added to]
+    \return number of trial points
+  */
+{
+  const Geometry::Vec3D LowPt(BBox.getLow());
+  const Geometry::Vec3D BDiff(BBox.getHigh()-LowPt);
+
+  size_t nTrial(0);
+  while(Pts.size()<nAccept && (!maxTrial || nTrial<maxTrial))
+    {
+      const double xR=streamRand(key,counter);
+      const double yR=streamRand(key,counter);
+      const double zR=streamRand(key,counter);
+      const Geometry::Vec3D testPt
+	(LowPt+Geometry::Vec3D(BDiff[0]*xR,BDiff[1]*yR,BDiff[2]*zR));
+      if (Obj.isValid(testPt))
+	Pts.push_back(testPt);
+      nTrial++;
+    }
+  return nTrial;
+}
+  
 void
 ActivationSource::createFluxVolumes(const Simulation& System)
  /*!
-   Process a number of points to get the volume
+   Sample the flux cells to get the volumes and the emission
+   points. Each cell is sampled from its bounding box [cut by
+   the activation box]. A pilot run estimates the volume 
+   which divides nPoints between the cells and the points are
+   then completed. Volume by hits/trials of all the draws.
    \param System :: Simulation to use
  */
 {
   ELog::RegMethod RegA("ActivationSource","createFluxVolumes");
 
   nTotal=0;
-  size_t index=0;
   fluxPt.clear();
+  volCorrection.clear();
 
   ELog::EM<<"Volume == "<<ABoxPt<<" : "<<BBoxPt<<ELog::endDiag;
-  const Geometry::Vec3D BDiff(BBoxPt-ABoxPt);
-  const double xStep(BDiff[0]);
-  const double yStep(BDiff[1]);
-  const double zStep(BDiff[2]);
-  MonteCarlo::Object* cellPtr(0);
-  size_t reportScore(nPoints*1);
-  ELog::EM<<"Report == "<<reportScore<<ELog::endDiag;
-  while(index<nPoints)
+  const Geometry::BoundBox ActiveBox(ABoxPt,BBoxPt);
+
+  // Boxes [and bound-box cache] are set before threading
+  std::vector<int> cellN;
+  std::vector<const MonteCarlo::Object*> cellObj;
+  std::vector<Geometry::BoundBox> cellBox;
+  for(const std::map<int,activeUnit>::value_type& CA : cellFlux)
     {
-      Geometry::Vec3D testPt(xStep*RNG.rand(),yStep*RNG.rand(),
-			     zStep*RNG.rand());
-      testPt+=ABoxPt;
-
-      cellPtr=System.findCell(testPt,cellPtr);
-      if (!cellPtr)
-	throw ColErr::InContainerError<Geometry::Vec3D>
-	  (testPt,"Point not in cell");
-      const int matN=cellPtr->getMat();
-      // test for Material / cellFlux / volume.
-      if (matN!=0)
+      const MonteCarlo::Object* OPtr=System.findObject(CA.first);
+      if (!OPtr || !OPtr->getMat())
 	{
-	  const int cellN=cellPtr->getName();
-          if (cellFlux.find(cellN)!=cellFlux.end())
-            {
-              std::map<int,double>::iterator mc=
-                volCorrection.find(cellN);
-              if (mc==volCorrection.end())
-                volCorrection.emplace(cellN,1.0);
-              else
-                mc->second+=1.0;
-              fluxPt.push_back(activeFluxPt(cellN,testPt));
-              index++;
-            }
-        }
-      nTotal++;
-      if (!(nTotal % reportScore))
-        {
-          ELog::EM<<"Ntotal/nPoints == "<<nTotal<<":"<<nPoints<<" found="<<index<<ELog::endDiag;
-          reportScore*=2;
-        }
+	  ELog::EM<<"Flux cell "<<CA.first<<" not a material cell"
+		  <<ELog::endWarn;
+	  continue;
+	}
+      Geometry::BoundBox CBox(ActiveBox);
+      CBox&=OPtr->getBoundBox();
+      if (CBox.isEmpty() || CBox.volume()<Geometry::zeroTol)
+	{
+	  ELog::EM<<"Flux cell "<<CA.first<<" outside box"<<ELog::endWarn;
+	  continue;
+	}
+      cellN.push_back(CA.first);
+      cellObj.push_back(OPtr);
+      cellBox.push_back(CBox);
+    }
+  const size_t nCell(cellN.size());
+  if (!nCell)
+    throw ColErr::EmptyContainer("Flux cells in activation box");
+  if (!nPoints)
+    throw ColErr::SizeError<size_t>(nPoints,1,"nPoints");
+
+  const size_t nPilot(std::max<size_t>(10000,nPoints/nCell));
+  std::vector<uint64_t> cellKey(nCell);
+  std::vector<uint64_t> counter(nCell,0);
+  std::vector<size_t> nTrial(nCell,0);
+  std::vector<size_t> nHit(nCell,0);
+  std::vector<size_t> nRequired(nCell,0);
+  std::vector<std::vector<Geometry::Vec3D>> cellPts(nCell);
+  const uint64_t baseKey
+    (mixKey(mixKey(static_cast<uint64_t>(runSeed))^
+	    static_cast<uint64_t>(seed)));
+  for(size_t i=0;i<nCell;i++)
+    cellKey[i]=mixKey(baseKey^static_cast<uint64_t>(cellN[i]));
+
+  // run a function over all the cells [thread dynamic]
+  auto cellLoop=[&](const std::function<void(const size_t)>& cellFunc)
+    {
+      if (nThread<2 || nCell<2)
+	{
+	  for(size_t i=0;i<nCell;i++)
+	    cellFunc(i);
+	  return;
+	}
+      std::atomic<size_t> nextCell(0);
+      ThreadSupport::runThreads(std::min(nThread,nCell),[&]()
+	{
+	  for(size_t i=nextCell++;i<nCell;i=nextCell++)
+	    cellFunc(i);
+	});
+    };
+
+  // pilot : all hits kept
+  cellLoop([&](const size_t i)
+    {
+      nTrial[i]=sampleCell(*cellObj[i],cellBox[i],cellKey[i],nPilot,
+			   nPilot,counter[i],cellPts[i]);
+      nHit[i]=cellPts[i].size();
+    });
+
+  // divide nPoints by pilot volume [largest remainder]
+  std::vector<double> cellVol(nCell);
+  double sumVol(0.0);
+  for(size_t i=0;i<nCell;i++)
+    {
+      cellVol[i]=cellBox[i].volume()*static_cast<double>(nHit[i])/
+	static_cast<double>(nTrial[i]);
+      sumVol+=cellVol[i];
+    }
+  if (sumVol<Geometry::zeroTol)
+    throw ColErr::NumericalAbort("No flux cell volume found in box");
+
+  std::vector<std::pair<double,size_t>> remainder;
+  size_t nAllocated(0);
+  for(size_t i=0;i<nCell;i++)
+    {
+      const double NV(static_cast<double>(nPoints)*cellVol[i]/sumVol);
+      nRequired[i]=static_cast<size_t>(NV);
+      nAllocated+=nRequired[i];
+      remainder.push_back(std::pair<double,size_t>
+			  (static_cast<double>(nRequired[i])-NV,i));
+    }
+  std::sort(remainder.begin(),remainder.end());
+  for(size_t i=0;nAllocated<nPoints && i<nCell;i++,nAllocated++)
+    nRequired[remainder[i].second]++;
+
+  // complete the points 
+  cellLoop([&](const size_t i)
+    {
+      std::vector<Geometry::Vec3D>& Pts=cellPts[i];
+      if (Pts.size()>=nRequired[i])
+	Pts.resize(nRequired[i]);
+      else
+	{
+	  const size_t nPilotHit(Pts.size());
+	  nTrial[i]+=sampleCell(*cellObj[i],cellBox[i],cellKey[i],0,
+				nRequired[i],counter[i],Pts);
+	  nHit[i]+=Pts.size()-nPilotHit;
+	}
+    });
+
+  for(size_t i=0;i<nCell;i++)
+    {
+      nTotal+=nTrial[i];
+      volCorrection.emplace
+	(cellN[i],cellBox[i].volume()*static_cast<double>(nHit[i])/
+	 static_cast<double>(nTrial[i]));
+      for(const Geometry::Vec3D& Pt : cellPts[i])
+	fluxPt.push_back(activeFluxPt(cellN[i],Pt));
     }
-  ELog::EM<<"FINAL nPoints/Ntotal == "<<nPoints<<":"<<nTotal<<ELog::endDiag;
 
-  // correct volumes by correct count
-  // volcorrection has good count : divide by total count and multiply by total volume
-  const double boxVol=
-    BDiff.volume()/static_cast<double>(nTotal);
+  // mix cells in the output [Fisher-Yates]
+  const uint64_t mixKeyValue(mixKey(~baseKey));
+  uint64_t mixCounter(0);
+  for(size_t i=fluxPt.size();i>1;i--)
+    {
+      const size_t j=std::min
+	(i-1,static_cast<size_t>
+	 (streamRand(mixKeyValue,mixCounter)*static_cast<double>(i)));
+      std::swap(fluxPt[i-1],fluxPt[j]);
+    }
+  ELog::EM<<"FINAL nPoints/Ntotal == "<<nPoints<<":"<<nTotal<<ELog::endDiag;
 
   // normalisze cellFlux
   // The volume self cancels since flux was per volume and this is not:
   // BUT need to scale by fractional total:
-
-  for(std::map<int,activeUnit>::value_type& CA : cellFlux)
+  for(size_t i=0;i<nCell;i++)
     {
-      std::map<int,double>::const_iterator mc=
-	volCorrection.find(CA.first);
-      if (mc->second>Geometry::zeroTol)
-	CA.second.normalize(static_cast<double>(nPoints)/mc->second,
-			    boxVol*mc->second);
+      if (nRequired[i])
+	{
+	  std::map<int,activeUnit>::iterator mc=cellFlux.find(cellN[i]);
+	  mc->second.normalize(static_cast<double>(nPoints)/
+			       static_cast<double>(nRequired[i]),
+			       volCorrection[cellN[i]]);
+	}
     }
-
-  for(std::map<int,double>::value_type& MItem : volCorrection)
-    MItem.second*=boxVol;
   
   for(const std::map<int,double>::value_type& MItem : volCorrection)
     ELog::EM<<"Cell["<<MItem.first<<"] == "<<MItem.second<<ELog::endDiag;
@@ -504,7 +672,13 @@ ActivationSource::writePoints(const std::string& outputName) const
     \param outputName :: Output file name
    */
 {
-  ELog::RegMethod RegA("ActiationSource","writePoints");
+  ELog::RegMethod RegA("ActivationSource","writePoints");
+
+  if (binaryOut)
+    {
+      writeBinaryPoints(outputName);
+      return;
+    }
 
   std::ofstream OX;
   OX.open(outputName.c_str());
@@ -532,6 +706,105 @@ ActivationSource::writePoints(const std::string& outputName) const
 }
   
   
+void
+ActivationSource::writeBinaryPoints(const std::string& outputName) const
+  /*!
+    Write the points as a binary file [layout in class header].
+    The record count is filled in after the points as
+    the photons below threshold are not written.
+    \param outputName :: Output file name
+   */
+{
+  ELog::RegMethod RegA("ActivationSource","writeBinaryPoints");
+
+  std::ofstream OX;
+  OX.open(outputName.c_str(),std::ios::out | std::ios::binary);
+  if (!OX.good())
+    throw ColErr::FileError(0,outputName,"Binary source file open");
+
+  const int32_t orderMarker(1);
+  const int32_t TS(static_cast<int32_t>(timeStep));
+  const double BoxPts[6]=
+    { ABoxPt[0],ABoxPt[1],ABoxPt[2],BBoxPt[0],BBoxPt[1],BBoxPt[2] };
+  int64_t nRecord(0);
+
+  OX.write("ACTSRC01",8);
+  OX.write(reinterpret_cast<const char*>(&orderMarker),sizeof(int32_t));
+  OX.write(reinterpret_cast<const char*>(&TS),sizeof(int32_t));
+  OX.write(reinterpret_cast<const char*>(BoxPts),6*sizeof(double));
+  const std::streampos countPos=OX.tellp();
+  OX.write(reinterpret_cast<const char*>(&nRecord),sizeof(int64_t));
+
+  std::array<double,8> PItem;
+  for(size_t i=0;i<nPoints;i++)
+    {
+      const size_t index(i % fluxPt.size());
+      const Geometry::Vec3D& Pt=fluxPt[index].getPoint();
+      const int cellN=fluxPt[index].getCellID();
+      std::map<int,activeUnit>::const_iterator mc=
+	cellFlux.find(cellN);
+      if (mc==cellFlux.end())
+	throw ColErr::InContainerError<int>(cellN,"cellN not in CellFlux");
+      const double weight=externalScale*calcWeight(Pt)/
+	mc->second.getScaleFlux();
+      if (mc->second.samplePhoton(Pt,weight,PItem))
+	{
+	  OX.write(reinterpret_cast<const char*>(PItem.data()),
+		   8*sizeof(double));
+	  nRecord++;
+	}
+    }
+  OX.seekp(countPos);
+  OX.write(reinterpret_cast<const char*>(&nRecord),sizeof(int64_t));
+  OX.close();
+  return;
+}
+
+size_t
+ActivationSource::readBinaryPoints(const std::string& inputName,
+				   std::vector<std::array<double,8>>& Out)
+  /*!
+    Read a binary point file from writeBinaryPoints
+    \param inputName :: Input file name
+    \param Out :: Records [x y z u v w E weight] 
+    \return time step of the file
+   */
+{
+  ELog::RegMethod RegA("ActivationSource","readBinaryPoints");
+
+  std::ifstream IX;
+  IX.open(inputName.c_str(),std::ios::in | std::ios::binary);
+  if (!IX.good())
+    throw ColErr::FileError(0,inputName,"Binary source file open");
+
+  char magic[8];
+  int32_t orderMarker(0);
+  int32_t TS(0);
+  double BoxPts[6];
+  int64_t nRecord(0);
+  IX.read(magic,8);
+  IX.read(reinterpret_cast<char*>(&orderMarker),sizeof(int32_t));
+  IX.read(reinterpret_cast<char*>(&TS),sizeof(int32_t));
+  IX.read(reinterpret_cast<char*>(BoxPts),6*sizeof(double));
+  IX.read(reinterpret_cast<char*>(&nRecord),sizeof(int64_t));
+
+  if (!IX.good() || std::memcmp(magic,"ACTSRC01",8))
+    throw ColErr::FileError(0,inputName,"Not an activation source file");
+  if (orderMarker!=1)
+    throw ColErr::FileError(0,inputName,"Byte order of source file");
+  if (nRecord<0 || TS<0)
+    throw ColErr::FileError(0,inputName,"Corrupt header");
+
+  Out.resize(static_cast<size_t>(nRecord));
+  for(std::array<double,8>& PItem : Out)
+    IX.read(reinterpret_cast<char*>(PItem.data()),8*sizeof(double));
+  if (!IX.good())
+    throw ColErr::FileError(0,inputName,"Source file truncated");
+  
+  IX.close();
+  return static_cast<size_t>(TS);
+}
+  
 void
 ActivationSource::createAll(const Simulation& System,
 			    const std::string& inputFileBase,
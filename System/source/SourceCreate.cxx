@@ -27,6 +27,7 @@
 #include <complex>
 #include <list>
 #include <vector>
+#include <array>
 #include <set>
 #include <map>
 #include <string>
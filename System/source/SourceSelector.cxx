@@ -315,6 +315,9 @@ activationSelection(Simulation& System,
   Geometry::Vec3D weightPt;
   double weightDist(-1.0);
   double scale(1.0);
+  size_t nThread(1);
+  size_t seed(1);
+  bool binaryFlag(0);
 
   if (nP)
     {
@@ -343,6 +346,10 @@ activationSelection(Simulation& System,
 		      <<"-- nVol size :: number of point for vol sample [def: npts]"
 		      <<"-- weightPoint :: Point dist :: Scale to distance "
 		      <<"-- weightPlane :: Vec3D : Axis3D "
+		      <<"-- nThread size :: threads for volume sampling\n"
+		      <<"-- seed size :: seed of the point streams "
+		      <<"[mixed with -random]\n"
+		      <<"-- binary :: write a binary point file\n"
 		      <<ELog::endBasic;
 	    }
 	  else if (key=="box")
@@ -380,6 +387,18 @@ activationSelection(Simulation& System,
 	    {
 	      nVol=IParam.getValueError<size_t>("activation",index,1,eMess);
 	    }
+	  else if (key=="nThread")
+	    {
+	      nThread=IParam.getValueError<size_t>("activation",index,1,eMess);
+	    }
+	  else if (key=="seed")
+	    {
+	      seed=IParam.getValueError<size_t>("activation",index,1,eMess);
+	    }
+	  else if (key=="binary")
+	    {
+	      binaryFlag=1;
+	    }
 	  else if (key=="weightPlane")
 	    {
 	      size_t itemCnt(1);
@@ -401,6 +420,10 @@ activationSelection(Simulation& System,
       AS->setNPoints(nVol);
       AS->setWeightPoint(weightPt,weightDist);
       AS->setScale(scale);
+      AS->setThreads(nThread);
+      AS->setRunSeed(IParam.getValue<long int>("random"));
+      AS->setSeed(seed);
+      AS->setBinary(binaryFlag);
       AS->createAll(System,cellDir,OName);
     }
 
@@ -27,6 +27,7 @@
 #include <complex>
 #include <list>
 #include <vector>
+#include <array>
 #include <set>
 #include <map>
 #include <string>
@@ -201,19 +202,18 @@ activeUnit::getScaleFlux() const
 
   
   
-void
-activeUnit::writePhoton(std::ostream& OX,const Geometry::Vec3D& Pt,
-			const double weight) const
+bool
+activeUnit::samplePhoton(const Geometry::Vec3D& Pt,const double weight,
+			 std::array<double,8>& Out) const
   /*!
     Calculate the energy based on RNG nubmer and 
-    write a photon in a random direction
-    \param OX :: Output stream
+    sample a photon in a random direction
     \param Pt :: Point for interaction
     \param weight :: External Scaling factor 
+    \param Out :: x y z u v w E weight 
+    \return true if above energy threshold
   */
 {
-  boost::format FMT("% 12.6e %|14t| % 12.6e %|28t| % 12.6e");
-  boost::format FMTB("% 12.6e %|14t| % 12.6e");
   const double thetaAngle=2*M_PI*RNG.rand();
   const double z=2.0*(RNG.rand()-0.5);
   const double sinZ=sqrt(1-z*z);
@@ -222,12 +222,35 @@ activeUnit::writePhoton(std::ostream& OX,const Geometry::Vec3D& Pt,
   const double R=RNG.rand();
   const double E=XInverse(R);
 
-  //  OX<<(FMT % Pt.X() % Pt.Y() % Pt.Z())<<std::endl;
-  if (E>1e-3)  // above threshold
+  for(size_t i=0;i<3;i++)
+    {
+      Out[i]=Pt[i];
+      Out[i+3]=uvw[i];
+    }
+  Out[6]=E;
+  Out[7]=weight*getScaleFlux()*integralFlux;
+  return (E>1e-3);  // above threshold
+}
+
+void
+activeUnit::writePhoton(std::ostream& OX,const Geometry::Vec3D& Pt,
+			const double weight) const
+  /*!
+    Write a photon in a random direction
+    \param OX :: Output stream
+    \param Pt :: Point for interaction
+    \param weight :: External Scaling factor 
+  */
+{
+  boost::format FMT("% 12.6e %|14t| % 12.6e %|28t| % 12.6e");
+  boost::format FMTB("% 12.6e %|14t| % 12.6e");
+
+  std::array<double,8> PItem;
+  if (samplePhoton(Pt,weight,PItem))
     {
-      OX<<"2 "<<(FMT % Pt.X() % Pt.Y() % Pt.Z());
-      OX<<"  "<<(FMT % uvw.X() % uvw.Y() % uvw.Z());
-      OX<<"  "<<(FMTB % E % (weight*getScaleFlux()*integralFlux))<<std::endl;
+      OX<<"2 "<<(FMT % PItem[0] % PItem[1] % PItem[2]);
+      OX<<"  "<<(FMT % PItem[3] % PItem[4] % PItem[5]);
+      OX<<"  "<<(FMTB % PItem[6] % PItem[7])<<std::endl;
     }
   return;
 }
@@ -25,6 +25,12 @@
 namespace Geometry
 {
   class Plane;
+  class BoundBox;
+}
+
+namespace MonteCarlo
+{
+  class Object;
 }
 
 namespace SDef
@@ -37,6 +43,21 @@ namespace SDef
   \author S. Ansell
   \date September 2016
   \brief Creates an active projection source
+
+  The flux points are sampled cell by cell from the intersection
+  of each flux cell bounding box with the activation box. Each cell
+  uses its own counter-based random stream [seed/cell/draw] so the
+  points are the same for any number of threads. The streams
+  are keyed by the run random seed [-random] and the 
+  activation seed.
+
+  The optional binary point file is native byte order:
+   - char[8] : "ACTSRC01"
+   - int32 : byte order marker [1]
+   - int32 : time step
+   - double[6] : box low/high corner
+   - int64 : number of records
+   - records of double[8] : x y z u v w E weight [photon]
 */
 
 class ActivationSource :
@@ -47,6 +68,10 @@ class ActivationSource :
   size_t timeStep;                ///< Time step from cinder
   size_t nPoints;                 ///< Number of points
   size_t nTotal;                  ///< Total points
+  size_t nThread;                 ///< Number of threads for sampling
+  long int runSeed;               ///< Run random seed [-random]
+  size_t seed;                    ///< Seed of the point streams
+  bool binaryOut;                 ///< Write binary point file
   
   Geometry::Vec3D ABoxPt;         ///< Bounding box corner
   Geometry::Vec3D BBoxPt;         ///< Bounding box corner
@@ -64,6 +89,13 @@ class ActivationSource :
   double weightDist;              ///< Centre weight scalar
   double externalScale;           ///< intensity scale [external]
 
+  static uint64_t mixKey(uint64_t);
+  static double streamRand(const uint64_t,uint64_t&);
+  static size_t sampleCell(const MonteCarlo::Object&,
+			   const Geometry::BoundBox&,
+			   const uint64_t,const size_t,const size_t,
+			   uint64_t&,std::vector<Geometry::Vec3D>&);
+  
   void createVolumeCount();
   void createFluxVolumes(const Simulation&);
   void readFluxes(const std::string&);
@@ -73,6 +105,7 @@ class ActivationSource :
   double calcWeight(const Geometry::Vec3D&) const;
   void normalizeScale();
   void writePoints(const std::string&) const;
+  void writeBinaryPoints(const std::string&) const;
   
  public:
 
@@ -90,6 +123,14 @@ class ActivationSource :
   /// set scalar
   void setScale(const double S) { externalScale=S; }  
   void setWeightPoint(const Geometry::Vec3D&,const double);
+  /// Set number of threads for the volume sampling
+  void setThreads(const size_t N) { nThread=(N) ? N : 1; }
+  /// Set the run random seed [-random]
+  void setRunSeed(const long int RS) { runSeed=RS; }
+  /// Set the seed of the point streams
+  void setSeed(const size_t S) { seed=S; }
+  /// Set binary point output
+  void setBinary(const bool B) { binaryOut=B; }
   
   void setPlane(const Geometry::Vec3D&,const Geometry::Vec3D&,
 		const double);
@@ -97,6 +138,9 @@ class ActivationSource :
 
   void createAll(const Simulation&,const std::string&,
 		 const std::string&);
+
+  static size_t readBinaryPoints(const std::string&,
+				 std::vector<std::array<double,8>>&);
   
   virtual void rotate(const localRotate&);
   virtual void createSource(SDef::Source&) const;
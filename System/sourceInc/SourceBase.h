@@ -84,6 +84,8 @@ class SourceBase
   
   /// No-op to substitue
   virtual void substituteSurface(const int,const int) {}
+  /// No-op to substitue a set of surfaces
+  virtual void substituteSurface(const std::map<int,int>&) {}
   /// No-op to rotate
   virtual void rotate(const localRotate&) { } 
   virtual void createSource(SDef::Source&) const =0;
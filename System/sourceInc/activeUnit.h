@@ -64,6 +64,8 @@ class activeUnit
   
   double XInverse(const double) const;
   void normalize(const double,const double);
+  bool samplePhoton(const Geometry::Vec3D&,const double,
+		    std::array<double,8>&) const;
   void writePhoton(std::ostream&,const Geometry::Vec3D&,
 		   const double) const;
 
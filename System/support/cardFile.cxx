@@ -0,0 +1,57 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   support/cardFile.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "cardFile.h"
+
+namespace StrFunc
+{
+
+cardFile::cardFile(const std::string& Fname,const size_t bufSize) :
+  std::ofstream(),Buffer(bufSize)
+  /*!
+    Constructor : the buffer must be set before the
+    file is opened
+    \param Fname :: File name
+    \param bufSize :: Size of buffer
+  */
+{
+  if (bufSize)
+    rdbuf()->pubsetbuf(Buffer.data(),
+		       static_cast<std::streamsize>(bufSize));
+  open(Fname.c_str());
+}
+
+cardFile::~cardFile()
+  /*!
+    Destructor : the file is closed [flushed] before
+    the buffer is released
+  */
+{
+  if (is_open())
+    close();
+}
+
+}  // NAMESPACE StrFunc
@@ -0,0 +1,81 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   support/threadSupport.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include <exception>
+
+#include "threadSupport.h"
+
+namespace ThreadSupport
+{
+
+size_t
+defaultThreads()
+  /*!
+    Get the number of hardware threads
+    \return number of threads [at least 1]
+  */
+{
+  const size_t N(std::thread::hardware_concurrency());
+  return (N) ? N : 1;
+}
+
+void
+runThreads(const size_t nThread,const std::function<void()>& workFunc)
+  /*!
+    Run a work function on nThread threads and wait for
+    them to finish. The function shares the work out itself.
+    The first exception thrown by a thread is rethrown.
+    \param nThread :: Number of threads [0 treated as 1]
+    \param workFunc :: Function to run
+  */
+{
+  std::mutex errLock;
+  std::exception_ptr errPtr;
+  std::vector<std::thread> TVec;
+  for(size_t i=0;i<nThread || i==0;i++)
+    TVec.push_back(std::thread([&workFunc,&errLock,&errPtr]()
+      {
+	try
+	  {
+	    workFunc();
+	  }
+	catch(...)
+	  {
+	    std::lock_guard<std::mutex> lockGuard(errLock);
+	    if (!errPtr)
+	      errPtr=std::current_exception();
+	  }
+      }));
+  for(std::thread& TUnit : TVec)
+    TUnit.join();
+
+  if (errPtr)
+    std::rethrow_exception(errPtr);
+  return;
+}
+
+} // NAMESPACE ThreadSupport
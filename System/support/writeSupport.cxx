@@ -125,7 +125,7 @@ writeFLUKA(const std::string& Line,std::ostream& OX)
     {
       if (w=="-") w=" ";
       if (i % 8==0) // never a number
-	OX<<std::setw(10)<<std::left<<w<<std::endl;
+	OX<<std::setw(10)<<std::left<<w<<'\n';
       else
 	{
 	  if (StrFunc::convert(w,I))
@@ -144,7 +144,7 @@ writeFLUKA(const std::string& Line,std::ostream& OX)
 	}      
       i++;
     }
-  if (i % 8 != 1) OX<<std::endl;
+  if (i % 8 != 1) OX<<'\n';
   return;
 }
 
@@ -176,7 +176,7 @@ writeFLUKAhead(const std::string& HeadUnit,
       i++;
       if (i==NItem)
 	{
-	  OX<<EndUnit<<std::endl;
+	  OX<<EndUnit<<'\n';
 	  i=0;
 	}
     }
@@ -185,7 +185,7 @@ writeFLUKAhead(const std::string& HeadUnit,
     {
       for(;i<NItem;i++)
 	OX<<std::string(10,' ');
-      OX<<EndUnit<<std::endl;
+      OX<<EndUnit<<'\n';
     }
   
   return;
@@ -220,13 +220,43 @@ writeMCNPXcont(const std::string& Line,std::ostream& OX)
   return;
 }
 
+void
+writeBlock(std::ostream& OX,const size_t spcLen,
+	   const char* LPtr,const size_t len)
+/*!
+  Write a line of spcLen spaces then the block with
+  leading/trailing white space removed. Nothing is
+  written for a white space block.
+  \param OX :: ostream to write to
+  \param spcLen :: Number of leading spaces
+  \param LPtr :: Start of block
+  \param len :: Length of block
+*/
+{
+  static const std::string Spc(80,' ');
+  
+  size_t posA(0);
+  size_t posB(len);
+  while(posA<len && std::isspace(LPtr[posA])) posA++;
+  while(posB>posA && std::isspace(LPtr[posB-1])) posB--;
+  if (posA==posB) return;
+
+  for(size_t i=0;i<spcLen;i+=Spc.size())
+    OX.write(Spc.data(),
+	     static_cast<std::streamsize>(std::min(Spc.size(),spcLen-i)));
+  OX.write(LPtr+posA,static_cast<std::streamsize>(posB-posA));
+  OX.put('\n');
+  return;
+}
+
 void
 writeControl(const std::string& Line,std::ostream& OX,
 	     const size_t LNmax,int insertDepth)
 /*!
   Write out the line in the limited form for MCNPX
   ie initial line from 0::72 after that 8 to 72
-  (split on a space or comma)
+  (split on a space or comma). The line is split in
+  place and written without a flush.
   \param Line :: full MCNPX line
   \param OX :: ostream to write to
   \param LNmax :: Maximium char count in a line
@@ -241,26 +271,29 @@ writeControl(const std::string& Line,std::ostream& OX,
       spcLen=static_cast<size_t>(insertDepth);
     }
 
-  std::string::size_type pos(0);
-  std::string X=Line.substr(0,LNmax-spcLen);    
-  std::string::size_type posB=X.find_last_of(" ,");
-  while(X.length() == LNmax-spcLen &&
-	posB!=std::string::npos)
+  const char* LPtr=Line.data();
+  const size_t NL(Line.size());
+  size_t pos(0);
+  while(1)
     {
-      pos+=posB+1;
-      if (!isspace(X[posB])) posB++;  // skip pass comma 
-      X=fullBlock(X.substr(0,posB));
-      if (!isEmpty(X))
-	OX<<std::string(spcLen,' ')<<X<<std::endl;
+      // window of line at pos
+      const size_t WLen(LNmax-spcLen);
+      const size_t XLen=std::min(WLen,NL-pos);
 
+      size_t posB(XLen);
+      while(posB && LPtr[pos+posB-1]!=' ' && LPtr[pos+posB-1]!=',')
+	posB--;
+      if (XLen!=WLen || !posB)
+	{
+	  writeBlock(OX,spcLen,LPtr+pos,XLen);
+	  return;
+	}
+      // posB is one past the split : keep a comma
+      const size_t outLen=(LPtr[pos+posB-1]==',') ? posB : posB-1;
+      writeBlock(OX,spcLen,LPtr+pos,outLen);
+      pos+=posB;
       spcLen=static_cast<size_t>(insertDepth);
-      X=Line.substr(pos,LNmax-spcLen);
-      posB=X.find_last_of(" ,");
     }
-    
-  X=fullBlock(X);
-  if (!isEmpty(X))
-    OX<<std::string(spcLen,' ')<<X<<std::endl;
   return;
 }
 
@@ -278,35 +311,37 @@ writeMCNPXcomment(const std::string& Line,std::ostream& OX,
 */
 {
   const size_t MaxLine(72);
+  const std::string Spc(8,' ');
 
-  std::string::size_type pos(0);
-  std::string X=Line.substr(0,MaxLine);
-  std::string::size_type posB=X.find_last_of(" ,");
+  const char* LPtr=Line.data();
+  const size_t NL(Line.size());
+  size_t pos(0);
   size_t spc(0);
-  while (posB!=std::string::npos && 
-	 X.length()>=MaxLine-spc)
+  while(1)
     {
-      pos+=posB+1;
-      if (!isspace(X[posB]))
-	posB++;
-      const std::string Out=X.substr(0,posB);
-      if (!isEmpty(Out))
-        {
+      const size_t XLen=std::min(MaxLine-spc,NL-pos);
+      size_t posB(XLen);
+      while(posB && LPtr[pos+posB-1]!=' ' && LPtr[pos+posB-1]!=',')
+	posB--;
+      const char* XPtr(LPtr+pos);
+      const bool lastLine(!posB || XLen<MaxLine-spc);
+      const size_t outLen=(lastLine) ? XLen :
+	((XPtr[posB-1]==',') ? posB : posB-1);
+      
+      // empty is only space/tab [not fullBlock]
+      size_t index(0);
+      while(index<outLen && (XPtr[index]==' ' || XPtr[index]=='\t'))
+	index++;
+      if (index!=outLen)
+	{
 	  OX<<commentString;
-	  if (spc)
-	    OX<<std::string(spc,' ');
-	  OX<<X.substr(0,posB)<<std::endl;
+	  OX.write(Spc.data(),static_cast<std::streamsize>(spc));
+	  OX.write(XPtr,static_cast<std::streamsize>(outLen));
+	  OX.put('\n');
 	}
+      if (lastLine) return;
+      pos+=posB;
       spc=8;
-      X=Line.substr(pos,MaxLine-spc);
-      posB=X.find_last_of(" ,");
-    }
-  if (!isEmpty(X))
-    {
-      OX<<commentString;
-      if (spc)
-	OX<<std::string(spc,' ');
-      OX<<X<<std::endl;
     }
   return;
 }
@@ -0,0 +1,64 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   supportInc/cardFile.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef StrFunc_cardFile_h
+#define StrFunc_cardFile_h
+
+namespace StrFunc
+{
+
+/*!
+  \class cardFile
+  \version 1.0
+  \author S. Ansell
+  \date June 2018
+  \brief Output file for an input deck
+
+  An ofstream with a large user buffer so that the
+  card writers [writeControl/writeFLUKA etc], which
+  do not flush per line, reach the disk in large blocks.
+  Requires <fstream> and <vector>.
+*/
+
+class cardFile : public std::ofstream
+{
+ private:
+
+  std::vector<char> Buffer;        ///< Stream buffer
+
+  ///\cond PRIVATE
+  cardFile(const cardFile&);
+  cardFile& operator=(const cardFile&);
+  ///\endcond PRIVATE
+
+ public:
+
+  /// Default buffer size
+  static const size_t defaultSize=1 << 22;
+
+  explicit cardFile(const std::string&,const size_t =defaultSize);
+  ~cardFile();
+
+};
+
+}  // NAMESPACE StrFunc
+
+#endif
@@ -32,6 +32,8 @@ std::string flukaNum(const double);
 
 std::vector<std::string> splitComandLine(std::string);
  
+void writeBlock(std::ostream&,const size_t,const char*,const size_t);
+
 // Write file in standard MCNPX input form
 void writeControl(const std::string&,std::ostream&,
 		  const size_t,const int);
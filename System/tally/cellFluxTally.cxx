@@ -204,14 +204,13 @@ cellFluxTally::addIndividualCells(const std::vector<int>& AVec)
 }
 
 void
-cellFluxTally::renumberCell(const int oldCell,const int newCell)
+cellFluxTally::renumberCell(const std::map<int,int>& RMap)
   /*!
-    Renumbers a cell from the active list
-    \param oldCell :: Old cell numb
-    \param newCell :: New cell numb
+    Renumbers cells from the active list
+    \param RMap :: Map of old cell : new cell
   */
 {
-  cellList.changeItem(oldCell,newCell);
+  cellList.changeItem(RMap);
   return;
 }
 
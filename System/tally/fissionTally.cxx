@@ -189,14 +189,13 @@ fissionTally::addIndividualCells(const std::vector<int>& AVec)
 }
 
 void
-fissionTally::renumberCell(const int oldCell,const int newCell)
+fissionTally::renumberCell(const std::map<int,int>& RMap)
   /*!
-    Renumbers a cell from the active list
-    \param oldCell :: Old cell numb
-    \param newCell :: New cell numb
+    Renumbers cells from the active list
+    \param RMap :: Map of old cell : new cell
   */
 {
-  cellList.changeItem(oldCell,newCell);
+  cellList.changeItem(RMap);
   return;
 }
 
@@ -270,7 +270,11 @@ fmeshTally::write(std::ostream& OX) const
       writeParticles(cx);
       //GEOMETRY:
       cx<<"GEOM="<<"xyz"<<" ";
-      cx<<"ORIGIN="<<MW.Num(minCoord)<<" ";
+      char Out[3*masterWrite::bufSize+1];
+      size_t N=MW.writeNum(Out,sizeof(Out)-1,minCoord,' ');
+      Out[N++]=' ';
+      cx<<"ORIGIN=";
+      cx.write(Out,static_cast<std::streamsize>(N));
       StrFunc::writeMCNPX(cx.str(),OX);
       cx.str("");
 
@@ -169,15 +169,14 @@ heatTally::addCells(const std::vector<int>& AVec)
 }
 
 void
-heatTally::renumberCell(const int oldN,const int newN)
+heatTally::renumberCell(const std::map<int,int>& RMap)
   /*!
-    renumber the cell based on the old/New numbers
-    \param oldN :: Old number to find
-    \param newN :: new number to replace the cell with
+    renumber the cells based on the old/New numbers
+    \param RMap :: Map of old number : new number
    */
 {
   ELog::RegMethod RegA("heatTally","renumberCell");
-  cellList.changeItem(oldN,newN);
+  cellList.changeItem(RMap);
   return;
 }
 
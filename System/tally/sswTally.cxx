@@ -120,22 +120,22 @@ sswTally::addSurfaces(const std::vector<int>& surfVec)
 }
 
 void
-sswTally::renumberSurf(const int oldN,const int newN)
+sswTally::renumberSurf(const std::map<int,int>& RMap)
   /*!
-    Renumber the cell based on the old/New numbers
-    \param oldN :: Old number to find
-    \param newN :: new number to replace the surface with
+    Renumber the surfaces based on the old/New numbers
+    \param RMap :: Map of old number : new number [+ve]
   */
 {
-  ELog::RegMethod RegA("ssWTally","renumberCell");
+  ELog::RegMethod RegA("ssWTally","renumberSurf");
 
   // handle the sign change in +/- numbers
-  std::replace_if(surfList.begin(),surfList.end(),
-		  [&oldN](const int& x) { return (x==oldN); },
-		  newN);
-  std::replace_if(surfList.begin(),surfList.end(),
-		  [&oldN](const int& x) { return (x== -oldN); },
-		  -newN);
+  for(int& SN : surfList)
+    {
+      const std::map<int,int>::const_iterator mc=
+	RMap.find((SN>0) ? SN : -SN);
+      if (mc!=RMap.end())
+	SN=(SN>0) ? mc->second : -mc->second;
+    }
   return;
 }
 
@@ -221,44 +221,38 @@ surfaceTally::setSurfDivider(const std::vector<int>& TS)
 }
 
 void
-surfaceTally::renumberCell(const int oldN,const int newN)
+surfaceTally::renumberCell(const std::map<int,int>& RMap)
   /*!
-    Renumber the cell based on the old/New numbers
-    \param oldN :: Old number to find
-    \param newN :: new number to replace the cell with
+    Renumber the cells based on the old/New numbers
+    \param RMap :: Map of old number : new number
    */
 {
   ELog::RegMethod RegA("surfaceTally","renumberCell");
-  CellFlag.changeItem(oldN,newN);
+  CellFlag.changeItem(RMap);
   return;
 }
 
 
 void
-surfaceTally::renumberSurf(const int oldN,const int newN)
+surfaceTally::renumberSurf(const std::map<int,int>& RMap)
   /*!
-    Renumber the cell based on the old/New numbers
-    \param oldN :: Old number to find
-    \param newN :: new number to replace the surface with
+    Renumber the surfaces based on the old/New numbers
+    \param RMap :: Map of old number : new number [+ve]
    */
 {
-  ELog::RegMethod RegA("surfaceTally","renumberCell");
+  ELog::RegMethod RegA("surfaceTally","renumberSurf");
 
-  SurfFlag.changeItem(oldN,newN);
-  
-  std::replace_if(SurfList.begin(),SurfList.end(),
-		  [&oldN](const int& x) { return (x==oldN); },
-		  newN);
-  std::replace_if(SurfList.begin(),SurfList.end(),
-		  [&oldN](const int& x) { return (x== -oldN); },
-		  -newN);
+  SurfFlag.changeItem(RMap);
 
-  std::replace_if(FSfield.begin(),FSfield.end(),
-		  [&oldN](const int& x) { return (x==oldN); },
-		  newN);
-  std::replace_if(FSfield.begin(),FSfield.end(),
-		  [&oldN](const int& x) { return ( x == -oldN); },
-		  -newN);
+  // handle the sign change in +/- numbers
+  for(std::vector<int>* VPtr : {&SurfList,&FSfield})
+    for(int& SN : *VPtr)
+      {
+	const std::map<int,int>::const_iterator mc=
+	  RMap.find((SN>0) ? SN : -SN);
+	if (mc!=RMap.end())
+	  SN=(SN>0) ? mc->second : -mc->second;
+      }
   return;
 }
   
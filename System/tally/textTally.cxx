@@ -115,11 +115,10 @@ textTally::addLine(const std::string& LX)
 
 
 void
-textTally::renumberCell(const int ,const int )
+textTally::renumberCell(const std::map<int,int>&)
   /*!
     Renumber the cell based on the old/New numbers
-    \param :: Old number to find
-    \param :: new number to replace the cell with
+    \param :: Map of old number : new number
    */
 {
   ELog::RegMethod RegA("textTally","renumberCell");
@@ -128,11 +127,10 @@ textTally::renumberCell(const int ,const int )
 
 
 void
-textTally::renumberSurf(const int,const int )
+textTally::renumberSurf(const std::map<int,int>&)
   /*!
     Renumber the cell based on the old/New numbers
-    \param :: Old number to find
-    \param :: new number to replace the surface with
+    \param :: Map of old number : new number
    */
 {
   ELog::RegMethod RegA("textTally","renumberCell");
@@ -314,8 +314,13 @@ tmeshTally::write(std::ostream& OX) const
 	{
 	  // THIS IS JUNK as maybe two keywords and two value sets
 	  cx<<keyWords<<" ";
+	  char Out[masterWrite::bufSize+1];
 	  for(const double V : kIndex)
-	    cx<<MW.Num(V)<<" ";
+	    {
+	      size_t N=MW.writeNum(Out,sizeof(Out)-1,V);
+	      Out[N++]=' ';
+	      cx.write(Out,static_cast<std::streamsize>(N));
+	    }
 	}
       else
 	cx<<"DOSE "<<std::abs(activeMSHMF);
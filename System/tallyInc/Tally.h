@@ -108,9 +108,9 @@ class Tally
   virtual void rotateMaster() { }          ///< Rotation to Master
   virtual int addLine(const std::string&);     
   /// Renumber [not normally required]
-  virtual void renumberCell(const int,const int) {}
+  virtual void renumberCell(const std::map<int,int>&) {}
   /// Renumber [not normally required]
-  virtual void renumberSurf(const int,const int) {}
+  virtual void renumberSurf(const std::map<int,int>&) {}
   /// make a group sum into single units
   virtual int makeSingle() { return 0; }
 
@@ -56,7 +56,7 @@ class fissionTally : public Tally
   void clearCells();
 
   virtual int addLine(const std::string&); 
-  virtual void renumberCell(const int,const int);
+  virtual void renumberCell(const std::map<int,int>&);
   virtual int makeSingle();
   virtual void write(std::ostream&) const;
   
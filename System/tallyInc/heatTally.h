@@ -54,7 +54,7 @@ class heatTally : public Tally
   void clearCells();
   void setPlus(const int V) { plus=V; } ///< Set the + flag
   
-  virtual void renumberCell(const int,const int);
+  virtual void renumberCell(const std::map<int,int>&);
   virtual int addLine(const std::string&); 
   virtual void write(std::ostream&) const;
   
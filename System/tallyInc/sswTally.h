@@ -50,7 +50,7 @@ class sswTally : public Tally
       { return "sswTally"; }
 
   void addSurfaces(const std::vector<int>&);
-  virtual void renumberSurf(const int,const int);
+  virtual void renumberSurf(const std::map<int,int>&);
 
   virtual void write(std::ostream&) const;
 };
@@ -63,8 +63,8 @@ class surfaceTally : public Tally
     void setSurfDivider(const std::vector<int>&);
     void setCellDivider(const std::vector<int>&);
     
-    virtual void renumberCell(const int,const int);
-    virtual void renumberSurf(const int,const int);
+    virtual void renumberCell(const std::map<int,int>&);
+    virtual void renumberSurf(const std::map<int,int>&);
 
     virtual void write(std::ostream&) const;
     
@@ -51,8 +51,8 @@ class textTally : public Tally
     /// Accessor to lines
     const std::vector<std::string>& getLines() const 
       { return Lines; }
-    virtual void renumberCell(const int,const int);
-    virtual void renumberSurf(const int,const int);
+    virtual void renumberCell(const std::map<int,int>&);
+    virtual void renumberSurf(const std::map<int,int>&);
     
     virtual void write(std::ostream&) const;      
   };
@@ -0,0 +1,360 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   visit/VTKwrite.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <boost/format.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "VTKwrite.h"
+
+VTKwrite::VTKwrite(const vtkForm F,const vtkData D,
+		   const std::string& SName) :
+  format(F),dataType(D),scalarName(SName),
+  nPts({0,0,0}),nSlice(0)
+  /*!
+    Constructor
+    \param F :: File format
+    \param D :: Scalar data type
+    \param SName :: Name of scalar in the file
+  */
+{}
+
+VTKwrite::~VTKwrite()
+  /*!
+    Destructor [file left incomplete if not closed]
+   */
+{
+  if (OX.is_open())
+    OX.close();
+}
+
+bool
+VTKwrite::isBigEndian()
+  /*!
+    Determine the byte order of the machine
+    \return true if big endian
+  */
+{
+  const uint16_t testValue(1);
+  return (*reinterpret_cast<const char*>(&testValue)==0);
+}
+
+bool
+VTKwrite::isForm(const std::string& FName)
+  /*!
+    Determine if a name is a file format
+    \param FName :: Name to test
+    \return true if a format name
+  */
+{
+  return (FName=="ascii" || FName=="binary" || FName=="xml");
+}
+
+VTKwrite::vtkForm
+VTKwrite::getForm(const std::string& FName)
+  /*!
+    Convert a name into a file format
+    \param FName :: ascii/binary/xml
+    \return format
+  */
+{
+  ELog::RegMethod RegA("VTKwrite","getForm");
+
+  if (FName=="ascii")
+    return vtkForm::ascii;
+  if (FName=="binary")
+    return vtkForm::binary;
+  if (FName=="xml")
+    return vtkForm::xml;
+  throw ColErr::InContainerError<std::string>(FName,"VTK format");
+}
+
+void
+VTKwrite::writeBlock(const char* DPtr,const size_t nItem,
+		     const size_t itemSize)
+  /*!
+    Write binary items : legacy VTK is always big endian,
+    the xml byte order is set to the machine order
+    \param DPtr :: Data
+    \param nItem :: Number of items
+    \param itemSize :: Size of each item [bytes]
+  */
+{
+  if (format==vtkForm::xml || isBigEndian())
+    {
+      OX.write(DPtr,static_cast<std::streamsize>(nItem*itemSize));
+      return;
+    }
+
+  std::vector<char> Buffer(DPtr,DPtr+nItem*itemSize);
+  for(size_t i=0;i<nItem;i++)
+    std::reverse(Buffer.begin()+static_cast<long int>(i*itemSize),
+		 Buffer.begin()+static_cast<long int>((i+1)*itemSize));
+  OX.write(Buffer.data(),static_cast<std::streamsize>(Buffer.size()));
+  return;
+}
+
+void
+VTKwrite::writeCoord(const std::vector<double>& Coord)
+  /*!
+    Write a coordinate list [float in binary]
+    \param Coord :: Coordinates
+  */
+{
+  if (format==vtkForm::ascii)
+    {
+      boost::format fFMT("%1$11.6g%|14t|");
+      for(const double C : Coord)
+	OX<<(fFMT % C);
+      OX<<std::endl;
+      return;
+    }
+
+  std::vector<float> Out(Coord.begin(),Coord.end());
+  if (format==vtkForm::xml)
+    {
+      const uint64_t nByte(Out.size()*sizeof(float));
+      writeBlock(reinterpret_cast<const char*>(&nByte),1,sizeof(uint64_t));
+    }
+  writeBlock(reinterpret_cast<const char*>(Out.data()),
+	     Out.size(),sizeof(float));
+  if (format==vtkForm::binary)
+    OX<<std::endl;
+  return;
+}
+
+void
+VTKwrite::writeLegacyHeader(const std::string& Title,
+			    const std::vector<double>& X,
+			    const std::vector<double>& Y,
+			    const std::vector<double>& Z)
+  /*!
+    Write the legacy VTK header and coordinates
+    \param Title :: Title line
+    \param X :: X coordinates
+    \param Y :: Y coordinates
+    \param Z :: Z coordinates
+  */
+{
+  const std::string typeName=
+    (dataType==vtkData::Int) ? " int" : " float";
+
+  OX<<"# vtk DataFile Version 2.0"<<std::endl;
+  OX<<Title<<std::endl;
+  OX<<((format==vtkForm::ascii) ? "ASCII" : "BINARY")<<std::endl;
+  OX<<"DATASET RECTILINEAR_GRID"<<std::endl;
+  OX<<"DIMENSIONS "<<nPts[0]<<" "<<nPts[1]<<" "<<nPts[2]<<std::endl;
+
+  OX<<"X_COORDINATES "<<nPts[0]<<" float"<<std::endl;
+  writeCoord(X);
+  OX<<"Y_COORDINATES "<<nPts[1]<<" float"<<std::endl;
+  writeCoord(Y);
+  OX<<"Z_COORDINATES "<<nPts[2]<<" float"<<std::endl;
+  writeCoord(Z);
+
+  OX<<"POINT_DATA "<<nPts[0]*nPts[1]*nPts[2]<<std::endl;
+  OX<<"SCALARS "<<scalarName<<typeName<<" 1"<<std::endl;
+  OX<<"LOOKUP_TABLE default"<<std::endl;
+  return;
+}
+
+void
+VTKwrite::writeXMLHeader()
+  /*!
+    Write the XML RectilinearGrid header : all the data
+    is appended [coordinates then scalars]
+  */
+{
+  // UInt64 byte count before each block
+  const size_t coordSize(sizeof(uint64_t));
+  const size_t offsetY(coordSize+
+		       static_cast<size_t>(nPts[0])*sizeof(float));
+  const size_t offsetZ(offsetY+coordSize+
+		       static_cast<size_t>(nPts[1])*sizeof(float));
+  const size_t offsetS(offsetZ+coordSize+
+		       static_cast<size_t>(nPts[2])*sizeof(float));
+
+  std::ostringstream cx;
+  cx<<"0 "<<nPts[0]-1<<" 0 "<<nPts[1]-1<<" 0 "<<nPts[2]-1;
+  const std::string extent=cx.str();
+
+  const std::string typeName=
+    (dataType==vtkData::Int) ? "Int32" : "Float32";
+
+  OX<<"<?xml version=\"1.0\"?>"<<std::endl;
+  OX<<"<VTKFile type=\"RectilinearGrid\" version=\"1.0\" byte_order=\""
+    <<((isBigEndian()) ? "BigEndian" : "LittleEndian")
+    <<"\" header_type=\"UInt64\">"<<std::endl;
+  OX<<"  <RectilinearGrid WholeExtent=\""<<extent<<"\">"<<std::endl;
+  OX<<"    <Piece Extent=\""<<extent<<"\">"<<std::endl;
+  OX<<"      <PointData Scalars=\""<<scalarName<<"\">"<<std::endl;
+  OX<<"        <DataArray type=\""<<typeName<<"\" Name=\""<<scalarName
+    <<"\" format=\"appended\" offset=\""<<offsetS<<"\"/>"<<std::endl;
+  OX<<"      </PointData>"<<std::endl;
+  OX<<"      <Coordinates>"<<std::endl;
+  OX<<"        <DataArray type=\"Float32\" Name=\"X\" "
+    "format=\"appended\" offset=\"0\"/>"<<std::endl;
+  OX<<"        <DataArray type=\"Float32\" Name=\"Y\" "
+    "format=\"appended\" offset=\""<<offsetY<<"\"/>"<<std::endl;
+  OX<<"        <DataArray type=\"Float32\" Name=\"Z\" "
+    "format=\"appended\" offset=\""<<offsetZ<<"\"/>"<<std::endl;
+  OX<<"      </Coordinates>"<<std::endl;
+  OX<<"    </Piece>"<<std::endl;
+  OX<<"  </RectilinearGrid>"<<std::endl;
+  OX<<"  <AppendedData encoding=\"raw\">"<<std::endl;
+  OX<<"_";
+  return;
+}
+
+void
+VTKwrite::open(const std::string& FName,const std::string& Title,
+	       const std::vector<double>& X,
+	       const std::vector<double>& Y,
+	       const std::vector<double>& Z)
+  /*!
+    Open the file and write the header/coordinates
+    \param FName :: File name
+    \param Title :: Title [legacy only]
+    \param X :: X coordinates
+    \param Y :: Y coordinates
+    \param Z :: Z coordinates
+  */
+{
+  ELog::RegMethod RegA("VTKwrite","open");
+
+  if (OX.is_open())
+    OX.close();
+
+  nPts[0]=static_cast<long int>(X.size());
+  nPts[1]=static_cast<long int>(Y.size());
+  nPts[2]=static_cast<long int>(Z.size());
+  nSlice=0;
+
+  OX.open(FName.c_str(),std::ios::out | std::ios::binary);
+  if (!OX.good())
+    throw ColErr::FileError(0,FName,"VTK file open");
+
+  if (format==vtkForm::xml)
+    {
+      writeXMLHeader();
+      writeCoord(X);
+      writeCoord(Y);
+      writeCoord(Z);
+      const uint64_t nByte(static_cast<uint64_t>(nPts[0]*nPts[1]*nPts[2])*
+			   ((dataType==vtkData::Int) ?
+			    sizeof(int32_t) : sizeof(float)));
+      writeBlock(reinterpret_cast<const char*>(&nByte),1,sizeof(uint64_t));
+    }
+  else
+    writeLegacyHeader(Title,X,Y,Z);
+
+  return;
+}
+
+void
+VTKwrite::writeSlice(const std::vector<double>& Slice)
+  /*!
+    Write the next z-slice of the scalar data
+    \param Slice :: Values [x fastest then y]
+  */
+{
+  ELog::RegMethod RegA("VTKwrite","writeSlice");
+
+  const size_t NX(static_cast<size_t>(nPts[0]));
+  const size_t nSize(NX*static_cast<size_t>(nPts[1]));
+  if (Slice.size()!=nSize)
+    throw ColErr::MisMatch<size_t>(Slice.size(),nSize,"Slice size");
+  if (nSlice>=nPts[2])
+    throw ColErr::IndexError<long int>(nSlice,nPts[2],"Slice index");
+  nSlice++;
+
+  if (format==vtkForm::ascii)
+    {
+      boost::format fFMT("%1$11.6g%|14t|");
+      boost::format iFMT("%1$12d%|14t|");
+      for(size_t i=0;i<nSize;i++)
+	{
+	  if (dataType==vtkData::Int)
+	    OX<<(iFMT % static_cast<long int>(std::round(Slice[i])));
+	  else
+	    OX<<(fFMT % Slice[i]);
+	  if ((i+1) % NX == 0)
+	    OX<<std::endl;
+	}
+      return;
+    }
+
+  if (dataType==vtkData::Int)
+    {
+      std::vector<int32_t> Out(nSize);
+      for(size_t i=0;i<nSize;i++)
+	Out[i]=static_cast<int32_t>(std::round(Slice[i]));
+      writeBlock(reinterpret_cast<const char*>(Out.data()),
+		 nSize,sizeof(int32_t));
+    }
+  else
+    {
+      std::vector<float> Out(Slice.begin(),Slice.end());
+      writeBlock(reinterpret_cast<const char*>(Out.data()),
+		 nSize,sizeof(float));
+    }
+  return;
+}
+
+void
+VTKwrite::close()
+  /*!
+    Complete and close the file
+  */
+{
+  ELog::RegMethod RegA("VTKwrite","close");
+
+  if (!OX.is_open()) return;
+
+  if (nSlice!=nPts[2])
+    ELog::EM<<"VTK file incomplete : slices written "<<nSlice
+	    <<" of "<<nPts[2]<<ELog::endErr;
+
+  if (format==vtkForm::xml)
+    {
+      OX<<std::endl;
+      OX<<"  </AppendedData>"<<std::endl;
+      OX<<"</VTKFile>"<<std::endl;
+    }
+  else if (format==vtkForm::binary)
+    OX<<std::endl;
+
+  OX.close();
+  return;
+}
@@ -30,7 +30,9 @@
 #include <map>
 #include <set>
 #include <vector>
-#include <boost/format.hpp>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -41,6 +43,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "support.h"
+#include "threadSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
@@ -58,11 +61,13 @@
 #include "objectGroups.h"
 #include "Simulation.h"
 #include "LineTrack.h"
+#include "SimTrack.h"
+#include "VTKwrite.h"
 #include "Visit.h"
 
 Visit::Visit() :
   outType(VISITenum::cellID),
-  lineAverage(0),nPts({0,0,0})
+  lineAverage(0),nThread(0),nPts({0,0,0})
   /*!
     Constructor
   */
@@ -70,7 +75,7 @@ Visit::Visit() :
 
 Visit::Visit(const Visit& A) : 
   outType(A.outType),lineAverage(A.lineAverage),
-  Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),
+  nThread(A.nThread),Origin(A.Origin),XYZ(A.XYZ),nPts(A.nPts),
   mesh(A.mesh)
   /*!
     Copy constructor
@@ -90,6 +95,7 @@ Visit::operator=(const Visit& A)
     {
       outType=A.outType;
       lineAverage=A.lineAverage;
+      nThread=A.nThread;
       Origin=A.Origin;
       XYZ=A.XYZ;
       nPts=A.nPts;
@@ -183,6 +189,27 @@ Visit::getResult(const MonteCarlo::Object* ObjPtr) const
   return 0.0;
 }
 
+double
+Visit::getActiveResult(const Simulation& System,
+		       const std::set<std::string>& Active,
+		       const MonteCarlo::Object* ObjPtr) const
+  /*!
+    Determine the result for an object if it is in
+    one of the active ranges
+    \param System :: Simulation [for the ranges]
+    \param Active :: Active range names [empty for all]
+    \param ObjPtr :: object to calculate for
+    \return determined value / 0.0 if not active
+  */
+{
+  if (Active.empty())
+    return getResult(ObjPtr);
+
+  const std::string rangeStr=System.inRange(ObjPtr->getName());
+  return (Active.find(rangeStr)!=Active.end()) ?
+    getResult(ObjPtr) : 0.0;
+}
+
 void
 Visit::populateLine(const Simulation& System,
 		    const std::set<std::string>& Active)
@@ -222,35 +249,104 @@ Visit::populateLine(const Simulation& System,
     (IMax==1) ? (YStep*XStep).unit()*XYZ[IMax] :
     (XStep*YStep).unit()*XYZ[IMax];
   
-  for(long int i=0;i<nA;i++)
-    for(long int j=0;j<nB;j++)
-      { 
-	std::vector<double> distVec;
-	std::vector<MonteCarlo::Object*> cellVec;
-	
-	const Geometry::Vec3D aVec=Origin+
-	  XStep*(static_cast<double>(i)+0.5)+
-	  YStep*(static_cast<double>(j)+0.5);
-
-	ModelSupport::LineTrack OTrack(aVec,aVec+longStep);
-	OTrack.calculate(System);
-	OTrack.createCellPath(cellVec,distVec);
-
-	double aim=XYZ[IMax];
-	double T=0.0;
-	long int index(0);
-	for(size_t ii=0;ii<cellVec.size();ii++)
-	  {
-	    T+=distVec[ii];
-	    const long int mid=Visit::procPoint(T,stepXYZ[IMax]);
-	    const double mValue=getResult(cellVec[ii]);
-	    
-	    for(long int cnt=0;cnt<mid;cnt++)
-	      getMeshUnit(IMax,index++,i,j)=mValue;
+  // Track one line and fill the mesh
+  auto traceLine=[&](const long int i,const long int j)
+    {
+      std::vector<double> distVec;
+      std::vector<MonteCarlo::Object*> cellVec;
 
-	  }
-      }
-  
+      const Geometry::Vec3D aVec=Origin+
+	XStep*(static_cast<double>(i)+0.5)+
+	YStep*(static_cast<double>(j)+0.5);
+
+      ModelSupport::LineTrack OTrack(aVec,aVec+longStep);
+      OTrack.calculate(System);
+      OTrack.createCellPath(cellVec,distVec);
+      fillLine(IMax,stepXYZ[IMax],i,j,cellVec,distVec);
+    };
+
+  if (nThread<2)
+    {
+      for(long int i=0;i<nA;i++)
+	for(long int j=0;j<nB;j++)
+	  traceLine(i,j);
+      return;
+    }
+
+  // Initial cell of line [as found by LineTrack::calculate]
+  auto firstPoint=[&](const long int i,const long int j)
+    {
+      const Geometry::Vec3D aVec=Origin+
+	XStep*(static_cast<double>(i)+0.5)+
+	YStep*(static_cast<double>(j)+0.5);
+      const Geometry::Vec3D bVec=aVec+longStep;
+      return aVec+(bVec-aVec).unit()*1e-5;
+    };
+
+  const size_t nLine(static_cast<size_t>(nA*nB));
+  std::vector<MonteCarlo::Object*> firstCell(nLine);
+  std::vector<MonteCarlo::Object*> lastCell(nLine);
+  std::atomic<size_t> nextLine(0);
+  ThreadSupport::runThreads(nThread,[&]()
+    {
+      ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
+      ST.addSim(&System);
+      for(size_t L=nextLine++;L<nLine;L=nextLine++)
+	{
+	  const long int i(static_cast<long int>(L)/nB);
+	  const long int j(static_cast<long int>(L)%nB);
+	  firstCell[L]=System.findCell(firstPoint(i,j),0);
+	  traceLine(i,j);
+	  lastCell[L]=ST.curCell(&System);
+	}
+    });
+
+  // A line only depends on the previous line through the
+  // last-cell cache used to find its first cell : re-trace
+  // the lines where the serial order gives a different cell.
+  ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
+  for(size_t L=0;L<nLine;L++)
+    {
+      const long int i(static_cast<long int>(L)/nB);
+      const long int j(static_cast<long int>(L)%nB);
+      if (System.findCell(firstPoint(i,j),0)==firstCell[L])
+	ST.setCell(&System,lastCell[L]);
+      else
+	{
+	  for(long int index=0;index<nC;index++)
+	    getMeshUnit(IMax,index,i,j)=0.0;
+	  traceLine(i,j);
+	}
+    }
+  return;
+}
+
+void
+Visit::fillLine(const size_t IMax,const double lStep,
+		const long int i,const long int j,
+		const std::vector<MonteCarlo::Object*>& cellVec,
+		const std::vector<double>& distVec)
+  /*!
+    Fill the mesh along a line from the cell path
+    \param IMax :: Index of the line direction
+    \param lStep :: Mesh step along the line
+    \param i :: other index in mesh
+    \param j :: other index in mesh
+    \param cellVec :: Cells along the line
+    \param distVec :: Distance in each cell
+  */
+{
+  double T=0.0;
+  long int index(0);
+  for(size_t ii=0;ii<cellVec.size();ii++)
+    {
+      T+=distVec[ii];
+      const long int mid=Visit::procPoint(T,lStep);
+      const double mValue=getResult(cellVec[ii]);
+
+      for(long int cnt=0;cnt<mid;cnt++)
+	getMeshUnit(IMax,index++,i,j)=mValue;
+    }
   return;
 }
 
@@ -311,7 +407,7 @@ Visit::procPoint(double& unitLen,const double lStep)
     \return number to increase
   */
 {
-  ELog::RegMethod RegA("Visit","procPoint");
+  ELog::RegHot RegA("Visit","procPoint");
 
   const long int outCnt=static_cast<long int>(unitLen/lStep);
   unitLen -= static_cast<double>(outCnt)*lStep;
@@ -329,46 +425,86 @@ Visit::populatePoint(const Simulation& System,
 {
   ELog::RegMethod RegA("Visit","populate(set)");
 
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
-  
-  const bool aEmptyFlag=Active.empty();
-
   double stepXYZ[3];
   for(size_t i=0;i<3;i++)
     stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
 
-  for(long int i=0;i<nPts[0];i++)
+  // Centre point of voxel
+  auto voxelPoint=[&](const long int i,const long int j,const long int k)
     {
-      aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
-      for(long int j=0;j<nPts[1];j++)
-        {
-	  aVec[1]=stepXYZ[1]*(0.5+static_cast<double>(j));
+      const Geometry::Vec3D aVec(stepXYZ[0]*(static_cast<double>(i)+0.5),
+				 stepXYZ[1]*(0.5+static_cast<double>(j)),
+				 stepXYZ[2]*(0.5+static_cast<double>(k)));
+      return Origin+aVec;
+    };
+
+  MonteCarlo::Object* ObjPtr(0);
+  if (nThread<2)
+    {
+      for(long int i=0;i<nPts[0];i++)
+	for(long int j=0;j<nPts[1];j++)
 	  for(long int k=0;k<nPts[2];k++)
 	    {
-	      aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=System.findCell(Pt,ObjPtr);
-
-	      // Active Set Code:
-	      if (!aEmptyFlag)
-		{
-		  const std::string rangeStr=
-		    System.inRange(ObjPtr->getName());
-		  if (Active.find(rangeStr)!=Active.end())
-		    mesh[i][j][k]=getResult(ObjPtr);
-		  else
-		    mesh[i][j][k]=0.0;
-		}
-	      // OLD Code:
-	      else
-		{
-		  mesh[i][j][k]=getResult(ObjPtr);
-		}
-
+	      ObjPtr=System.findCell(voxelPoint(i,j,k),ObjPtr);
+	      mesh[i][j][k]=getActiveResult(System,Active,ObjPtr);
 	    }
+      return;
+    }
+
+  // Each thread takes whole planes of constant i
+  const size_t nPlane(static_cast<size_t>(nPts[1]*nPts[2]));
+  std::vector<MonteCarlo::Object*> cellMesh
+    (static_cast<size_t>(nPts[0])*nPlane);
+  std::atomic<long int> nextPlane(0);
+  ThreadSupport::runThreads(nThread,[&]()
+    {
+      ModelSupport::SimTrack::Instance().addSim(&System);
+      for(long int i=nextPlane++;i<nPts[0];i=nextPlane++)
+	{
+	  size_t index(static_cast<size_t>(i)*nPlane);
+	  MonteCarlo::Object* OPtr(0);
+	  for(long int j=0;j<nPts[1];j++)
+	    for(long int k=0;k<nPts[2];k++)
+	      {
+		OPtr=System.findCell(voxelPoint(i,j,k),OPtr);
+		cellMesh[index++]=OPtr;
+	      }
 	}
+    });
+
+  // A plane only depends on the previous plane through the
+  // last cell found : redo each plane in serial order until
+  // the result agrees with the thread result, after which the
+  // search sequence is the same.
+  ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
+  for(long int i=0;i<nPts[0];i++)
+    {
+      size_t index(static_cast<size_t>(i)*nPlane);
+      const size_t lastIndex(index+nPlane-1);
+      for(long int j=0;j<nPts[1] && index<=lastIndex;j++)
+	for(long int k=0;k<nPts[2] && index<=lastIndex;k++)
+	  {
+	    ObjPtr=System.findCell(voxelPoint(i,j,k),ObjPtr);
+	    if (ObjPtr==cellMesh[index])
+	      {
+		ObjPtr=cellMesh[lastIndex];
+		ST.setCell(&System,ObjPtr);
+		index=lastIndex+1;
+	      }
+	    else
+	      cellMesh[index++]=ObjPtr;
+	  }
     }
+
+  // Results need the corrected cellMesh from the serial pass
+  // above; the lookup is cheap relative to findCell so it is
+  // not threaded.
+  size_t index(0);
+  for(long int i=0;i<nPts[0];i++)
+    for(long int j=0;j<nPts[1];j++)
+      for(long int k=0;k<nPts[2];k++)
+	mesh[i][j][k]=getActiveResult(System,Active,cellMesh[index++]);
+
   return;
 }
 
@@ -393,107 +529,50 @@ Visit::populate(const Simulation& System,
 
 
 void
-Visit::writeVTK(const std::string& FName) const
+Visit::writeVTK(const std::string& FName,
+		const VTKwrite::vtkForm fileForm) const
   /*!
-    Write out a VTK cell
+    Write out a VTK file : cellID and material are 
+    written as integers. The mesh is written one z-slice 
+    at a time.
     \param FName :: filename 
+    \param fileForm :: ascii/binary/xml format
   */
 {
-  if (FName.empty()) return;
-  std::ofstream OX(FName.c_str());
-  std::ostringstream cx;
-  boost::format fFMT("%1$11.6g%|14t|");
+  ELog::RegMethod RegA("Visit","writeVTK");
   
-  double stepXYZ[3];
-  for(size_t i=0;i<3;i++)
-    stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
-  
-  OX<<"# vtk DataFile Version 2.0"<<std::endl;
-  OX<<"chipIR Data"<<std::endl;
-  OX<<"ASCII"<<std::endl;
-  OX<<"DATASET RECTILINEAR_GRID"<<std::endl;
-  OX<<"DIMENSIONS "<<nPts[0]<<" "<<nPts[1]<<" "<<nPts[2]<<std::endl;
-  OX<<"X_COORDINATES "<<nPts[0]<<" float"<<std::endl;
-  for(int i=0;i<nPts[0];i++)
-    OX<<(fFMT % (Origin[0]+stepXYZ[0]*(static_cast<double>(i)+0.5)));
-  OX<<std::endl;
-
-  OX<<"Y_COORDINATES "<<nPts[1]<<" float"<<std::endl;
-  for(long int i=0;i<nPts[1];i++)
-    OX<<(fFMT % (Origin[1]+stepXYZ[1]*(static_cast<double>(i)+0.5)));
-  OX<<std::endl;
-
-  OX<<"Z_COORDINATES "<<nPts[2]<<" float"<<std::endl;
-  for(int i=0;i<nPts[2];i++) 
-    OX<<(fFMT % (Origin[2]+stepXYZ[2]*(static_cast<double>(i)+0.5)));
-  OX<<std::endl;
-
-  OX<<"POINT_DATA "<<nPts[0]*nPts[1]*nPts[2]<<std::endl;
-  OX<<"SCALARS cellID float 1.0"<<std::endl;
-  OX<<"LOOKUP_TABLE default"<<std::endl;
+  if (FName.empty()) return;
 
-  for(long int k=0;k<nPts[2];k++)
-    for(long int j=0;j<nPts[1];j++)
-      {
-	for(long int i=0;i<nPts[0];i++)
-	  OX<<(fFMT % (mesh[i][j][k]));
-	OX<<std::endl;
-      }
-  OX.close();
-  return;
-}
+  static const std::map<VISITenum,std::string> scalarName
+    ({ {VISITenum::cellID,"cellID"},
+       {VISITenum::material,"material"},
+       {VISITenum::density,"density"},
+       {VISITenum::weight,"weight"} });
 
-void
-Visit::writeIntegerVTK(const std::string& FName) const
-  /*!
-    Write out a VTK cell
-    \param FName :: filename 
-  */
-{
-  if (FName.empty()) return;
-  std::ofstream OX(FName.c_str());
-  std::ostringstream cx;
-  boost::format fFMT("%1$11.6g%|14t|");
-  boost::format iFMT("%1$12d%|14t|");
-  
-  double stepXYZ[3];
+  const VTKwrite::vtkData dataType=
+    (outType==VISITenum::cellID || outType==VISITenum::material) ?
+    VTKwrite::vtkData::Int : VTKwrite::vtkData::Float;
+
+  std::vector<double> Coord[3];
   for(size_t i=0;i<3;i++)
-    stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
-  
-  OX<<"# vtk DataFile Version 2.0"<<std::endl;
-  OX<<"chipIR Data"<<std::endl;
-  OX<<"ASCII"<<std::endl;
-  OX<<"DATASET RECTILINEAR_GRID"<<std::endl;
-  OX<<"DIMENSIONS "<<nPts[0]<<" "<<nPts[1]<<" "<<nPts[2]<<std::endl;
-  OX<<"X_COORDINATES "<<nPts[0]<<" float"<<std::endl;
-  for(int i=0;i<nPts[0];i++)
-    OX<<(fFMT % (Origin[0]+stepXYZ[0]*(static_cast<double>(i)+0.5)));
-  OX<<std::endl;
-
-  OX<<"Y_COORDINATES "<<nPts[1]<<" float"<<std::endl;
-  for(long int i=0;i<nPts[1];i++)
-    OX<<(fFMT % (Origin[1]+stepXYZ[1]*(static_cast<double>(i)+0.5)));
-  OX<<std::endl;
-
-  OX<<"Z_COORDINATES "<<nPts[2]<<" float"<<std::endl;
-  for(int i=0;i<nPts[2];i++) 
-    OX<<(fFMT % (Origin[2]+stepXYZ[2]*(static_cast<double>(i)+0.5)));
-  OX<<std::endl;
-
-  OX<<"POINT_DATA "<<nPts[0]*nPts[1]*nPts[2]<<std::endl;
-  OX<<"SCALARS cellID int 1.0"<<std::endl;
-  OX<<"LOOKUP_TABLE default"<<std::endl;
+    {
+      const double stepXYZ=XYZ[i]/static_cast<double>(nPts[i]);
+      for(long int j=0;j<nPts[i];j++)
+	Coord[i].push_back(Origin[i]+stepXYZ*(static_cast<double>(j)+0.5));
+    }
 
+  VTKwrite VW(fileForm,dataType,scalarName.at(outType));
+  VW.open(FName,"chipIR Data",Coord[0],Coord[1],Coord[2]);
 
+  std::vector<double> Slice(static_cast<size_t>(nPts[0]*nPts[1]));
   for(long int k=0;k<nPts[2];k++)
-    for(long int j=0;j<nPts[1];j++)
-      {
+    {
+      size_t index(0);
+      for(long int j=0;j<nPts[1];j++)
 	for(long int i=0;i<nPts[0];i++)
-	  
-	  OX<<(iFMT %
-	       static_cast<long int>(std::round(mesh[i][j][k])));
-	OX<<std::endl;
-      }
-  OX.close();
+	  Slice[index++]=mesh[i][j][k];
+      VW.writeSlice(Slice);
+    }
+  VW.close();
   return;
 }
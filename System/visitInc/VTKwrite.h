@@ -0,0 +1,89 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   visitInc/VTKwrite.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef VTKwrite_h
+#define VTKwrite_h
+
+/*!
+  \class VTKwrite
+  \brief Streamed writer of a rectilinear VTK grid
+  \date June 2018
+  \author S. Ansell
+  \version 1.0
+
+  The header and coordinates are written by open. The
+  scalar data is then written one z-slice at a time [x fastest]
+  so the caller does not need to hold a second copy of the mesh.
+  Formats are legacy ASCII, legacy binary [big endian] and XML
+  RectilinearGrid [.vtr] with raw appended data.
+*/
+
+class VTKwrite
+{
+ public:
+
+  /// File format
+  enum class vtkForm : int
+  { ascii=0,binary=1,xml=2 };
+
+  /// Scalar data type
+  enum class vtkData : int
+  { Float=0,Int=1 };
+
+ private:
+
+  const vtkForm format;          ///< File format
+  const vtkData dataType;        ///< Type of scalar
+  const std::string scalarName;  ///< Name of scalar
+
+  std::ofstream OX;              ///< Output stream
+  std::array<long int,3> nPts;   ///< Number of x/y/z points
+  long int nSlice;               ///< Number of slices written
+
+  static bool isBigEndian();
+  void writeBlock(const char*,const size_t,const size_t);
+  void writeCoord(const std::vector<double>&);
+  void writeXMLHeader();
+  void writeLegacyHeader(const std::string&,
+			 const std::vector<double>&,
+			 const std::vector<double>&,
+			 const std::vector<double>&);
+
+ public:
+
+  VTKwrite(const vtkForm,const vtkData,const std::string&);
+  VTKwrite(const VTKwrite&) =delete;
+  VTKwrite& operator=(const VTKwrite&) =delete;
+  ~VTKwrite();
+
+  static vtkForm getForm(const std::string&);
+  static bool isForm(const std::string&);
+
+  void open(const std::string&,const std::string&,
+	    const std::vector<double>&,
+	    const std::vector<double>&,
+	    const std::vector<double>&);
+  void writeSlice(const std::vector<double>&);
+  void close();
+};
+
+
+#endif
@@ -34,7 +34,6 @@ class Object;
   \date August 2010
   \author S. Ansell
   \version 1.0
-  \todo Move to a binary/xml output schema
 
   This allows comparison of the vector for removing non-unique
   Vec3D from a list
@@ -52,6 +51,7 @@ class Visit
   
   VISITenum outType;          ///< Output type
   bool lineAverage;           ///< set line average
+  size_t nThread;             ///< Threads for population [0/1 serial]
   
   Geometry::Vec3D Origin;     ///< Origin
   Geometry::Vec3D XYZ;        ///< XYZ extent
@@ -67,6 +67,12 @@ class Visit
 
   double& getMeshUnit(const size_t,const long int,const long in
 		      ,const long int);
+  double getActiveResult(const Simulation&,const std::set<std::string>&,
+			 const MonteCarlo::Object*) const;
+  void fillLine(const size_t,const double,const long int,const long int,
+		const std::vector<MonteCarlo::Object*>&,
+		const std::vector<double>&);
+
  public:
 
   Visit();
@@ -76,6 +82,8 @@ class Visit
 
   /// make an average over the line from beginning to end
   void setLineForm() { lineAverage=1; }
+  /// Set the number of threads used to populate the mesh
+  void setThreads(const size_t N) { nThread=N; }
   void setType(const VISITenum&);
   void setBox(const Geometry::Vec3D&,
               const Geometry::Vec3D&);
@@ -84,8 +92,7 @@ class Visit
   void populateLine(const Simulation&,const std::set<std::string>&);
   void populatePoint(const Simulation&,const std::set<std::string>&);
   void populate(const Simulation&,const std::set<std::string>&);
-  void writeVTK(const std::string&) const;
-  void writeIntegerVTK(const std::string&) const;
+  void writeVTK(const std::string&,const VTKwrite::vtkForm) const;
 };
 
 
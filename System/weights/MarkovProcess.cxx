@@ -25,12 +25,15 @@
 #include <cmath>
 #include <complex> 
 #include <vector>
+#include <array>
 #include <list>
 #include <set>
 #include <map> 
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <atomic>
+#include <functional>
 #include <boost/multi_array.hpp>
 
 #include "Exception.h"
@@ -43,6 +46,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "threadSupport.h"
 #include "MapSupport.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
@@ -62,8 +66,10 @@
 #include "Simulation.h"
 
 #include "LineTrack.h"
+#include "SimTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "VTKwrite.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 
@@ -74,15 +80,19 @@ namespace WeightSystem
 {
 
 
-MarkovProcess::MarkovProcess()
+MarkovProcess::MarkovProcess() :
+  nThread(ThreadSupport::defaultThreads()),nIteration(0),
+  WX(0),WY(0),WZ(0),WE(0),FSize(0)
  /*! 
     Constructor 
   */
 {}
 
 MarkovProcess::MarkovProcess(const MarkovProcess& A) : 
-  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),
-  FSize(A.FSize),fluxField(A.fluxField)
+  nThread(A.nThread),nIteration(A.nIteration),
+  WX(A.WX),WY(A.WY),WZ(A.WZ),WE(A.WE),FSize(A.FSize),
+  rowIndex(A.rowIndex),colIndex(A.colIndex),TValue(A.TValue),
+  fluxField(A.fluxField)
   /*!
     Copy constructor
     \param A :: MarkovProcess to copy
@@ -99,11 +109,16 @@ MarkovProcess::operator=(const MarkovProcess& A)
 {
   if (this!=&A)
     {
+      nThread=A.nThread;
       nIteration=A.nIteration;
       WX=A.WX;
       WY=A.WY;
       WZ=A.WZ;
+      WE=A.WE;
       FSize=A.FSize;
+      rowIndex=A.rowIndex;
+      colIndex=A.colIndex;
+      TValue=A.TValue;
       fluxField=A.fluxField;
     }
   return *this;
@@ -118,22 +133,44 @@ MarkovProcess::~MarkovProcess()
 void
 MarkovProcess::initializeData(const WWG& wSet)
   /*!
-    Initialize all the values before execusion
+    Initialize all the values before execusion.
+    The flux starts from the current WWG mesh.
     \param wSet :: wwg
   */
 {
   ELog::RegMethod RegA("MarkovProcess","initialize");
 
   const Geometry::Mesh3D& grid=wSet.getGrid();
+  const WWGWeight& WMesh=wSet.getMesh();
   
   WX=static_cast<long int>(grid.getXSize());
   WY=static_cast<long int>(grid.getYSize());
   WZ=static_cast<long int>(grid.getZSize());
+  WE=WMesh.getESize();
 
   FSize=WX*WY*WZ;
-  
-  fluxField.resize(boost::extents[FSize][FSize]);
-  
+
+  if (!WMesh.isSized(WX,WY,WZ,WE))
+    throw ColErr::MisMatch<long int>
+      (WMesh.getXSize()*WMesh.getYSize()*WMesh.getZSize(),
+       FSize,"WWG mesh != grid");
+
+  rowIndex.clear();
+  colIndex.clear();
+  TValue.clear();
+
+  const boost::multi_array<double,4>& WGrid=WMesh.getGrid();
+  fluxField.resize(static_cast<size_t>(WE));
+  for(long int IE=0;IE<WE;IE++)
+    {
+      std::vector<double>& flux=fluxField[static_cast<size_t>(IE)];
+      flux.resize(static_cast<size_t>(FSize));
+      size_t index(0);
+      for(long int i=0;i<WX;i++)
+	for(long int j=0;j<WY;j++)
+	  for(long int k=0;k<WZ;k++)
+	    flux[index++]=exp(WGrid[i][j][k][IE]);
+    }
   return;
 }
 
@@ -144,7 +181,9 @@ MarkovProcess::computeMatrix(const Simulation& System,
 			     const double r2Length,
 			     const double r2Power)
   /*!
-    Calculate the Markov chain process
+    Calculate the Markov chain transfer matrix. Only
+    the values with a log factor above -20 are kept.
+    The rows are split between nThread threads.
     \param System :: Simualation
     \param wSet :: WWG set for grid
     \param densityFactor :: Scaling factor for density
@@ -154,46 +193,178 @@ MarkovProcess::computeMatrix(const Simulation& System,
 {
   ELog::RegMethod RegA("MarkovProcess","computeMatrix");
 
-  const Geometry::Mesh3D& grid=wSet.getGrid();
-  const std::vector<Geometry::Vec3D> midPts=wSet.getMidPoints();
+  const double logCut(-20.0);
+  const std::vector<Geometry::Vec3D>& midPts=wSet.getMidPoints();
 
   if (static_cast<long int>(midPts.size())!=FSize)
     throw ColErr::MisMatch<long int>
       (static_cast<long int>(midPts.size()),FSize,"MidPts.size != FSize");
 
-  for(long int i=0;i<FSize;i++)
-    fluxField[i][i]=1.0;
+  // attenuation only reduces the factor : so points further
+  // apart than this are below the cut without tracking
+  const double maxDist=(densityFactor>=0.0 && r2Power>Geometry::zeroTol) ?
+    r2Length*exp(-logCut/r2Power) : -1.0;
+  
+  // material table is built here : not lazily in the threads
+  const std::vector<double> attnTable=
+    ModelSupport::ObjectTrackAct::getAttnTable(0.0);
+  
+  // matrix is symmetric : each row holds its j>i values
+  typedef std::vector<std::pair<long int,double>> ROWTYPE;
+  const size_t NF(static_cast<size_t>(FSize));
+  std::vector<ROWTYPE> upperRow(NF);
+  
+  std::atomic<size_t> nextRow(0);
+  ThreadSupport::runThreads(nThread,[&]()
+    {
+      ModelSupport::SimTrack::Instance().addSim(&System);
+      for(size_t i=nextRow++;i<NF;i=nextRow++)
+	{
+	  ModelSupport::ObjectTrackPoint OTrack(midPts[i]);
+	  for(size_t j=i+1;j<NF;j++)
+	    {
+	      if (maxDist>0.0 && midPts[i].Distance(midPts[j])>=maxDist)
+		continue;
+	      const long int lJ(static_cast<long int>(j));
+	      OTrack.addUnit(System,lJ,midPts[j]);
+	      double DistT=OTrack.getDistance(lJ)/r2Length;
+	      if (DistT<1.0) DistT=1.0;
+	      const double AT=OTrack.getAttnSum(lJ,attnTable);
+	      const double WFactor= -densityFactor*AT-r2Power*log(DistT);
+	      if (WFactor>logCut)
+		upperRow[i].push_back(ROWTYPE::value_type(lJ,exp(WFactor)));
+	      OTrack.clearAll();
+	    }
+	}
+    });
+
+  // CSR assembly : rows filled in increasing column order
+  rowIndex.assign(NF+1,0);
+  for(size_t i=0;i<NF;i++)
+    {
+      rowIndex[i+1]++;
+      for(const ROWTYPE::value_type& JV : upperRow[i])
+	{
+	  rowIndex[i+1]++;
+	  rowIndex[static_cast<size_t>(JV.first)+1]++;
+	}
+    }
+  for(size_t i=0;i<NF;i++)
+    rowIndex[i+1]+=rowIndex[i];
+
+  colIndex.resize(rowIndex[NF]);
+  TValue.resize(rowIndex[NF]);
+  std::vector<size_t> fillPos(rowIndex.begin(),rowIndex.end()-1);
+  for(size_t i=0;i<NF;i++)
+    {
+      colIndex[fillPos[i]]=static_cast<long int>(i);
+      TValue[fillPos[i]++]=1.0;
+      for(const ROWTYPE::value_type& JV : upperRow[i])
+	{
+	  const size_t j(static_cast<size_t>(JV.first));
+	  colIndex[fillPos[i]]=JV.first;
+	  TValue[fillPos[i]++]=JV.second;
+	  colIndex[fillPos[j]]=static_cast<long int>(i);
+	  TValue[fillPos[j]++]=JV.second;
+	}
+      ROWTYPE().swap(upperRow[i]);
+    }
+  
+  ELog::EM<<"Markov matrix entries: "<<TValue.size()<<" of "
+	  <<NF*NF<<ELog::endDiag;
+  return;
+}
+
+void
+MarkovProcess::sparseMultiply()
+  /*!
+    Multiply the flux by the transfer matrix and
+    normalize each energy bin to a maximum of 1.0.
+  */
+{
+  ELog::RegMethod RegA("MarkovProcess","sparseMultiply");
+
+  const size_t NF(static_cast<size_t>(FSize));
+  const size_t blockSize(256);
+  std::vector<std::vector<double>> outFlux
+    (fluxField.size(),std::vector<double>(NF,0.0));
 
-  for(long int i=0;i<FSize;i++)
+  std::atomic<size_t> nextBlock(0);
+  ThreadSupport::runThreads(nThread,[&]()
     {
-      const size_t uI(static_cast<size_t>(i));
-      ModelSupport::ObjectTrackPoint OTrack(midPts[uI]); 
-      for(long int j=i+1;j<FSize;j++)
+      for(size_t iStart=blockSize*nextBlock++;iStart<NF;
+	  iStart=blockSize*nextBlock++)
 	{
-	  const size_t uJ(static_cast<size_t>(i));
-	  OTrack.addUnit(System,j,midPts[uJ]);
-	  double DistT=OTrack.getDistance(j)/r2Length;
-	  if (DistT<1.0) DistT=1.0;
-	  const double AT=OTrack.getAttnSum(j);  // this can take an
-	  const double WFactor= -densityFactor*AT-r2Power*log(DistT);
-	  if (WFactor>-20)
-	    fluxField[i][j]=fluxField[j][i]= -WFactor;
-	  else
-	    fluxField[i][j]=fluxField[j][i]=0.0;
+	  const size_t iEnd(std::min(NF,iStart+blockSize));
+	  for(size_t IE=0;IE<fluxField.size();IE++)
+	    {
+	      const std::vector<double>& flux=fluxField[IE];
+	      std::vector<double>& out=outFlux[IE];
+	      for(size_t i=iStart;i<iEnd;i++)
+		{
+		  double sum(0.0);
+		  for(size_t index=rowIndex[i];index<rowIndex[i+1];index++)
+		    sum+=TValue[index]*
+		      flux[static_cast<size_t>(colIndex[index])];
+		  out[i]=sum;
+		}
+	    }
 	}
+    });
+
+  for(std::vector<double>& flux : outFlux)
+    {
+      const double maxFlux=(flux.empty()) ? 0.0 :
+	*std::max_element(flux.begin(),flux.end());
+      if (maxFlux>0.0)
+	for(double& F : flux)
+	  F/=maxFlux;
     }
+  fluxField.swap(outFlux);
   return;
 }
 
 void
-MarkovProcess::multiplyOut(const size_t index)
+MarkovProcess::multiplyOut(const size_t nMult)
+  /*!
+    Apply the transfer matrix nMult times to the flux
+    \param nMult :: Number of multiplications
+  */
 {
+  ELog::RegMethod RegA("MarkovProcess","multiplyOut");
+
+  if (rowIndex.size()!=static_cast<size_t>(FSize)+1)
+    throw ColErr::EmptyValue<void>("Markov matrix not computed");
+
+  for(size_t i=0;i<nMult;i++)
+    sparseMultiply();
+  nIteration+=nMult;
   return;
 }
 
 void
-MarkovProcess::rePopulateWWG() 
+MarkovProcess::rePopulateWWG(WWG& wSet) const
+  /*!
+    Set the WWG master mesh to the log of the flux
+    \param wSet :: WWG to update
+  */
 {
+  ELog::RegMethod RegA("MarkovProcess","rePopulateWWG");
+
+  // floor for points that the flux never reached
+  const double minLog(-100.0);
+  
+  WWGWeight WMesh(wSet.getMesh());
+  for(long int IE=0;IE<WE;IE++)
+    {
+      const std::vector<double>& flux=fluxField[static_cast<size_t>(IE)];
+      for(long int i=0;i<FSize;i++)
+	{
+	  const double F(flux[static_cast<size_t>(i)]);
+	  WMesh.setLogPoint(i,IE,(F>0.0) ? std::max(minLog,log(F)) : minLog);
+	}
+    }
+  wSet.updateWM(WMesh,1.0);
   return;
 }
   
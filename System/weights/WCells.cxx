@@ -445,6 +445,30 @@ WCells::renumberCell(const int oldIndex,const int newIndex)
   return;
 }
 
+void
+WCells::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the cells in one pass [RMap can be a 
+    permutation]. No checking or error report on missing cell
+    \param RMap :: Map of oldIndex : newIndex
+  */
+{
+  ELog::RegMethod RegA("WCells","renumberCell");
+
+  ItemTYPE newWVal;
+  for(ItemTYPE::value_type& WI : WVal)
+    {
+      const std::map<int,int>::const_iterator mc=RMap.find(WI.first);
+      const int newIndex=(mc==RMap.end()) ? WI.first : mc->second;
+      WI.second.setCellNumber(newIndex);
+      if (!newWVal.insert(ItemTYPE::value_type(newIndex,WI.second)).second)
+	ELog::EM<<"New point found "<<WI.first<<" "<<newIndex<<
+	  ELog::endCrit;
+    }
+  WVal.swap(newWVal);
+  return;
+}
+
 void
 WCells::writeTable(std::ostream& OX) const
   /*!
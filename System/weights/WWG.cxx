@@ -27,6 +27,7 @@
 #include <complex>
 #include <list>
 #include <vector>
+#include <array>
 #include <set>
 #include <map>
 #include <string>
@@ -60,6 +61,7 @@
 #include "objectRegister.h"
 #include "inputParam.h"
 #include "Mesh3D.h"
+#include "VTKwrite.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 
@@ -79,7 +81,7 @@ WWG::WWG() :
 WWG::WWG(const WWG& A) : 
   pType(A.pType),wupn(A.wupn),wsurv(A.wsurv),maxsp(A.maxsp),
   mwhere(A.mwhere),mtime(A.mtime),switchn(A.switchn),
-  EBin(A.EBin),Grid(A.Grid),WMesh(A.WMesh)
+  EBin(A.EBin),Grid(A.Grid),GridMidPt(A.GridMidPt),WMesh(A.WMesh)
   /*!
     Copy constructor
     \param A :: WWG to copy
@@ -105,6 +107,7 @@ WWG::operator=(const WWG& A)
       switchn=A.switchn;
       EBin=A.EBin;
       Grid=A.Grid;
+      GridMidPt=A.GridMidPt;
       WMesh=A.WMesh;
     }
   return *this;
@@ -361,52 +364,31 @@ WWG::writeWWINP(const std::string& FName) const
 
 void
 WWG::writeVTK(const std::string& FName,
+	      const VTKwrite::vtkForm fileForm,
 	      const long int EIndex) const
   /*!
     Write out a VTK file
     \param FName :: filename 
+    \param fileForm :: ascii/binary/xml format
     \param EIndex :: energy index
   */
 {
   ELog::RegMethod RegA("WWG","writeVTK");
 
   if (FName.empty()) return;
-  std::ofstream OX(FName.c_str());
 
-  const long int XSize=WMesh.getXSize();
-  const long int YSize=WMesh.getYSize();
-  const long int ZSize=WMesh.getZSize();
-  
-  boost::format fFMT("%1$11.6g%|14t|");  
-  OX<<"# vtk DataFile Version 2.0"<<std::endl;
-  OX<<"WWG-MESH Data"<<std::endl;
-  OX<<"ASCII"<<std::endl;
-  OX<<"DATASET RECTILINEAR_GRID"<<std::endl;
-
-  OX<<"DIMENSIONS "<<XSize<<" "<<YSize<<" "<<ZSize<<std::endl;
-  OX<<"X_COORDINATES "<<XSize<<" float"<<std::endl;
-  for(long int i=0;i<XSize;i++)
-    OX<<(fFMT % Grid.getXCoordinate(static_cast<size_t>(i)));
-  OX<<std::endl;
-  
-  OX<<"Y_COORDINATES "<<YSize<<" float"<<std::endl;
-  for(long int i=0;i<YSize;i++)
-    OX<<(fFMT % Grid.getYCoordinate(static_cast<size_t>(i)));
-  OX<<std::endl;
-
-  OX<<"Z_COORDINATES "<<ZSize<<" float"<<std::endl;
-  for(long int i=0;i<ZSize;i++)
-    OX<<(fFMT % Grid.getZCoordinate(static_cast<size_t>(i)));
-  OX<<std::endl;
-  
-  OX<<"POINT_DATA "<<XSize*YSize*ZSize<<std::endl;
-  OX<<"SCALARS cellID float 1.0"<<std::endl;
-  OX<<"LOOKUP_TABLE default"<<std::endl;
-
-  WMesh.writeVTK(OX,EIndex);
-  
-  
-  OX.close();
+  std::vector<double> Coord[3];
+  for(long int i=0;i<WMesh.getXSize();i++)
+    Coord[0].push_back(Grid.getXCoordinate(static_cast<size_t>(i)));
+  for(long int i=0;i<WMesh.getYSize();i++)
+    Coord[1].push_back(Grid.getYCoordinate(static_cast<size_t>(i)));
+  for(long int i=0;i<WMesh.getZSize();i++)
+    Coord[2].push_back(Grid.getZCoordinate(static_cast<size_t>(i)));
+
+  VTKwrite VW(fileForm,VTKwrite::vtkData::Float,"weight");
+  VW.open(FName,"WWG-MESH Data",Coord[0],Coord[1],Coord[2]);
+  WMesh.writeVTK(VW,EIndex);
+  VW.close();
 
   return;
 }
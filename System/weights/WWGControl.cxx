@@ -27,6 +27,7 @@
 #include <complex>
 #include <list>
 #include <vector>
+#include <array>
 #include <set>
 #include <map>
 #include <string>
@@ -79,6 +80,7 @@
 #include "ObjectTrackPlane.h"
 #include "Mesh3D.h"
 #include "WWGItem.h"
+#include "VTKwrite.h"
 #include "WWGWeight.h"
 #include "MarkovProcess.h"
 #include "WeightControl.h"
@@ -336,7 +338,7 @@ WWGControl::wwgMarkov(const Simulation& System,
 	  MCalc.initializeData(wwg);
 	  MCalc.computeMatrix(System,wwg,density,r2Length,r2Power);
 	  MCalc.multiplyOut(nMult);
-	  MCalc.rePopulateWWG();
+	  MCalc.rePopulateWWG(wwg);
 	  ELog::EM<<"MARKOV FINISHED"<<ELog::endDiag;
 	}
     }
@@ -411,7 +413,16 @@ WWGControl::wwgVTK(const mainSystem::inputParam& IParam)
       WWG& wwg=WM.getWWG();
       const std::string FName=
 	IParam.getValue<std::string>("wwgVTK",0);
-      wwg.writeVTK(FName);
+      // file format from vtkType [ascii/binary/xml]
+      VTKwrite::vtkForm fileForm(VTKwrite::vtkForm::ascii);
+      const size_t nType=IParam.itemCnt("vtkType",0);
+      for(size_t i=0;i<nType;i++)
+	{
+	  const std::string Item=IParam.getValue<std::string>("vtkType",i);
+	  if (VTKwrite::isForm(Item))
+	    fileForm=VTKwrite::getForm(Item);
+	}
+      wwg.writeVTK(FName,fileForm);
     }
   return;
 }
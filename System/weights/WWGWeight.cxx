@@ -25,6 +25,7 @@
 #include <cmath>
 #include <complex> 
 #include <vector>
+#include <array>
 #include <list>
 #include <set>
 #include <map> 
@@ -32,7 +33,6 @@
 #include <algorithm>
 #include <memory>
 #include <boost/multi_array.hpp>
-#include <boost/format.hpp>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -76,6 +76,7 @@
 #include "ObjectTrackPlane.h"
 #include "weightManager.h"
 #include "WWGItem.h"
+#include "VTKwrite.h"
 #include "WWGWeight.h"
 
 namespace WeightSystem
@@ -153,6 +154,10 @@ WWGWeight::resize(const long int LX,const long int LY,
     \param LE :: Energy coorindate size
    */
 {
+  WX=LX;
+  WY=LY;
+  WZ=LZ;
+  WE=LE;
   WGrid.resize(boost::extents[LX][LY][LZ][LE]);
   return;
 }
@@ -471,18 +476,37 @@ WWGWeight::wTrack(const Simulation& System,
 {
   ELog::RegMethod RegA("WWGWeight","wTrack");
 
+  typedef typename std::conditional<
+    std::is_same<T,Geometry::Plane>::value,
+    ModelSupport::ObjectTrackPlane,
+    ModelSupport::ObjectTrackPoint>::type TrackType;
+
   long int cN(1);
   ELog::EM<<"Processing  "<<MidPt.size()<<" for WWG"<<ELog::endDiag;
 
   const long int NCut(static_cast<long int>(MidPt.size())/5);
+  // attenuation of each material in each energy band
+  std::vector<std::vector<double>> attnTable;
+  for(long int index=0;index<WE;index++)
+    attnTable.push_back
+      (ModelSupport::ObjectTrackAct::getAttnTable
+       (1e-6+EBand[static_cast<size_t>(index)]));
+  
   for(const Geometry::Vec3D& Pt : MidPt)
     {
+      // track once : only the attenuation depends on energy
+      TrackType OTrack(initPt);
+      OTrack.addUnit(System,1,Pt);
+      double DistT=OTrack.getDistance(1)*r2Length;
+      if (DistT<1.0) DistT=1.0;
+      const double rFactor=r2Power*log(DistT);
+
       for(long int index=0;index<WE;index++)
 	{
-	  const double EVal=1e-6+EBand[static_cast<size_t>(index)];
-	  const double DT=
-	    distTrack(System,initPt,EVal,Pt,densityFactor,r2Length,r2Power);
-                                                // energy
+	  const double AT=OTrack.getAttnSum
+	    (1,attnTable[static_cast<size_t>(index)]);
+	  const double DT=-densityFactor*AT-rFactor;
+
 	  if (!((cN-1) % NCut))
 	    ELog::EM<<"WTRAC["<<cN<<"] "<<DT<<ELog::endDiag;
 	  
@@ -655,29 +679,29 @@ WWGWeight::writeWWINP(std::ostream& OX) const
 }
 
 void
-WWGWeight::writeVTK(std::ostream& OX,
+WWGWeight::writeVTK(VTKwrite& VW,
 		    const long int EIndex) const
   /*!
-    Write out the VTK format [write log format]
-    \param OX :: Output stream
+    Write out the VTK data [write exp of log form]
+    one z-slice at a time
+    \param VW :: Open VTK writer
     \param EIndex :: energy index
   */
 {
   ELog::RegMethod RegA("WWGWeight","writeVTK");
 
-  boost::format fFMT("%1$11.6g%|14t|");
-
   if (EIndex<0 || EIndex>=WE)
     throw ColErr::IndexError<long int>(EIndex,WE,"index in WMesh.ESize");
-  
+
+  std::vector<double> Slice(static_cast<size_t>(WX*WY));
   for(long int K=0;K<WZ;K++)
-    for(long int J=0;J<WY;J++)
-      {
+    {
+      size_t index(0);
+      for(long int J=0;J<WY;J++)
 	for(long int I=0;I<WX;I++)
-	  OX<<(fFMT % std::exp(WGrid[I][J][K][EIndex]));
-	OX<<std::endl;
-      }
-  
+	  Slice[index++]=std::exp(WGrid[I][J][K][EIndex]);
+      VW.writeSlice(Slice);
+    }
   return;
 }
 
@@ -96,7 +96,7 @@ WeightControl::help()
   ELog::EM<<"-- wwgCalc --::"<<ELog::endDiag;
   ELog::EM<<"-- wwgMarkov --::"<<ELog::endDiag;
   ELog::EM<<"-- wwgRPtMesh -- set hte reference point for the mesh ::"<<ELog::endDiag;
-  ELog::EM<<"-- wwgVTK --::"<<ELog::endDiag;
+  ELog::EM<<"-- wwgVTK -- file :: format from -vtkType [ascii/binary/xml]"<<ELog::endDiag;
   procCalcHelp();
 
   ELog::EM<<"-- wFCL --:: Set forced collision"<<ELog::endDiag;
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <fstream>
 #include <vector>
+#include <array>
 #include <map>
 #include <set>
 #include <string>
@@ -56,6 +57,7 @@
 #include "WItem.h"
 #include "WCells.h"
 #include "Mesh3D.h"
+#include "VTKwrite.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 #include "cellValueSet.h"
@@ -189,11 +191,21 @@ weightManager::renumberCell(const int OCell,const int NCell)
   */
 {
   ELog::RegMethod RegA("weightManager","renumberCell");
-  for_each(WMap.begin(),WMap.end(),
-	   std::bind(&WForm::renumberCell,
-		     std::bind(&CtrlTYPE::value_type::second,
-				 std::placeholders::_1),
-		       OCell,NCell));
+  for(CtrlTYPE::value_type& WF : WMap)
+    WF.second->renumberCell(OCell,NCell);
+  return;
+}
+
+void
+weightManager::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber a set of cells in one pass
+    \param RMap :: Map of original cell : new cell
+  */
+{
+  ELog::RegMethod RegA("weightManager","renumberCell");
+  for(CtrlTYPE::value_type& WF : WMap)
+    WF.second->renumberCell(RMap);
   return;
 }
 
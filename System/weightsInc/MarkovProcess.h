@@ -34,27 +34,40 @@ namespace WeightSystem
   
   /*!
     \class MarkovProcess
-    \version 1.0
+    \version 1.1
     \author S. Ansell
     \date October 2015
-    \brief Input to Weights controller
+    \brief Markov chain transfer between WWG mesh points
+
+    The transfer matrix between mesh points is symmetric and
+    mostly below the cut-off so only the entries above it are
+    held in compressed sparse row form. The flux is found by
+    repeated multiplication of the WWG mesh by the matrix.
   */
   
 class MarkovProcess
 {
  private:
 
-  
+  size_t nThread;          ///< Number of threads
   size_t nIteration;       ///< number of iterations
 
   long int WX;             ///< WX size of WWG
   long int WY;             ///< WY size of WWG 
   long int WZ;             ///< WZ size of WWG
+  long int WE;             ///< Energy size of WWG
+
+  long int FSize;          ///< size of transfer matrix [square]
+
+  /// Start of each row in colIndex/TValue [FSize+1]
+  std::vector<size_t> rowIndex;
+  std::vector<long int> colIndex;   ///< Column of each entry
+  std::vector<double> TValue;       ///< Transfer value of each entry
 
-  long int FSize;          ///< size of fluxField [square]
+  /// Flux [energy][point]
+  std::vector<std::vector<double>> fluxField;
 
-  /// Array of interaction [initialCell][finalCell]
-  boost::multi_array<double,2> fluxField;
+  void sparseMultiply();
   
  public:
 
@@ -63,12 +76,16 @@ class MarkovProcess
   MarkovProcess& operator=(const MarkovProcess&);
   ~MarkovProcess();
 
+  /// Set the number of threads used to build the matrix
+  void setThreads(const size_t N) { nThread=(N) ? N : 1; }
+  /// Number of entries held in the matrix
+  size_t nEntries() const { return TValue.size(); }
 
   void initializeData(const WWG&);
   void computeMatrix(const Simulation&,const WWG&,const double,
 		     const double,const double);
   void multiplyOut(const size_t);
-  void rePopulateWWG();
+  void rePopulateWWG(WWG&) const;
   
 };
 
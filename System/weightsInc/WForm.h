@@ -94,6 +94,7 @@ class WForm
   virtual void maskCell(const int) =0;
   virtual void populateCells(const std::map<int,MonteCarlo::Object*>&) =0;
   virtual void renumberCell(const int,const int) =0;
+  virtual void renumberCell(const std::map<int,int>&) =0;
   virtual void balanceScale(const std::vector<double>&) =0;
 
   virtual void writeFLUKA(std::ostream&) const =0;
@@ -81,6 +81,8 @@ class WWG
   void setParticles(const std::set<std::string>&);
   /// Access to EBin
   const std::vector<double>& getEBin() const { return EBin; }
+  /// Access to master mesh
+  const WWGWeight& getMesh() const { return WMesh; }
   void setEnergyBin(const std::vector<double>&,
 		    const std::vector<double>&);
   void resetMesh(const std::vector<double>&);
@@ -96,7 +98,8 @@ class WWG
 
   void write(std::ostream&) const;
   void writeWWINP(const std::string&) const;
-  void writeVTK(const std::string&,const long int =0) const;
+  void writeVTK(const std::string&,const VTKwrite::vtkForm,
+		const long int =0) const;
 
 
   
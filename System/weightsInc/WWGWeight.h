@@ -23,6 +23,7 @@
 #define WeightSystem_WWGWeight_h
 
 class Simulation;
+class VTKwrite;
 
 namespace WeightSystem
 {
@@ -121,7 +122,7 @@ class WWGWeight
   void writeCHECK(const size_t) const;
   
   void writeWWINP(std::ostream&) const;
-  void writeVTK(std::ostream&,const long int) const;
+  void writeVTK(VTKwrite&,const long int) const;
   void write(std::ostream&) const;
 };
 
@@ -65,6 +65,7 @@ class weightManager
   template<typename T> void addParticle(const std::string&);
   
   void renumberCell(const int,const int);  
+  void renumberCell(const std::map<int,int>&);
   void maskCell(const int);
   bool isMasked(const int) const;
 
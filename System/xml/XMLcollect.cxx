@@ -713,6 +713,30 @@ XMLcollect::findObj(const std::string& KeyName,
   return Master.findObj(KeyName,IdNum);
 }
 
+size_t
+XMLcollect::findAllObj(const std::string& KeyName,
+		       std::vector<XMLobject*>& Out)
+  /*!
+    Find all the objects that findObj would return
+    for increasing IdNum.
+    \param KeyName :: Name to search
+    \param Out :: Objects found [added to]
+    \return number of objects found
+  */
+{
+  if (KeyName.empty() || KeyName=="metadata_entry")
+    {
+      Out.push_back(&Master);
+      return 1;
+    }
+  if (KeyName==Master.getKey())
+    {
+      Out.push_back(&Master);
+      return 1+Master.findAllObj(KeyName,Out);
+    }
+  return Master.findAllObj(KeyName,Out);
+}
+
 XMLgroup*
 XMLcollect::findGroup(const std::string& KeyName,
 		   const int IdNum)
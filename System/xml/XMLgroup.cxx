@@ -80,7 +80,7 @@ XMLgroup::XMLgroup(XMLobject* B,const std::string& K,
 {}
 
 XMLgroup::XMLgroup(const XMLgroup& A) :
-  XMLobject(A),Index(A.Index)
+  XMLobject(A),Index(A.Index),KeyCnt(A.KeyCnt)
   /*!
     Copy constructor 
     \param A :: XMLgroup to copy
@@ -113,6 +113,7 @@ XMLgroup::operator=(const XMLgroup& A)
 	GO->setParent(this);
 
       Index=A.Index;
+      KeyCnt=A.KeyCnt;
     }
   return *this;
 }
@@ -147,6 +148,7 @@ XMLgroup::deleteGrp()
     delete *vc;
   Grp.clear();
   Index.erase(Index.begin(),Index.end());
+  KeyCnt.clear();
   return;
 }
 
@@ -170,6 +172,9 @@ XMLgroup::deleteObj(XMLobject* Optr)
 	  delete Grp[Icnt];
 	  Grp.erase(Grp.begin()+static_cast<long int>(Icnt));
 	  Index.erase(mc);
+	  std::map<std::string,int>::iterator kc=KeyCnt.find(Name);
+	  if (kc!=KeyCnt.end() && !--kc->second)
+	    KeyCnt.erase(kc);
 	  // subtract 1 from components above value
 	  holdType::iterator vc;
 	  for(vc=Index.begin();vc!=Index.end();vc++)
@@ -196,6 +201,7 @@ XMLgroup::addGrp(const std::string& Key)
   ELog::RegMethod RegA("XMLgroup","addGrp");
 
   Index.insert(holdType::value_type(Key,Grp.size()));
+  KeyCnt[Key]++;
   XMLgroup* X=new XMLgroup(this,Key);
   X->setDepth(depth+2);
   Grp.push_back(X);
@@ -482,6 +488,53 @@ XMLgroup::findObj(const std::string& KeyName,const int IdNum) const
   return 0;
 }
 
+size_t
+XMLgroup::findAllObj(const std::string& KeyName,
+		     std::vector<XMLobject*>& Out) const
+  /*!
+    Find all the objects that findObj(KeyName,IdNum) 
+    returns for increasing IdNum in a single pass.
+    \param KeyName :: Name of Key to search 
+    \param Out :: Objects found [added to]
+    \return number of objects added
+  */
+{
+  ELog::RegMethod RegA("XMLgroup","findAllObj");
+
+  if (KeyName.empty()) 
+    return 0;
+
+  const size_t outSize(Out.size());
+  std::string::size_type pos=KeyName.find("/");
+  const std::string head=KeyName.substr(0,pos);
+  const std::string tail=(pos!=std::string::npos) ?
+    KeyName.substr(pos+1) : "";
+
+  holdType::const_iterator vc;
+  for(vc=Index.begin();vc!=Index.end();vc++)
+    {
+      const XMLgroup* Gptr=dynamic_cast<const XMLgroup*>(Grp[vc->second]);
+      if (matchPath(vc->first,head)==1)
+        {
+	  if (tail.empty())
+	    Out.push_back(Grp[vc->second]);
+	  else if (Gptr)
+	    {
+	      size_t cnt(0);
+	      XMLobject* Optr=Gptr->findItem(tail);
+	      while(Optr)
+		{
+		  Out.push_back(Optr);
+		  Optr=Gptr->findItem(tail,++cnt);
+		}
+	    }
+	}
+      else if (Gptr)
+	Gptr->findAllObj(KeyName,Out);
+    }
+  return Out.size()-outSize;
+}
+
 XMLgroup*
 XMLgroup::findGroup(const std::string& KeyName,const int IdNum) const
   /*!
@@ -504,12 +557,11 @@ XMLgroup::countKey(const std::string& Key) const
     \return Count of keys found
   */
 {
-  // Iterate over each of the Object to check
-  holdType::const_iterator mc;
+  // Iterate over each distinct key 
   int count(0);
-  for(mc=Index.begin();mc!=Index.end();mc++)
-    if (matchPath(mc->first,Key))
-      count++;
+  for(const std::map<std::string,int>::value_type& KC : KeyCnt)
+    if (matchPath(KC.first,Key))
+      count+=KC.second;
   return count;
 }
 
@@ -526,6 +578,7 @@ XMLgroup::addComp(const std::string& K,const T& V)
   holdType::const_iterator mc;
   const int cnt=countKey(K);    
   Index.insert(holdType::value_type(K,Grp.size()));
+  KeyCnt[K]++;
   
   Grp.push_back(new XMLcomp<T>(this,K,V));
   if (cnt)
@@ -546,6 +599,7 @@ XMLgroup::addComp(const std::string& K,const XMLobject* V)
   holdType::const_iterator mc;
   const int cnt=countKey(K);    
   Index.insert(holdType::value_type(K,Grp.size()));
+  KeyCnt[K]++;
   Grp.push_back(V->clone());
   if (cnt)
     Grp.back()->setRepNum(cnt);
@@ -564,6 +618,7 @@ XMLgroup::addManagedObj(XMLobject* V)
   holdType::const_iterator mc;
   const int cnt=countKey(V->getKey());    
   Index.insert(holdType::value_type(V->getKey(),Grp.size()));
+  KeyCnt[V->getKey()]++;
   Grp.push_back(V);
   if (cnt)
     Grp.back()->setRepNum(cnt);
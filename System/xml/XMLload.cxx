@@ -27,6 +27,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <algorithm>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -43,15 +44,17 @@
 namespace XML
 {
 
+const size_t XMLload::blockSize(65536);
+
 XMLload::XMLload() : 
-  cPos(-1)
+  bOffset(0),cPos(-1)
   /*!
     Constructor
   */
 {}
   
 XMLload::XMLload(const std::string& Fname) :
-  cPos(-1)
+  bOffset(0),cPos(-1)
   /*!
     Constructor
     \param Fname :: File to open
@@ -74,9 +77,9 @@ XMLload::operator++()
    */
 {
   cPos++;
-  if (cPos>=static_cast<long int>(Lines.length()))
+  if (cPos>=avail())
     getNext();
-  return (cPos>=static_cast<long int>(Lines.length())) ? 1 : 0;
+  return (cPos>=avail()) ? 1 : 0;
 }
 
 int
@@ -103,14 +106,14 @@ XMLload::operator+=(const int Index)
   */
 {
   cPos+=Index;
-  if (cPos>=static_cast<int>(Lines.length()))
+  if (cPos>=avail())
     getNext();
   if (cPos<0)
     {
       cPos=-1;
       return -1;
     }
-  return (cPos>=static_cast<int>(Lines.length())) ? 1 : 0;
+  return (cPos>=avail()) ? 1 : 0;
 }
 
 int
@@ -133,8 +136,7 @@ XMLload::setPos(const long int pS)
     \param pS :: New Position
    */
 {
-  
-  const long int LN=static_cast<long int>(Lines.length());
+  const long int LN=avail();
   cPos= (pS<LN) ? pS : LN;
   return;
 }
@@ -151,35 +153,87 @@ XMLload::openFile(const std::string& Fname)
   ELog::RegMethod RegA("XMLload","openFile");
   if (Fname.empty()) return -1;
   IX.close();
+  IX.clear();
 
   IX.open(Fname.c_str());
   if (!IX.good())
     ELog::EM<<"Failed to open file :"<<Fname<<":"<<ELog::endWarn;
   cPos=-1;
-  Lines.erase(0);
+  Partial.clear();
+  Lines.clear();
+  bOffset=0;
   getNext();
   cPos=(Lines.empty() ? -1 : 0);
   return (cPos<0) ? -1 : 0;
 }
 
+size_t
+XMLload::readLines(std::string& Out)
+  /*!
+    Read blocks from the file until at least one 
+    full line is found. Each line has the multiple spaces
+    stripped and is added to Out with a leading space.
+    \param Out :: String to add lines to
+    \return number of lines added
+  */
+{
+  size_t nLine(0);
+  std::string Block(blockSize,' ');
+  while(!nLine && IX.good())
+    {
+      IX.read(&Block[0],static_cast<long int>(blockSize));
+      const size_t nRead(static_cast<size_t>(IX.gcount()));
+      size_t lineStart(0);
+      for(size_t i=0;i<nRead;i++)
+	if (Block[i]=='\n')
+	  {
+	    Partial.append(Block,lineStart,i-lineStart);
+	    Out+=" "+StrFunc::stripMultSpc(Partial);
+	    Partial.clear();
+	    lineStart=i+1;
+	    nLine++;
+	  }
+      Partial.append(Block,lineStart,nRead-lineStart);
+    }
+  // last line without a newline
+  if (!IX.good() && !Partial.empty())
+    {
+      Out+=" "+StrFunc::stripMultSpc(Partial);
+      Partial.clear();
+      nLine++;
+    }
+  return nLine;
+}
+
 void
 XMLload::getNext()
   /*!
-    Get some extra lines if required.
+    Get some extra lines if required. A comment
+    that is open at the end of the lines read is
+    completed before the lines are added.
     Does not adjust cPos
   */
 {
-  IX.clear();
-  const int NExtra(10);
-  int cnt(NExtra);
-  do
+  std::string Extra;
+  if (!readLines(Extra))
+    return;
+  while(stripComment(Extra) && readLines(Extra)) ;
+  Lines+=Extra;
+  return;
+}
+
+void
+XMLload::compact()
+  /*!
+    Remove the consumed part of the buffer
+    if it is the main part of the buffer
+  */
+{
+  if (bOffset>=blockSize && 2*bOffset>=Lines.size())
     {
-      std::string LComp=StrFunc::getAllLine(IX,2048);
-      if (IX.gcount()>0)
-	Lines+=" "+StrFunc::stripMultSpc(LComp);
-      cnt--;
-    } while(IX.good() && cnt);
-  stripComment();
+      Lines.erase(0,bOffset);
+      bOffset=0;
+    }
   return;
 }
 
@@ -192,13 +246,14 @@ XMLload::pop()
   */
 { 
   if (cPos>0)
-    Lines.erase(0,static_cast<size_t>(cPos));
+    bOffset+=std::min(static_cast<size_t>(cPos),Lines.size()-bOffset);
   if (cPos<0)
-    Lines.erase(0);
+    bOffset=Lines.size();
+  compact();
   cPos=0;
-  if (Lines.empty())
+  if (!avail())
     getNext();
-  cPos=Lines.empty() ? -1 : 0;
+  cPos=avail() ? 0 : -1;
   return (cPos) ? 0 : 1;
 }
 
@@ -209,8 +264,8 @@ XMLload::current() const
     \return current values or 0 if cPos out of range
   */
 {
-  return (cPos<0 || cPos>=static_cast<int>(Lines.length()))  
-    ? static_cast<char>(0) : Lines[static_cast<size_t>(cPos)];
+  return (cPos<0 || cPos>=avail())  
+    ? static_cast<char>(0) : at(cPos);
 }
 
 
@@ -224,7 +279,7 @@ XMLload::get(char& c)
 {
   if(!operator++())  // ensures that cPos >=0
     {
-      c=Lines[static_cast<size_t>(cPos)];
+      c=at(cPos);
       return 1;
     }
   return 0;
@@ -237,10 +292,9 @@ XMLload::good()
     \return 0 on failure / 1 on success
   */
 {
-  if (Lines.empty())
+  if (!avail())
     getNext();
-  if ((cPos>0 && cPos>=static_cast<int>(Lines.size())-1) ||
-      !Lines.empty())
+  if ((cPos>0 && cPos>=avail()-1) || avail())
     return 1;
   // Failed
   return 0;
@@ -257,14 +311,12 @@ XMLload::getSection()
     return std::string("");
 
   std::string out;
-  size_t nL(Lines.length());
-  while(cPos>=0 && !isspace(Lines[static_cast<size_t>(cPos)]))
+  while(cPos<avail() && !isspace(at(cPos)))
     {
-      out+=Lines[static_cast<size_t>(cPos)];
+      out+=at(cPos);
       cPos++;
-      if (cPos==static_cast<long int>(nL))
+      if (cPos==avail())
 	getNext();
-      nL=Lines.length();
     }
   return out;
 }
@@ -277,14 +329,15 @@ XMLload::eraseSection(const size_t A,const size_t B)
     \param B :: Second point 
   */
 {
+  const size_t LN(static_cast<size_t>(avail()));
   const size_t Apt=std::min(A,B);
-  const size_t Bpt=std::min(std::max(A,B),Lines.length());
-  if (Apt < Lines.length())
+  const size_t Bpt=std::min(std::max(A,B),LN);
+  if (Apt < LN)
     {
       // Doesn't matter if it extends beyond 
-      Lines.erase(Apt,Bpt-Apt+1);      
+      Lines.erase(bOffset+Apt,Bpt-Apt+1);      
     }
-  if (Lines.empty())
+  if (!avail())
     cPos=-1;
   else if (cPos>=static_cast<long int>(Apt) && 
 	   cPos<=static_cast<long int>(Bpt))
@@ -296,49 +349,40 @@ XMLload::eraseSection(const size_t A,const size_t B)
 
 
 int
-XMLload::stripComment() 
+XMLload::stripComment(std::string& Extra) 
   /*!
-    After a \<!-- for a comment is read
-    until --\> closes the system
-    and pass the line object
+    Remove all the \<!-- comment --\> sections
+    from new lines [not in quotes]
+    \param Extra :: New lines
     \retval 0 :: Success
-    \retval -1 : failed to find end
+    \retval 1 : comment not closed
   */
 {
-  // Now read body (until close)
-  size_t LN=Lines.length();
   size_t comment=0;
   int quote=0; 
-  size_t i = (cPos>0) ? static_cast<size_t>(cPos) : 0;
-  for(;i<LN || (comment && IX.good());i++)
+  size_t i(0);
+  while(i<Extra.length())
     {
-      if (i==LN)
-        {
-	  getNext();
-	  LN=Lines.length();
-	  if (i==LN)
-	    return -1;
-	}
-      if (Lines[i]=='\'' && (i==0 || Lines[i-1]!='\\'))
+      if (Extra[i]=='\'' && (i==0 || Extra[i-1]!='\\'))
 	quote=1-quote;
       if (!quote)
         {
-	  if (!comment && Lines[i]=='<' 
-	      && Lines.substr(i,4)=="<!--")
+	  if (!comment && Extra[i]=='<' 
+	      && Extra.compare(i,4,"<!--")==0)
 	    comment=i+1;
-	  if (comment && Lines[i]=='>' &&
-	      Lines.substr(i-2,3)=="-->")
+	  if (comment && Extra[i]=='>' && i>=2 &&
+	      Extra.compare(i-2,3,"-->")==0)
 	    {
-	      eraseSection(comment-1,i);
+	      Extra.erase(comment-1,i-comment+2);
+	      i=comment-1;
 	      comment=0;
-	      LN=Lines.length();
+	      continue;
 	    }
 	}
+      i++;
     }
-  return 0;
+  return (comment) ? 1 : 0;
 }
 
 
 }   // NAMESPACE XML
-
-
@@ -131,6 +131,7 @@ class XMLcollect
   XMLobject* getObj(const std::string&,const int =0) const;
   XMLobject* findObj(const std::string&,const int =0);
   XMLgroup* findGroup(const std::string&,const int =0);
+  size_t findAllObj(const std::string&,std::vector<XMLobject*>&);
   /// Get current group
   XMLgroup* getCurrent() { return WorkGrp; }
   int setToKey(const std::string&,const int=0);
@@ -47,6 +47,7 @@ class XMLgroup : public XMLobject
 
   std::vector<XMLobject*> Grp;          ///< Orderd list of Objects
   holdType Index;                       ///< Map for searching for an object
+  std::map<std::string,int> KeyCnt;     ///< Number of objects with each key
 
   int countKey(const std::string&) const;
   XMLobject* findItem(const std::string&,const size_t =0) const;
@@ -70,6 +71,7 @@ class XMLgroup : public XMLobject
   // Find:: (deep-search) 
   XMLobject* findObj(const std::string&,const int =0) const;
   XMLgroup* findGroup(const std::string&,const int =0) const;
+  size_t findAllObj(const std::string&,std::vector<XMLobject*>&) const;
   template<typename T> T getItem(const std::string&,const size_t =0) const;
   XMLobject* getLastObj() const;
 
@@ -31,7 +31,12 @@ namespace XML
   \brief Load an XML file
   \author S. Ansell
   \date October 2008
-  \version 1.0
+  \version 2.0
+
+  The file is read in large blocks and split into
+  space-stripped lines (comments removed). Consumed input
+  is passed by a cursor [bOffset] and the buffer is only
+  compacted once the consumed part dominates it.
 */
 
 class XMLload 
@@ -42,16 +47,29 @@ class XMLload
 
  private:
 
+  static const size_t blockSize;         ///< Size of a read block
+
   std::ifstream IX;                      ///< Input stream
+  std::string Partial;                   ///< Incomplete line from block
   std::string Lines;                     ///< ProcessLine
+  size_t bOffset;                        ///< Start of unconsumed Lines
 
-  long int cPos;                        ///< Current Position
+  long int cPos;                        ///< Current Position [from bOffset]
 
   XMLload(const XMLload&);               ///< Private: copy constructor
   XMLload& operator=(const XMLload&);    ///< Private: assignment
 
+  /// Unconsumed size of the buffer
+  long int avail() const
+    { return static_cast<long int>(Lines.size()-bOffset); }
+  /// Character relative to bOffset
+  char at(const long int I) const
+    { return Lines[bOffset+static_cast<size_t>(I)]; }
+
+  size_t readLines(std::string&);
   void getNext();
-  int stripComment();
+  void compact();
+  static int stripComment(std::string&);
 
  public:
 
@@ -74,6 +74,7 @@ class NList
 
   void splitComp();
   int changeItem(const Unit&,const Unit&);
+  int changeItem(const std::map<Unit,Unit>&);
   
   int processString(const std::string&);  
   std::vector<Unit> actualItems() const;  
@@ -111,6 +111,7 @@ class SimFLUKA : public Simulation
   void setNPS(const size_t N) { nps=N; }
   /// set rndseed [move to physics]
   void setRND(const long int N) { rndSeed=N; }
+  void writeRND(std::ostream&) const;
 
   virtual void prepareWrite();
   /// no write variable
@@ -124,6 +125,7 @@ class SimFLUKA : public Simulation
   void processActiveMaterials() const;
   
   virtual void write(const std::string&) const;
+  void writeDeck(std::ostream&) const;
 
 };
 
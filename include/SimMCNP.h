@@ -136,6 +136,7 @@ class SimMCNP : public Simulation
   
   void setMCNPversion(const int);
   virtual void substituteAllSurface(const int,const int);
+  virtual void substituteAllSurface(const std::map<int,int>&);
   virtual std::map<int,int> renumberCells(const std::vector<int>&,
 					  const std::vector<int>&);
 
@@ -145,6 +146,7 @@ class SimMCNP : public Simulation
   virtual void writeCinder() const;          
 
   virtual void write(const std::string&) const;  
+  void writeDeck(std::ostream&) const;
     
 };
 
@@ -43,6 +43,8 @@ namespace ModelSupport
   In a given simulation tracks or isValid operations based on points
   typically start from the last used cell : This keeps a track of the 
   last used cell as an optimization point.
+  Each thread has its own instance: a Simulation must be
+  added [addSim] in each thread that calls findCell.
 */
 
 
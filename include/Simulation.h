@@ -43,6 +43,7 @@ namespace Surface
 namespace ModelSupport
 {
   class ObjSurfMap;
+  class ObjectBVH;
 }
 
 namespace MonteCarlo
@@ -81,6 +82,7 @@ class Simulation : public objectGroups
   
   FuncDataBase DB;                      ///< DataBase of variables
   ModelSupport::ObjSurfMap* OSMPtr;     ///< Object surface map [if required]
+  ModelSupport::ObjectBVH* BVHPtr;      ///< Cell box tree for findCell
 
   TransTYPE TList;                      ///< Transforms List (key=Transform)
 
@@ -198,6 +200,8 @@ class Simulation : public objectGroups
   void validateObjSurfMap();
   /// Access surface map
   const ModelSupport::ObjSurfMap* getOSM() const;
+  /// Access cell box tree
+  const ModelSupport::ObjectBVH* getBVH() const { return BVHPtr; }
 
   // Tally processing
 
@@ -213,6 +217,7 @@ class Simulation : public objectGroups
   virtual void prepareWrite();
 
   virtual void substituteAllSurface(const int,const int);
+  virtual void substituteAllSurface(const std::map<int,int>&);
   virtual std::map<int,int> renumberCells(const std::vector<int>&,
 					  const std::vector<int>&);
   /// no-op call
@@ -58,6 +58,7 @@ class objectGroups
 
   MTYPE regionMap;                 ///< Index of object numbers [name:grp]
   RTYPE rangeMap;                  ///< Range of objects [index : name]
+  RTYPE cellGroup;                 ///< Group of each cell [cell : name]
 
   cMapTYPE Components;             ///< Pointer to real objects
   std::set<int> activeCells;       ///< All Active cells
@@ -105,6 +106,7 @@ class objectGroups
   std::string addActiveCell(const int);
   void removeActiveCell(const int);
   void renumberCell(const int,const int);
+  void renumberCell(const std::map<int,int>&);
   
   /// get active cells
   const std::set<int>& getActiveCells() const
@@ -372,6 +372,32 @@ NList<Unit>::changeItem(const Unit& oldI,const Unit& newI)
   return 0;
 }
 
+template<typename Unit>
+int
+NList<Unit>::changeItem(const std::map<Unit,Unit>& RMap)
+  /*!
+    Change all the actual Items in a map in one pass
+    \param RMap :: Map of old value : new value
+    \return number of items changed
+  */
+{
+  int cnt(0);
+  for(CompUnit& CU : Items)
+    {
+      if (CU.first==0)
+	{
+	  typename std::map<Unit,Unit>::const_iterator mc=
+	    RMap.find(CU.second);
+	  if (mc!=RMap.end())
+	    {
+	      CU.second=mc->second;
+	      cnt++;
+	    }
+	}
+    }
+  return cnt;
+}
+
 template<typename Unit>
 void
 NList<Unit>::write(std::ostream& OX) const
@@ -47,6 +47,7 @@
 #include "mathSupport.h"
 #include "support.h"
 #include "writeSupport.h"
+#include "cardFile.h"
 #include "version.h"
 #include "Element.h"
 #include "MXcards.h"
@@ -477,6 +478,17 @@ SimFLUKA::writeWeights(std::ostream& OX) const
 }
 
 
+void
+SimFLUKA::writeRND(std::ostream& OX) const
+  /*!
+    Write the RANDOMIZE card [random number seed]
+    \param OX :: Output stream
+  */
+{
+  StrFunc::writeFLUKA("RANDOMIZE 1.0 "+std::to_string(rndSeed % 1000000),OX);
+  return;
+}
+
 void
 SimFLUKA::writePhysics(std::ostream& OX) const
   /*!
@@ -492,9 +504,7 @@ SimFLUKA::writePhysics(std::ostream& OX) const
 
   cx<<"START "<<static_cast<double>(nps);
   StrFunc::writeFLUKA(cx.str(),OX);
-  cx.str("");
-  cx<<"RANDOMIZE 1.0 "<<std::to_string(rndSeed % 1000000);
-  StrFunc::writeFLUKA(cx.str(),OX);
+  writeRND(OX);
   // Remaining Physics cards           
   PhysPtr->writeFLUKA(OX);
   return;
@@ -636,8 +646,21 @@ SimFLUKA::write(const std::string& Fname) const
 {
   ELog::RegMethod RegA("SimFLUKA","write");
 
+  StrFunc::cardFile OX(Fname);
+  writeDeck(OX);
+  OX.close();
+  return;
+}
+
+void
+SimFLUKA::writeDeck(std::ostream& OX) const
+  /*!
+    Write out all the system (in FLUKA output format)
+    \param OX :: Output stream
+  */
+{
+  ELog::RegMethod RegA("SimFLUKA","writeDeck");
 
-  std::ofstream OX(Fname.c_str());
   const size_t nCells(OList.size());
   const size_t maxCells(20000);
   if (nCells>maxCells)
@@ -676,6 +699,5 @@ SimFLUKA::write(const std::string& Fname) const
   writeSource(OX);
   writePhysics(OX);
   OX<<"STOP"<<std::endl;
-  OX.close();
   return;
 }
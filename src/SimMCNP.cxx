@@ -47,6 +47,7 @@
 #include "mathSupport.h"
 #include "support.h"
 #include "writeSupport.h"
+#include "cardFile.h"
 #include "version.h"
 #include "Element.h"
 #include "Zaid.h"
@@ -337,9 +338,27 @@ SimMCNP::substituteAllSurface(const int oldSurfN,const int newSurfN)
 
   Simulation::substituteAllSurface(oldSurfN,newSurfN);
 
+  const std::map<int,int> RMap({{oldSurfN,newSurfN}});
+  for(TallyTYPE::value_type& tc : TItem)
+    tc.second->renumberSurf(RMap);
+  
+  return;
+}
+
+void
+SimMCNP::substituteAllSurface(const std::map<int,int>& RMap)
+  /*!
+    Renumber a set of surfaces in the simulation
+    and the tallies
+    \param RMap :: Map of old surface number : new number
+  */
+{
+  ELog::RegMethod RegA("SimMCNP","substituteAllSurface");
+
+  Simulation::substituteAllSurface(RMap);
 
   for(TallyTYPE::value_type& tc : TItem)
-    tc.second->renumberSurf(oldSurfN,newSurfN);
+    tc.second->renumberSurf(RMap);
   
   return;
 }
@@ -361,18 +380,19 @@ SimMCNP::renumberCells(const std::vector<int>& cOffset,
 
   // CARE HERE: RMap is the old number. The objects themselve
   //  have already been updated
+  std::map<int,int> CMap;
   for(const std::map<int,int>::value_type& RMItem : RMap)
     {
       const int cNum=RMItem.first;
       const int nNum=RMItem.second;
       MonteCarlo::Object* oPtr=Simulation::findObject(nNum);   // NOTE new number
       if (!oPtr->isPlaceHold())
-	{
-	  PhysPtr->substituteCell(cNum,nNum);
-	  for(TallyTYPE::value_type& TI : TItem)
-	    TI.second->renumberCell(cNum,nNum);
-	}
+	CMap.emplace(cNum,nNum);
     }
+  // all the cells are changed together
+  PhysPtr->substituteCell(CMap);
+  for(TallyTYPE::value_type& TI : TItem)
+    TI.second->renumberCell(CMap);
   return RMap;
 }
 
@@ -688,8 +708,19 @@ SimMCNP::write(const std::string& Fname) const
     \param Fname :: Output file 
   */
 {
-  std::ofstream OX(Fname.c_str());
-  
+  StrFunc::cardFile OX(Fname);
+  writeDeck(OX);
+  OX.close();
+  return;
+}
+
+void
+SimMCNP::writeDeck(std::ostream& OX) const
+  /*!
+    Write out all the system (in MCNPX output format)
+    \param OX :: Output stream
+  */
+{
   OX<<"Input File:"<<inputFile<<std::endl;
   StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
   writeVariables(OX);
@@ -701,6 +732,5 @@ SimMCNP::write(const std::string& Fname) const
   writeTally(OX);
   writeSource(OX);
   writePhysics(OX);
-  OX.close();
   return;
 }
@@ -47,6 +47,7 @@
 #include "BaseModVisit.h"
 #include "mathSupport.h"
 #include "support.h"
+#include "cardFile.h"
 #include "version.h"
 #include "Element.h"
 #include "Zaid.h"
@@ -379,7 +380,7 @@ SimPHITS::write(const std::string& Fname) const
     \param Fname :: Output file 
   */
 {
-  std::ofstream OX(Fname.c_str());
+  StrFunc::cardFile OX(Fname);
   OX<<"[Title]"<<std::endl;
   writePhysics(OX);
   //  Simulation::writeVariables(OX);
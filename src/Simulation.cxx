@@ -57,6 +57,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Quaternion.h"
 #include "Triple.h"
 #include "NList.h"
@@ -89,6 +90,7 @@
 #include "SourceBase.h"
 #include "sourceDataBase.h"
 #include "ObjSurfMap.h"
+#include "ObjectBVH.h"
 #include "ReadFunctions.h"
 #include "BaseMap.h"
 #include "CellMap.h"
@@ -99,6 +101,7 @@
 
 Simulation::Simulation()  :
   OSMPtr(new ModelSupport::ObjSurfMap),
+  BVHPtr(new ModelSupport::ObjectBVH),
   cellDNF(0),cellCNF(0)
   /*!
     Start of simulation Object
@@ -112,6 +115,7 @@ Simulation::Simulation(const Simulation& A) :
   inputFile(A.inputFile),
   cmdLine(A.cmdLine),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap(*A.OSMPtr)),
+  BVHPtr(new ModelSupport::ObjectBVH),
   TList(A.TList),cellDNF(A.cellDNF),cellCNF(A.cellCNF),
   cellOutOrder(A.cellOutOrder),
   sourceName(A.sourceName)
@@ -156,8 +160,9 @@ Simulation::~Simulation()
 {
   ELog::RegMethod RegA("Simulation","delete operator");
 
-  delete OSMPtr;
   deleteObjects();
+  delete OSMPtr;
+  delete BVHPtr;
   ModelSupport::SimTrack::Instance().clearSim(this);
   
 }
@@ -171,6 +176,7 @@ Simulation::resetAll()
   ModelSupport::surfIndex::Instance().reset();
   TList.erase(TList.begin(),TList.end());
   OSMPtr->clearAll();
+  BVHPtr->clearAll();
   deleteObjects();
   cellOutOrder.clear();
   masterRotate& MR = masterRotate::Instance();
@@ -187,6 +193,7 @@ Simulation::deleteObjects()
   ELog::RegMethod RegA("Simulation","deleteObjects");
   
   ModelSupport::SimTrack::Instance().setCell(this,0);
+  BVHPtr->clearAll();
   for(OTYPE::value_type& mc : OList)
     delete mc.second;
   
@@ -215,9 +222,11 @@ Simulation::checkInsert(const MonteCarlo::Object& A)
     {
       ELog::EM<<"Over-writing Object ::"<<cellNumber<<ELog::endWarn;
       (*mpt->second)=A;
+      BVHPtr->clearAll();
       return 0;
     }
   OList.insert(OTYPE::value_type(cellNumber,A.clone()));
+  BVHPtr->clearAll();
   return 1;
 }
 
@@ -269,6 +278,7 @@ Simulation::addCell(const int cellNumber,const MonteCarlo::Object& A)
     }
   OList.insert(OTYPE::value_type(cellNumber,A.clone()));
   MonteCarlo::Object* QHptr=OList[cellNumber];
+  BVHPtr->clearAll();
 
   QHptr->setName(cellNumber);
 
@@ -437,6 +447,7 @@ Simulation::removeCell(const int cellNumber)
     throw ColErr::InContainerError<int>(cellNumber,"cellNumber in OList");
 
   OSMPtr->removeObject(vc->second);
+  BVHPtr->clearAll();
   
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   ST.checkDelete(this,vc->second);
@@ -467,6 +478,7 @@ Simulation::removeAllSurface(const int KeyN)
       om.second->populate();
       om.second->createSurfaceList();
     }
+  BVHPtr->clearAll();
   ModelSupport::surfIndex::Instance().deleteSurface(KeyN);
   return 0;
 }
@@ -495,6 +507,7 @@ Simulation::substituteAllSurface(const int oldSurfN,const int newSurfN)
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     oc->second->substituteSurf(oldSurfN,newSurfN,XPtr);
+  BVHPtr->clearAll();
 
   // Source:
   if (!sourceName.empty())
@@ -507,6 +520,36 @@ Simulation::substituteAllSurface(const int oldSurfN,const int newSurfN)
   return;
 }
 
+void
+Simulation::substituteAllSurface(const std::map<int,int>& RMap)
+  /*!
+    Renumber a set of surfaces in all the cells in one pass
+    over the cells. Each cell rule is walked once and 
+    only the cells that change are rebuilt.
+    \param RMap :: Map of old surface number : new number
+  */
+{
+  ELog::RegMethod RegA("Simulation","substituteAllSurface");
+  
+  SDef::sourceDataBase& SDB=SDef::sourceDataBase::Instance();
+
+  // SurfaceIndex and surfaces already updated
+  for(OTYPE::value_type& OV : OList)
+    OV.second->substituteSurf(RMap);
+  OSMPtr->renumberSurf(RMap);
+  BVHPtr->clearAll();
+
+  // Source:
+  if (!sourceName.empty())
+    {
+      SDef::SourceBase* SPtr=
+	SDB.getSourceThrow<SDef::SourceBase>(sourceName,"Source not known");
+      SPtr->substituteSurface(RMap);
+    }
+  
+  return;
+}
+
 
 int
 Simulation::setMaterialDensity(OTYPE& ObjGroup)
@@ -762,6 +805,10 @@ Simulation::applyTransforms()
 	  return 1;
 	}
     }
+  for(OTYPE::value_type& OV : OList)
+    OV.second->clearBoundBox();
+  BVHPtr->clearAll();
+  ModelSupport::surfIndex::Instance().rehash();
   return 0;
 }
 
@@ -858,6 +905,7 @@ Simulation::updateSurface(const int SN,const std::string& SLine)
 	  oc->second->rePopulate();
 	}
     }
+  BVHPtr->clearAll();
   return;
 }
 
@@ -917,6 +965,7 @@ Simulation::createObjSurfMap()
       // First add surface that are opposite 
       OSMPtr->addSurfaces(mc->second);
     }  
+  BVHPtr->build(OList);
   return;
 }
 
@@ -1160,6 +1209,17 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
   if (curObjPtr && curObjPtr!=testCell 
       && curObjPtr->isValid(Pt))
     return curObjPtr;
+
+  // Box tree [if built] : only cells whose box holds Pt
+  if (BVHPtr->isActive())
+    {
+      MonteCarlo::Object* OPtr=BVHPtr->findCell(Pt);
+      if (OPtr)
+	{
+	  ST.setCell(this,OPtr);
+	  return OPtr;
+	}
+    }
       
   // now we need to search everthing
   OTYPE::const_iterator mpc;
@@ -1440,7 +1500,8 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
   const std::map<int,int> RMap=
     calcCellRenumber(cOffset,cRange);
 
-  
+  // cells that exist
+  std::map<int,int> CMap;
   OTYPE newMap;           // New map with correct numbering
   for(const std::map<int,int>::value_type& RMItem : RMap)
     {
@@ -1451,14 +1512,16 @@ Simulation::renumberCells(const std::vector<int>& cOffset,
 	{
 	  oPtr->setName(nNum);      
 	  newMap.emplace(nNum,oPtr);
-
-	  WM.renumberCell(cNum,nNum);
-	  objectGroups::renumberCell(cNum,nNum);
+	  CMap.emplace(cNum,nNum);
 	  ELog::RN<<"Cell Changed :"<<cNum<<" "<<nNum
 		  <<" Object:"<<oPtr->getFCUnit()<<ELog::endBasic;
 	}
 
     }    
+  // all the cells are changed together
+  WM.renumberCell(CMap);
+  objectGroups::renumberCell(CMap);
+  OSMPtr->renumberCell(CMap);
   OList=newMap;
   return RMap;
 }
@@ -1494,13 +1557,17 @@ Simulation::renumberSurfaces(const std::vector<int>& rLow,
   
   if (SI.calcRenumber(rLow,rHigh,10000,ChangeList))
     {
+      std::map<int,int> RMap;
       std::vector< std::pair<int,int> >::const_iterator dc;
       for(dc=ChangeList.begin();dc!=ChangeList.end();dc++)
 	{
 	  ELog::RN<<"Surf Change:"<<dc->first<<" "<<dc->second<<ELog::endDiag;
-	  SI.renumber(dc->first,dc->second);
-	  substituteAllSurface(dc->first,dc->second);		    
+	  if (dc->first!=dc->second)
+	    RMap.emplace(dc->first,dc->second);
 	}
+      // all the surfaces are changed together
+      SI.renumber(RMap);
+      substituteAllSurface(RMap);
     }
   return;
 }
@@ -1730,7 +1797,12 @@ Simulation::masterRotation()
   // Apply to QHull if calculated:
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
-    MR.applyFull(oc->second);
+    {
+      MR.applyFull(oc->second);
+      oc->second->clearBoundBox();
+    }
+  BVHPtr->clearAll();
+  ModelSupport::surfIndex::Instance().rehash();
 
   objectGroups::rotateMaster();
   
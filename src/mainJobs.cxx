@@ -30,6 +30,7 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <array>
 #include <memory>
 #include <boost/multi_array.hpp>
 
@@ -68,6 +69,7 @@
 #include "tmeshTally.h"
 #include "MatMD5.h"
 #include "MD5sum.h"
+#include "VTKwrite.h"
 #include "Visit.h"
 
 #include "mainJobs.h"
@@ -168,15 +170,30 @@ createVTK(const mainSystem::inputParam& IParam,
       ELog::EM<<"Processing VTK:"<<ELog::endBasic;
       Visit VTK;
 
-      const std::string vType=
-	IParam.getDefValue<std::string>("","vtkType",0);
+      // vtkType items : cell/material/density and ascii/binary/xml
+      std::string vType;
+      VTKwrite::vtkForm fileForm(VTKwrite::vtkForm::ascii);
+      const size_t nType=IParam.itemCnt("vtkType",0);
+      for(size_t i=0;i<nType;i++)
+	{
+	  const std::string Item=IParam.getValue<std::string>("vtkType",i);
+	  if (VTKwrite::isForm(Item))
+	    fileForm=VTKwrite::getForm(Item);
+	  else
+	    vType=Item;
+	}
       if (vType=="cell")
 	VTK.setType(Visit::VISITenum::cellID);
+      else if (vType=="density")
+	VTK.setType(Visit::VISITenum::density);
       else
 	VTK.setType(Visit::VISITenum::material);
 
       if (vForm=="line")
 	VTK.setLineForm();
+
+      const size_t nThread=IParam.getDefValue<size_t>(1,"vtkThread");
+      VTK.setThreads(nThread);
       
       std::set<std::string> Active;
       for(size_t i=0;i<15;i++)
@@ -192,10 +209,7 @@ createVTK(const mainSystem::inputParam& IParam,
       VTK.populate(*SimPtr,Active);
 
       ELog::EM<<"VTK Type == "<<vType<<ELog::endDiag;
-      if (vType=="cell")
-	VTK.writeIntegerVTK(Oname);
-      else
-	VTK.writeVTK(Oname);
+      VTK.writeVTK(Oname,fileForm);
       return 2;
     }
 
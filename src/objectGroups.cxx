@@ -75,7 +75,8 @@ objectGroups::objectGroups() :
 objectGroups::objectGroups(const objectGroups& A) : 
   cellZone(A.cellZone),cellNumber(A.cellNumber),
   regionMap(A.regionMap),rangeMap(A.rangeMap),
-  Components(A.Components),activeCells(A.activeCells)
+  cellGroup(A.cellGroup),Components(A.Components),
+  activeCells(A.activeCells)
   /*!
     Copy constructor
     \param A :: objectGroups to copy
@@ -95,6 +96,7 @@ objectGroups::operator=(const objectGroups& A)
       cellNumber=A.cellNumber;
       regionMap=A.regionMap;
       rangeMap=A.rangeMap;
+      cellGroup=A.cellGroup;
       Components=A.Components;
       activeCells=A.activeCells;
     }
@@ -116,6 +118,7 @@ objectGroups::reset()
   Components.erase(Components.begin(),Components.end());
   regionMap.erase(regionMap.begin(),regionMap.end());
   rangeMap.erase(rangeMap.begin(),rangeMap.end());
+  cellGroup.clear();
 
   activeCells.clear();
   return;
@@ -195,43 +198,13 @@ objectGroups::inRangeGroup(const int Index)
    */
 {
   ELog::RegMethod RegA("objectGroups","inRangeGroup");
-  
-  static std::string prevName;
 
-  // Quick check to determine if it is the same one as before!
-  // Note: groupRange could have been updated to can't store
-  MTYPE::iterator mc;
-  mc=regionMap.find(prevName);
-
-  if (mc!=regionMap.end() && 
-      mc->second.valid(Index))
-    return mc->second;
-
-  // ok that failed -- but maybe it is just a zoned name
-  const int CNX(Index/cellZone);
-  RTYPE::const_iterator rc=rangeMap.find(CNX);
-  if (rc!=rangeMap.end())
-    {
-      mc=regionMap.find(rc->second);
-      if (mc!=regionMap.end() && 
-	  mc->second.valid(Index))
-	{
-	  prevName=rc->second;
-	  return mc->second;
-	}
-    }
+  RTYPE::const_iterator rc=cellGroup.find(Index);
+  if (rc==cellGroup.end())
+    throw ColErr::InContainerError<int>
+      (Index,"Cell Index not in groupRange");
   
-  // Everything failed : exhausive search
-  for(mc=regionMap.begin();mc!=regionMap.end();mc++)
-    {
-      if (mc->second.valid(Index))
-	{
-	  prevName=mc->first;
-	  return mc->second;
-	}
-    }
-  throw ColErr::InContainerError<int>
-    (Index,"Cell Index not in groupRange");
+  return getGroup(rc->second);
 }
 
 std::string
@@ -242,41 +215,8 @@ objectGroups::inRange(const int Index) const
     \return name of object / empty string if not found
    */
 {
-  ELog::RegMethod RegA("objectGroups","inRange");
-  static std::string prevName;
-
-  // Quick check to determine if it is the same one as before!
-  // Note: groupRange could have been updated to can't store
-  MTYPE::const_iterator mc;
-  mc=regionMap.find(prevName);
-
-  if (mc!=regionMap.end() && 
-      mc->second.valid(Index))
-    return mc->first;
-
-  // ok that failed -- but maybe it is just a zoned name
-  const int CNX(Index/cellZone);
-  RTYPE::const_iterator rc=rangeMap.find(CNX);
-  if (rc!=rangeMap.end())
-    {
-      mc=regionMap.find(rc->second);
-      if (mc!=regionMap.end() && 
-	  mc->second.valid(Index))
-	{
-	  prevName=rc->second;
-	  return prevName;
-	}
-    }
-
-  for(mc=regionMap.begin();mc!=regionMap.end();mc++)
-    {
-      if (mc->second.valid(Index))
-	{
-	  prevName=mc->first;
-	  return mc->first;
-	}
-    }
-  return std::string("");
+  RTYPE::const_iterator rc=cellGroup.find(Index);
+  return (rc==cellGroup.end()) ? std::string("") : rc->second;
 }
 
 std::string
@@ -308,6 +248,7 @@ objectGroups::addActiveCell(const int cellN)
     throw ColErr::InContainerError<std::string>
       (unit,"region not in regionMap");
   mcr->second.addItem(cellN);
+  cellGroup[cellN]=unit;
 
   return unit;
 }
@@ -334,6 +275,7 @@ objectGroups::removeActiveCell(const int cellN)
       (gName,"region not in regionMap");
 
   mcr->second.removeItem(cellN);
+  cellGroup.erase(cellN);
   return;
 }
 
@@ -368,10 +310,74 @@ objectGroups::renumberCell(const int oldCellN,
 
       groupRange& GRP=getGroup(gName);
       GRP.move(oldCellN,newCellN);
+      cellGroup.erase(oldCellN);
+      cellGroup[newCellN]=gName;
     }
   return;
 }
 
+void
+objectGroups::renumberCell(const std::map<int,int>& RMap)
+  /*!
+    Renumber a set of cells in one step both in the range AND 
+    the active set. All the cells are moved together so RMap
+    can be any permutation [e.g. a->b and b->a].
+    \param RMap :: Map of old cell number : new cell number
+  */
+{
+  ELog::RegMethod RegA("objectGroups","renumberCell");
+
+  // group : cells [old : new] moved in group
+  std::map<std::string,std::map<int,int>> GMap;
+  std::set<int> newActive;
+  RTYPE newCellGroup;
+  
+  for(const std::map<int,int>::value_type& RM : RMap)
+    if (RM.first!=RM.second &&
+	activeCells.find(RM.first)==activeCells.end())
+      throw ColErr::InContainerError<int>(RM.first,"Cell number");
+
+  for(const int CN : activeCells)
+    {
+      const std::map<int,int>::const_iterator mc=RMap.find(CN);
+      newActive.insert((mc==RMap.end()) ? CN : mc->second);
+    }
+  for(RTYPE::value_type& CG : cellGroup)
+    {
+      const std::map<int,int>::const_iterator mc=RMap.find(CG.first);
+      if (mc!=RMap.end() && mc->first!=mc->second)
+	{
+	  GMap[CG.second].emplace(mc->first,mc->second);
+	  newCellGroup[mc->second].swap(CG.second);
+	}
+      else
+	newCellGroup[CG.first].swap(CG.second);
+    }
+  activeCells.swap(newActive);
+  cellGroup.swap(newCellGroup);
+
+  // Next move the ranges:
+  for(const std::map<std::string,std::map<int,int>>::value_type& GM : GMap)
+    {
+      const std::string& gName=GM.first;
+      attachSystem::CellMap* CMPtr=
+	getObject<attachSystem::CellMap>(gName);
+      if (CMPtr)
+	CMPtr->renumberCell(GM.second);
+
+      groupRange& GRP=getGroup(gName);
+      std::vector<int> Cells=GRP.getAllCells();
+      for(int& CN : Cells)
+	{
+	  const std::map<int,int>::const_iterator mc=GM.second.find(CN);
+	  if (mc!=GM.second.end())
+	    CN=mc->second;
+	}
+      std::sort(Cells.begin(),Cells.end());
+      GRP.setItems(Cells);
+    }
+  return;
+}
   
 int
 objectGroups::cell(const std::string& Name,const size_t size)
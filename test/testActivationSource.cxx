@@ -0,0 +1,415 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testActivationSource.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <complex> 
+#include <vector>
+#include <array>
+#include <list> 
+#include <map> 
+#include <set>
+#include <string>
+#include <tuple>
+#include <algorithm>
+#include <memory>
+#include <boost/filesystem.hpp>
+
+#include "Exception.h"
+#include "MersenneTwister.h"
+#include "FileReport.h"
+#include "GTKreport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "support.h"
+#include "stringCombine.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "surfIndex.h"
+#include "Quadratic.h"
+#include "Rules.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Object.h"
+#include "surfRegister.h"
+#include "ModelSupport.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "SimMCNP.h"
+#include "localRotate.h"
+#include "activeUnit.h"
+#include "activeFluxPt.h"
+#include "inputSupport.h"
+#include "SourceBase.h"
+#include "ActivationSource.h"
+
+#include "testFunc.h"
+#include "testActivationSource.h"
+
+extern MTRand RNG;
+
+using namespace SDef;
+
+namespace
+{
+  // flux cells written as testActCellN/spectra 
+  const std::string cellBase("testActCell");
+  const std::vector<int> fluxCells({2,3});
+  const Geometry::Vec3D ABox(-4.0,-4.0,-4.0);
+  const Geometry::Vec3D BBox(6.0,4.0,4.0);
+}
+
+testActivationSource::testActivationSource() 
+  /*!
+    Constructor
+  */
+{
+  initSim();
+  writeSpectra();
+}
+
+testActivationSource::~testActivationSource() 
+  /*!
+    Destructor
+  */
+{
+  for(const int CN : fluxCells)
+    boost::filesystem::remove_all(cellBase+StrFunc::makeString(CN));
+}
+
+void
+testActivationSource::initSim()
+  /*!
+    Set a sphere [cell 2] and a thin slab [cell 3] 
+    as the flux cells
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","initSim");
+
+  ASim.resetAll();
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  SurI.createSurface(1,"so 3.0");
+  SurI.createSurface(11,"px 5.0");
+  SurI.createSurface(12,"px 5.5");
+  SurI.createSurface(13,"py -2");
+  SurI.createSurface(14,"py 2");
+  SurI.createSurface(15,"pz -2");
+  SurI.createSurface(16,"pz 2");
+  SurI.createSurface(100,"so 25");
+
+  const int surIndex(0);
+  std::string Out;
+  Out=ModelSupport::getComposite(surIndex,"100");
+  ASim.addCell(MonteCarlo::Object(1,0,0.0,Out));
+  Out=ModelSupport::getComposite(surIndex,"-1");
+  ASim.addCell(MonteCarlo::Object(2,3,0.0,Out));
+  Out=ModelSupport::getComposite(surIndex,"11 -12 13 -14 15 -16");
+  ASim.addCell(MonteCarlo::Object(3,5,0.0,Out));
+  Out=ModelSupport::getComposite(surIndex,"-100 1 (-11:12:-13:14:-15:16)");
+  ASim.addCell(MonteCarlo::Object(4,0,0.0,Out));
+
+  ASim.removeComplements();
+  ASim.populateCells();
+  ASim.createObjSurfMap();
+  return;
+}
+
+void
+testActivationSource::writeSpectra()
+  /*!
+    Write a cinder spectra file for each flux cell.
+    Time step 1 [second time line] has a total flux of 4e10
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","writeSpectra");
+  
+  for(const int CN : fluxCells)
+    {
+      const std::string DName(cellBase+StrFunc::makeString(CN));
+      boost::filesystem::create_directory(DName);
+      std::ofstream OX((DName+"/spectra").c_str());
+      OX<<"gamma spectra cell "<<CN<<std::endl;
+      OX<<"0.0 1.0 2.0 3.0"<<std::endl;
+      OX<<"MULTIGROUP time"<<std::endl;
+      OX<<"time 1 1.0e10 2.0e10"<<std::endl;
+      OX<<"time 2 3.0e10 4.0e10"<<std::endl;
+      OX<<"0.5 "<<CN<<".0 0.5"<<std::endl;
+      OX<<"end"<<std::endl;
+    }
+  return;
+}
+
+std::string
+testActivationSource::readFile(const std::string& FName)
+  /*!
+    Read a complete file
+    \param FName :: File name
+    \return file contents [bytes]
+  */
+{
+  std::ifstream IX(FName.c_str(),std::ios::in | std::ios::binary);
+  std::ostringstream cx;
+  cx<<IX.rdbuf();
+  return cx.str();
+}
+
+void
+testActivationSource::createSource(const size_t nThread,
+				   const long int runSeed,
+				   const bool binaryFlag,
+				   const std::string& FName)
+  /*!
+    Build the source from the spectra with the photon
+    RNG reset so that runs can be compared
+    \param nThread :: Number of threads
+    \param runSeed :: Run random seed
+    \param binaryFlag :: Write binary file
+    \param FName :: Output file
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","createSource");
+
+  RNG.seed(12345UL);
+  ActivationSource AS;
+  AS.setBox(ABox,BBox);
+  AS.setTimeSegment(1);
+  AS.setNPoints(2000);
+  AS.setThreads(nThread);
+  AS.setRunSeed(runSeed);
+  AS.setSeed(7);
+  AS.setBinary(binaryFlag);
+  AS.createAll(ASim,cellBase,FName);
+  return;
+}
+
+int 
+testActivationSource::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: index of test
+    \retval -1 Failed
+    \retval 0 All succeeded
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","applyTest");
+  TestFunc::regSector("testActivationSource");
+
+  typedef int (testActivationSource::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testActivationSource::testBadHeader,
+      &testActivationSource::testBinary,
+      &testActivationSource::testThreads
+    };
+
+  const std::string TestName[]=
+    {
+      "BadHeader",
+      "Binary",
+      "Threads"
+    };
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testActivationSource::testBadHeader()
+  /*!
+    Check that readBinaryPoints rejects a file with the
+    wrong magic and a file with missing records
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","testBadHeader");
+
+  const std::string FName("testActivation.bin");
+  const int32_t orderMarker(1);
+  const int32_t TS(2);
+  const double BoxPts[6]={ 0.0,0.0,0.0,1.0,1.0,1.0 };
+  const int64_t nRecord(5);
+
+  // magic / records present
+  typedef std::tuple<std::string,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("NOTSRC01",5),
+      TTYPE("ACTSRC01",4)
+    };
+
+  std::vector<std::array<double,8>> Pts;
+  for(const TTYPE& tc : Tests)
+    {
+      std::ofstream OX(FName.c_str(),std::ios::out | std::ios::binary);
+      OX.write(std::get<0>(tc).c_str(),8);
+      OX.write(reinterpret_cast<const char*>(&orderMarker),sizeof(int32_t));
+      OX.write(reinterpret_cast<const char*>(&TS),sizeof(int32_t));
+      OX.write(reinterpret_cast<const char*>(BoxPts),6*sizeof(double));
+      OX.write(reinterpret_cast<const char*>(&nRecord),sizeof(int64_t));
+      const std::array<double,8> PItem={{0,0,0,1,0,0,1,1}};
+      for(size_t i=0;i<std::get<1>(tc);i++)
+	OX.write(reinterpret_cast<const char*>(PItem.data()),
+		 8*sizeof(double));
+      OX.close();
+      try
+	{
+	  ActivationSource::readBinaryPoints(FName,Pts);
+	  std::remove(FName.c_str());
+	  ELog::EM<<"No error for "<<std::get<0>(tc)<<" : "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  return -1;
+	}
+      catch (ColErr::FileError&)
+	{ }
+    }
+  std::remove(FName.c_str());
+  return 0;
+}
+
+int
+testActivationSource::testBinary()
+  /*!
+    Write the same source as text and binary and
+    check that the binary file reads back to the text values
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","testBinary");
+
+  const std::string TName("testActivation.txt");
+  const std::string BName("testActivation.bin");
+  createSource(1,375642321L,0,TName);
+  createSource(1,375642321L,1,BName);
+
+  std::vector<std::array<double,8>> Pts;
+  const size_t TS=ActivationSource::readBinaryPoints(BName,Pts);
+
+  std::ifstream IX(TName.c_str());
+  std::string SLine=StrFunc::getLine(IX,512);   // header
+  SLine=StrFunc::getLine(IX,512);               // -nPoints
+  std::vector<std::array<double,8>> TPts;
+  int flag;
+  std::array<double,8> PItem;
+  while(IX>>flag)
+    {
+      for(double& V : PItem)
+	IX>>V;
+      TPts.push_back(PItem);
+    }
+  IX.close();
+  std::remove(TName.c_str());
+  std::remove(BName.c_str());
+
+  if (TS!=2 || Pts.empty() || Pts.size()!=TPts.size())
+    {
+      ELog::EM<<"Time step == "<<TS<<ELog::endDiag;
+      ELog::EM<<"Records[binary/text] == "<<Pts.size()<<" "
+	      <<TPts.size()<<ELog::endDiag;
+      return -1;
+    }
+  for(size_t i=0;i<Pts.size();i++)
+    {
+      const Geometry::Vec3D Pt(Pts[i][0],Pts[i][1],Pts[i][2]);
+      const Geometry::Vec3D Dir(Pts[i][3],Pts[i][4],Pts[i][5]);
+      const MonteCarlo::Object* OPtr=ASim.findCell(Pt,0);
+      bool failFlag(!OPtr ||
+		    std::find(fluxCells.begin(),fluxCells.end(),
+			      OPtr->getName())==fluxCells.end() ||
+		    std::abs(Dir.abs()-1.0)>1e-12);
+      for(size_t j=0;j<8 && !failFlag;j++)
+	failFlag=(std::abs(Pts[i][j]-TPts[i][j])>
+		  1e-6*std::max(1.0,std::abs(Pts[i][j])));
+      if (failFlag)
+	{
+	  ELog::EM<<"Record "<<i<<ELog::endDiag;
+	  for(size_t j=0;j<8;j++)
+	    ELog::EM<<"Binary/Text == "<<Pts[i][j]<<" "
+		    <<TPts[i][j]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testActivationSource::testThreads()
+  /*!
+    Check that the points do not depend on the number of
+    threads but do depend on the run seed
+    \return 0 on success / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testActivationSource","testThreads");
+
+  const std::string FName("testActivation.bin");
+  
+  createSource(1,375642321L,1,FName);
+  const std::string SingleOut=readFile(FName);
+  createSource(4,375642321L,1,FName);
+  const std::string ThreadOut=readFile(FName);
+  createSource(1,12345L,1,FName);
+  const std::string SeedOut=readFile(FName);
+  std::remove(FName.c_str());
+
+  if (SingleOut.empty() || SingleOut!=ThreadOut || SingleOut==SeedOut)
+    {
+      ELog::EM<<"Size[single/thread/seed] == "<<SingleOut.size()<<" "
+	      <<ThreadOut.size()<<" "<<SeedOut.size()<<ELog::endDiag;
+      ELog::EM<<"Single==Thread :"<<(SingleOut==ThreadOut)<<ELog::endDiag;
+      ELog::EM<<"Single==Seed :"<<(SingleOut==SeedOut)<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
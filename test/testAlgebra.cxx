@@ -204,6 +204,7 @@ testAlgebra::testDNF()
 
   Func.push_back("a'b'c'+d'e'");
   Func.push_back("(a'b'c')+(a'b'c)+(a'bc')+(ab'c)+(abc')+(abc)");
+  Func.push_back("((((g'+e)(g+d'))+(g'+(b'+f')))(f+(g+f)))");
   //  Func.push_back("ab((c'(d+e+f')g'h'i')+(gj'(k+l')(m+n)))");
 
   std::vector<std::string>::const_iterator sv;
@@ -67,6 +67,8 @@
 #include "Simulation.h"
 #include "SimMCNP.h"
 #include "World.h"
+#include "SurInter.h"
+#include "AttachSupport.h"
 
 #include "Debug.h"
 
@@ -75,6 +77,67 @@
 
 using namespace attachSystem;
 
+namespace
+{
+
+bool
+fullIntersect(const ContainedComp& CC,const MonteCarlo::Object& CellObj,
+	      const std::vector<const Geometry::Surface*>& CellSVec)
+   /*!
+     Reference version of checkIntersect : all surface
+     triples are tested without any box culling
+     \param CC :: Contained Component
+     \param CellObj :: Cell Object
+     \param CellSVec :: Cell vector
+     
+eturn true/false
+   */
+{
+  const std::vector<Geometry::Surface*> SVec=CC.getSurfaces(); 
+  std::vector<Geometry::Vec3D> Out;
+
+  for(size_t iA=0;iA<SVec.size();iA++)
+    for(size_t iB=0;iB<CellSVec.size();iB++)
+      for(size_t iC=iB+1;iC<CellSVec.size();iC++)
+	{	      
+	  Out=SurInter::processPoint(SVec[iA],CellSVec[iB],CellSVec[iC]);
+	  for(const Geometry::Vec3D& Pt : Out)
+	    {
+	      const std::set<int> boundarySet
+		({CellSVec[iB]->getName(),CellSVec[iC]->getName()});
+	      if (CellObj.isValid(Pt,boundarySet) &&
+		  !CC.isOuterValid(Pt,SVec[iA]->getName()))
+		return 1;
+	    }
+	}
+  for(size_t iA=0;iA<SVec.size();iA++)
+    for(size_t iB=iA+1;iB<SVec.size();iB++)
+      for(size_t iC=iB+1;iC<SVec.size();iC++)
+	{
+	  Out=SurInter::processPoint(SVec[iA],SVec[iB],SVec[iC]);
+	  for(const Geometry::Vec3D& Pt : Out)
+	    if (CellObj.isValid(Pt))
+	      return 1;
+	}
+  for(size_t iA=0;iA<SVec.size();iA++)
+    for(size_t iB=iA+1;iB<SVec.size();iB++)
+      for(size_t iC=0;iC<CellSVec.size();iC++)
+	{
+	  Out=SurInter::processPoint(SVec[iA],SVec[iB],CellSVec[iC]);
+	  for(const Geometry::Vec3D& Pt : Out)
+	    {
+	      const std::set<int> boundarySet
+		({SVec[iA]->getName(),SVec[iB]->getName()});
+	      if (CellObj.isValid(Pt,CellSVec[iC]->getName()) &&
+		  !CC.isOuterValid(Pt,boundarySet))
+		return 1;
+	    }
+	}
+  return 0;
+}
+
+}  // NAMESPACE anonymous
+
 testAttachSupport::testAttachSupport() 
   /*!
     Constructor
@@ -124,11 +187,13 @@ testAttachSupport::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testAttachSupport::testBoundaryValid,
+      &testAttachSupport::testCheckIntersect,
       &testAttachSupport::testInsertComponent
     };
   const std::string TestName[]=
     {
       "BoundaryValid",
+      "CheckIntersect",
       "InsertComponent"
     };
   
@@ -201,6 +266,85 @@ testAttachSupport::testBoundaryValid()
   return 0;
 }
 
+int
+testAttachSupport::testCheckIntersect()
+  /*!
+    Test the box culled checkIntersect against the full
+    surface triple search. Cell 30 is only reached by a vertex
+    of the component surfaces that is outside the component.
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testAttachSupport","testCheckIntersect");
+
+  initSim();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  // component : cut corner box
+  SurI.createSurface(1,"px -1");
+  SurI.createSurface(2,"px 1");
+  SurI.createSurface(3,"py -1");
+  SurI.createSurface(4,"py 1");
+  SurI.createSurface(5,"pz -1");
+  SurI.createSurface(6,"pz 1");
+  SurI.createSurface(7,"p 1 1 0 1.5");
+  // cells
+  SurI.createSurface(11,"px 0");
+  SurI.createSurface(12,"px 3");
+  SurI.createSurface(13,"py -3");
+  SurI.createSurface(14,"py 3");
+  SurI.createSurface(15,"pz -3");
+  SurI.createSurface(16,"pz 3");
+  SurI.createSurface(21,"px 5");
+  SurI.createSurface(22,"px 6");
+  SurI.createSurface(31,"px -2");
+  SurI.createSurface(33,"py 2");
+  SurI.createSurface(35,"pz 0");
+  SurI.createSurface(36,"pz 2");
+  SurI.createSurface(41,"px -0.5");
+  SurI.createSurface(42,"px 0.5");
+  SurI.createSurface(43,"py -0.5");
+  SurI.createSurface(44,"py 0.5");
+  SurI.createSurface(46,"pz 0.5");
+  SurI.createSurface(51,"p 1 1 0 1.2");
+  SurI.createSurface(52,"p 1 1 0 2.0");
+
+  ContainedComp CC;
+  CC.addOuterSurf("1 -2 3 -4 5 -6 -7");
+
+  // cell : surfaces : expected
+  typedef std::tuple<int,std::string,bool> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(10,"11 -12 13 -14 15 -16",1),   // overlap
+      TTYPE(20,"21 -22 13 -14 15 -16",0),   // far away
+      TTYPE(30,"31 -11 33 -14 35 -36",1),   // vertex only
+      TTYPE(40,"41 -42 43 -44 35 -46",0),    // fully inside
+      TTYPE(50,"51 -52 13 -14 35 -36",1)    // across cut plane
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const int cellN(std::get<0>(tc));
+      ASim.addCell(MonteCarlo::Object(cellN,0,0.0,std::get<1>(tc)));
+      MonteCarlo::Object* OPtr=ASim.findObject(cellN);
+      OPtr->populate();
+      OPtr->createSurfaceList();
+      const std::vector<const Geometry::Surface*>&
+	CellSVec=OPtr->getSurList();
+
+      const bool fullFlag=fullIntersect(CC,*OPtr,CellSVec);
+      const bool boxFlag=checkIntersect(CC,*OPtr,CellSVec);
+      if (fullFlag!=boxFlag || boxFlag!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Cell == "<<cellN<<ELog::endDiag;
+	  ELog::EM<<"Full / Box == "<<fullFlag<<" / "<<boxFlag
+		  <<" ("<<std::get<2>(tc)<<")"<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testAttachSupport::testInsertComponent()
   /*!
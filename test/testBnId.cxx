@@ -31,6 +31,7 @@
 #include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <tuple>
 #include "Debug.h"
 #include "BnId.h"
 
@@ -69,33 +70,140 @@ testBnId::applyTest(const int extra)
   ELog::RegMethod RegItem("testBnId","applyTest");
   TestFunc::regSector("testBnId");
 
-  if (extra==0)
+  typedef int (testBnId::*testPtr)();
+  testPtr TPtr[]=
     {
-      std::cout<<"Extra options "<<std::endl;
-      std::cout<<"testMinTerm          (1)"<<std::endl;
+      &testBnId::testCombination,
+      &testBnId::testMinTerm
+    };
+  const std::string TestName[]=
+    {
+      "Combination",
+      "MinTerm"
+    };
+  
+  const size_t TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(size_t i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
     }
-  int retVal;
-  if (extra<0 || extra==1)
+  for(size_t i=0;i<TSize;i++)
     {
-      TestFunc::regTest("testMinTerm");
-      retVal=testMinTerm();
-      if (retVal)
-	return retVal;
+      if (extra<0 || static_cast<size_t>(extra)==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
     }
-
   return 0;
 }
 
+int 
+testBnId::testCombination()
+  /*!
+    Test the combination of two states that differ
+    by one true/false bit
+    \retval -1 :: Failed
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testBnId","testCombination");
+
+  // size : A : B : result : combined : combined++ 
+  typedef std::tuple<size_t,size_t,size_t,int,
+		     std::string,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(4,5,7,1,"01-1","10-0"),
+      TTYPE(4,5,4,1,"010-","011-"),
+      TTYPE(4,5,6,0,"",""),
+      TTYPE(4,5,5,0,"",""),
+      TTYPE(4,5,15,-1,"",""),
+      TTYPE(64,0,1UL<<63,1,"-"+std::string(63,'0'),
+	    "-"+std::string(62,'0')+"1")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const BnId A(std::get<0>(tc),std::get<1>(tc));
+      const BnId B(std::get<0>(tc),std::get<2>(tc));
+      std::pair<int,BnId> Out=A.makeCombination(B);
+      int eqA(2),eqB(2);
+      std::string incStr;
+      if (Out.first==1)
+	{
+	  eqA=Out.second.equivalent(A);
+	  eqB=Out.second.equivalent(B);
+	  ++Out.second;
+	  incStr=Out.second.display();
+	}
+      if (Out.first!=std::get<3>(tc) ||
+	  (Out.first==1 && (eqA!=2 || eqB!=2 ||
+			    incStr!=std::get<5>(tc))))
+	{
+	  ELog::EM<<"A   == "<<A<<ELog::endDiag;
+	  ELog::EM<<"B   == "<<B<<ELog::endDiag;
+	  ELog::EM<<"Flag   == "<<Out.first<<" ("<<std::get<3>(tc)
+		  <<")"<<ELog::endDiag;
+	  ELog::EM<<"Equiv  == "<<eqA<<" "<<eqB<<ELog::endDiag;
+	  ELog::EM<<"Inc    == "<<incStr<<" ("<<std::get<5>(tc)
+		  <<")"<<ELog::endDiag;
+	  return -1;
+	}
+      if (Out.first==1)
+	{
+	  std::pair<int,BnId> Rev=B.makeCombination(A);
+	  --Out.second;
+	  if (Rev.first!=1 || !(Rev.second==Out.second) ||
+	      Rev.second.display()!=std::get<4>(tc))
+	    {
+	      ELog::EM<<"Combined == "<<Rev.second<<" ("
+		      <<std::get<4>(tc)<<")"<<ELog::endDiag;
+	      ELog::EM<<"Dec      == "<<Out.second<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+    }
+  return 0;
+}
 
 int 
 testBnId::testMinTerm()
   /*!
-    Test the number of literals in a string.
-    Single test includes not.
-    \retval -1 :: Failed to get teh correct number of literals
+    Test the MinTerm bitset is carried
+    through a combination
+    \retval -1 :: Failed
     \retval 0 :: success
    */
 {
+  ELog::RegMethod RegA("testBnId","testMinTerm");
+
+  BnId A(3,1);
+  BnId B(3,3);
+  A.setMinTerm(1);
+  B.setMinTerm(70);
+  std::pair<int,BnId> Out=A.makeCombination(B);
+
+  const std::vector<int> Index({1,70,0,3,69,71,128});
+  const std::vector<int> Result({1,1,0,0,0,0,0});
+  for(size_t i=0;i<Index.size();i++)
+    {
+      if (Out.first!=1 || Out.second.hasMinTerm(Index[i])!=Result[i])
+	{
+	  ELog::EM<<"Combination "<<Out.first<<" : "<<Out.second
+		  <<ELog::endDiag;
+	  ELog::EM<<"MinTerm["<<Index[i]<<"] == "
+		  <<Out.second.hasMinTerm(Index[i])<<ELog::endDiag;
+	  return -1;
+	}
+    }
   return 0;
 }
-
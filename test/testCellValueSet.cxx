@@ -0,0 +1,235 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testCellValueSet.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+#include <array>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <tuple>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "support.h"
+#include "writeSupport.h"
+#include "cellValueSet.h"
+
+#include "testFunc.h"
+#include "testCellValueSet.h"
+
+using namespace flukaSystem;
+
+testCellValueSet::testCellValueSet()
+  /*!
+    Constructor
+   */
+{}
+
+testCellValueSet::~testCellValueSet()
+  /*!
+    Destructor
+   */
+{}
+
+int 
+testCellValueSet::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: index of test
+    \retval -1 Failed
+    \retval 0 All succeeded
+  */
+{
+  ELog::RegMethod RegA("testCellValueSet","applyTest");
+  TestFunc::regSector("testCellValueSet");
+
+  typedef int (testCellValueSet::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testCellValueSet::testMixed,
+      &testCellValueSet::testRange,
+      &testCellValueSet::testScale
+    };
+  const std::string TestName[]=
+    {
+      "Mixed",
+      "Range",
+      "Scale"
+    };
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testCellValueSet::checkCards(const std::string& Out,
+			     const std::vector<std::string>& Cards)
+  /*!
+    Compare the output with the cards [before FLUKA formating]
+    \param Out :: FLUKA output
+    \param Cards :: Expected cards [one per line]
+    \return 0 on success / -1 on failure
+  */
+{
+  std::ostringstream cx;
+  for(const std::string& C : Cards)
+    StrFunc::writeFLUKA(C,cx);
+  if (Out!=cx.str())
+    {
+      ELog::EM<<"Out    ::\n"<<Out<<ELog::endDiag;
+      ELog::EM<<"Expect ::\n"<<cx.str()<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testCellValueSet::testMixed()
+  /*!
+    Test grouping of def / number / string values: numbers
+    compare by value so "2" and "2.0" are in the same range
+    \return 0 on success / -1 on failure
+  */
+{
+  ELog::RegMethod RegA("testCellValueSet","testMixed");
+
+  cellValueSet<2> A("mixed","MIXED","TAG");
+  A.setValues(1,"2.0","blckhole");
+  A.setValues(2,"2","blckhole");
+  A.setValues(3,"def","blckhole");
+  A.setValues(4,"def","blckhole");
+  A.setValues(5,"2.0","vacuum");
+  A.setValues(6,"blckhole","vacuum");
+
+  std::ostringstream cx;
+  A.writeFLUKA(cx,"%2 P3 %0 %1");
+  const std::vector<std::string> Cards=
+    {
+      "MIXED 2 BLCKHOLE 1 2 TAG",
+      "MIXED - BLCKHOLE 3 4 TAG",
+      "MIXED 2 VACUUM 5 5 TAG",
+      "MIXED blckhole VACUUM 6 6 TAG"
+    };
+  return checkCards(cx.str(),Cards);
+}
+
+int
+testCellValueSet::testRange()
+  /*!
+    Test that ranges are broken by a gap in the cell 
+    numbers and [for a cell list] by the list position
+    \return 0 on success / -1 on failure
+  */
+{
+  ELog::RegMethod RegA("testCellValueSet","testRange");
+
+  cellValueSet<1> A("range","RANGE","");
+  for(const int CN : {1,2,3,5,6})
+    A.setValues(CN,2.0);
+  A.setValues(7,3.0);
+  A.setValues(8,3.0);
+
+  typedef std::tuple<std::vector<int>,std::vector<std::string>> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      // no cell list : gap at 4 
+      TTYPE({},{"RANGE 2 1 3","RANGE 2 5 6","RANGE 3 7 8"}),
+      // 4 not in list : 1-6 are adjacent
+      TTYPE({1,2,3,5,6,7,8},{"RANGE 2 1 6","RANGE 3 7 8"}),
+      // 4 in list without a value 
+      TTYPE({1,2,3,4,5,6,7,8},{"RANGE 2 1 3","RANGE 2 5 6","RANGE 3 7 8"}),
+      // list order 
+      TTYPE({8,1,2,7},{"RANGE 3 8 8","RANGE 2 1 2","RANGE 3 7 7"})
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const std::vector<int>& cellN(std::get<0>(tc));
+      std::ostringstream cx;
+      if (cellN.empty())
+	A.writeFLUKA(cx,"%2 %0 %1");
+      else
+	A.writeFLUKA(cx,cellN,"%2 %0 %1");
+      if (checkCards(cx.str(),std::get<1>(tc)))
+	{
+	  ELog::EM<<"Cell list size == "<<cellN.size()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testCellValueSet::testScale()
+  /*!
+    Test the scaled output. The scale is applied to the
+    full double so values that agree to 6 significant figures
+    are still different ranges/output
+    \return 0 on success / -1 on failure
+  */
+{
+  ELog::RegMethod RegA("testCellValueSet","testScale");
+
+  cellValueSet<2> A("scale","SCALE","",{3.0,-1e-3});
+  A.setValues(1,1.2345649999,2.0);
+  A.setValues(2,1.2345649999,2.0);
+  A.setValues(3,1.23456,2.0);
+  A.setValue(4,1,5.0);
+  
+  std::ostringstream cx;
+  A.writeFLUKA(cx,"%2 %3 %0 %1");
+  const std::vector<std::string> Cards=
+    {
+      "SCALE 3.70369 -0.002 1 2",
+      "SCALE 3.70368 -0.002 3 3",
+      "SCALE - -0.005 4 4"
+    };
+  return checkCards(cx.str(),Cards);
+}
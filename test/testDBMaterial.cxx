@@ -32,6 +32,8 @@
 #include <string>
 #include <algorithm>
 #include <tuple>
+#include <atomic>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -49,6 +51,7 @@
 #include "MXcards.h"
 #include "Material.h"
 #include "DBMaterial.h"
+#include "threadSupport.h"
 
 #include "testFunc.h"
 #include "testDBMaterial.h"
@@ -84,11 +87,15 @@ testDBMaterial::applyTest(const int extra)
   typedef int (testDBMaterial::*testPtr)();
   testPtr TPtr[]=
     {
-      &testDBMaterial::testCombine
+      &testDBMaterial::testAttnTable,
+      &testDBMaterial::testCombine,
+      &testDBMaterial::testThreadLookup
     };
   const std::string TestName[]=
     {
-      "Combine"
+      "AttnTable",
+      "Combine",
+      "ThreadLookup"
     };
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
   if (!extra)
@@ -114,6 +121,72 @@ testDBMaterial::applyTest(const int extra)
   return 0;
 }
 
+int
+testDBMaterial::testAttnTable()
+  /*!
+    Test the attenuation table and that it is
+    rebuilt when a material is added/reset
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testDBMaterial","testAttnTable");
+
+  DBMaterial& DB=DBMaterial::Instance();
+
+  // check each material against its own values
+  auto checkTable=[&DB]() -> int
+    {
+      const std::vector<double>& AT=DB.getAttnTable();
+      const std::vector<double>& MA=DB.getMeanATable();
+      for(const std::map<int,MonteCarlo::Material>::value_type& MT :
+	    DB.getStore())
+	{
+	  // negative numbers are not in the table
+	  if (MT.first<0) continue;
+	  const size_t index(static_cast<size_t>(MT.first));
+	  const double AMean=MT.second.getMeanA();
+	  const double attn=std::pow(AMean,0.66)*
+	    MT.second.getAtomDensity();
+	  if (index>=AT.size() || index>=MA.size() ||
+	      std::abs(AT[index]-attn)>1e-12 ||
+	      std::abs(MA[index]-AMean)>1e-12)
+	    {
+	      ELog::EM<<"Material "<<MT.first<<" "
+		      <<MT.second.getName()<<ELog::endDiag;
+	      if (index<AT.size())
+		ELog::EM<<"Table == "<<AT[index]<<" "
+			<<MA[index]<<ELog::endDiag;
+	      ELog::EM<<"Expect == "<<attn<<" "<<AMean<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      // numbers without a material are flagged
+      for(size_t i=0;i<AT.size();i++)
+	if (!DB.hasKey(static_cast<int>(i)) && AT[i]>=0.0)
+	  {
+	    ELog::EM<<"Unknown material "<<i<<" == "<<AT[i]<<ELog::endDiag;
+	    return -1;
+	  }
+      return 0;
+    };
+
+  if (checkTable()) return -1;
+
+  // new material
+  DB.createMaterial("H2O%D2O%20");
+  const int matN=DB.getIndex("H2O%D2O%20");
+  if (checkTable()) return -1;
+
+  // changed density
+  MonteCarlo::Material MT(DB.getMaterial(matN));
+  MT.setDensity(MT.getAtomDensity()*3.0);
+  DB.resetMaterial(MT);
+  if (checkTable()) return -1;
+  
+  return 0;
+}
+
 int
 testDBMaterial::testCombine()
   /*!
@@ -170,3 +243,77 @@ testDBMaterial::testCombine()
   
   
 
+int
+testDBMaterial::testThreadLookup()
+  /*!
+    Test that two threads can look up the materials at the
+    same time. The data base is reset so the built-in
+    materials are unparsed and both threads build the
+    materials as they find them.
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testDBMaterial","testThreadLookup");
+
+  // fresh data base : the threads race on the first use build
+  DBMaterial& DB=DBMaterial::Instance();
+  DB.reset();
+
+  std::vector<int> matNum;
+  for(int i=1;i<10000;i++)
+    if (DB.hasKey(i))
+      matNum.push_back(i);
+  if (matNum.empty())
+    {
+      ELog::EM<<"No materials found"<<ELog::endDiag;
+      return -1;
+    }
+
+  // second thread works from the other end
+  const size_t NM(matNum.size());
+  std::vector<std::string> Names[2];
+  std::vector<double> Density[2];
+  size_t attnSize[2];
+  std::atomic<size_t> threadIndex(0);
+  ThreadSupport::runThreads(2,[&]()
+    {
+      const size_t TI(threadIndex++);
+      Names[TI].resize(NM);
+      Density[TI].resize(NM);
+      for(size_t i=0;i<NM;i++)
+	{
+	  const size_t index((TI) ? NM-i-1 : i);
+	  const MonteCarlo::Material& MObj=
+	    DB.getMaterial(matNum[index]);
+	  Names[TI][index]=DB.getKey(matNum[index]);
+	  Density[TI][index]=MObj.getAtomDensity();
+	}
+      attnSize[TI]=DB.getAttnTable().size();
+    });
+
+  for(size_t i=0;i<NM;i++)
+    {
+      const MonteCarlo::Material& MObj=DB.getMaterial(matNum[i]);
+      for(size_t TI=0;TI<2;TI++)
+	if (Names[TI][i]!=MObj.getName() ||
+	    std::abs(Density[TI][i]-MObj.getAtomDensity())>1e-12)
+	  {
+	    ELog::EM<<"Thread["<<TI<<"] Material "<<matNum[i]<<ELog::endDiag;
+	    ELog::EM<<"Name == "<<Names[TI][i]<<" ("<<MObj.getName()<<")"
+		    <<ELog::endDiag;
+	    ELog::EM<<"Density == "<<Density[TI][i]<<" ("
+		    <<MObj.getAtomDensity()<<")"<<ELog::endDiag;
+	    return -1;
+	  }
+    }
+  
+  const size_t NT(DB.getAttnTable().size());
+  if (attnSize[0]!=NT || attnSize[1]!=NT)
+    {
+      ELog::EM<<"Attn table size == "<<attnSize[0]<<" "
+	      <<attnSize[1]<<" ("<<NT<<")"<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
@@ -128,6 +128,7 @@ testHeadRule::applyTest(const int extra)
       &testHeadRule::testPartEqual,
       &testHeadRule::testRemoveSurf,
       &testHeadRule::testReplacePart,
+      &testHeadRule::testSubstituteSurf,
       &testHeadRule::testSurfSet
     };
   const std::string TestName[]=
@@ -144,6 +145,7 @@ testHeadRule::applyTest(const int extra)
       "PartEqual",
       "RemoveSurf",      
       "ReplacePart",      
+      "SubstituteSurf",
       "SurfSet"
     };
   
@@ -783,6 +785,52 @@ testHeadRule::testRemoveSurf()
   return 0;
 }
 
+int
+testHeadRule::testSubstituteSurf()
+  /*!
+    Check the renumbering of surfaces from a map :
+    the map is a permutation so each surface must 
+    be changed only once
+    \return 0 :: success / -ve on error
+   */
+{
+  ELog::RegMethod RegA("testHeadRule","testSubstituteSurf");
+
+  createSurfaces();
+
+  const std::map<int,int> RMap({{1,2},{2,1},{3,4},{4,5}});
+  
+  typedef std::tuple<std::string,std::string,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("1 -2 3 (-4:6)","2 -1 4 (-5:6)",4),
+      TTYPE("11 -12 #(1 -3) 6","11 -12 #(2 -4) 6",2),
+      TTYPE("5 -6","5 -6",0)
+    };
+  
+  HeadRule A;
+  HeadRule B;
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      A.procString(std::get<0>(tc));
+      B.procString(std::get<1>(tc));
+      const int nSub=A.substituteSurf(RMap);
+      // display : operator== does not handle complements
+      if (A.display()!=B.display() || nSub!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"A == "<<A<<ELog::endDiag;
+	  ELog::EM<<"B == "<<B<<ELog::endDiag;
+	  ELog::EM<<"nSub["<<std::get<2>(tc)<<"] == "<<nSub<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testHeadRule::testSurfSet()
   /*!
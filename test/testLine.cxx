@@ -55,7 +55,9 @@
 #include "Sphere.h"
 #include "General.h"
 #include "Line.h"
+#include "LineKernel.h"
 #include "LineIntersectVisit.h"
+#include "surfaceFactory.h"
 #include "SurInter.h"
 
 #include "testFunc.h"
@@ -91,14 +93,18 @@ testLine::applyTest(const int extra)
       &testLine::testConeIntersect,
       &testLine::testCylinderIntersect,
       &testLine::testEllipticCylIntersect,
-      &testLine::testInterDistance
+      &testLine::testInterDistance,
+      &testLine::testKernelBatch,
+      &testLine::testKernelIntersect
     };
   const std::string TestName[]=
     {
       "ConeIntersect",
       "CylinderIntersect",
       "EllipticCylIntersect",
-      "InterDistance"
+      "InterDistance",
+      "KernelBatch",
+      "KernelIntersect"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -125,6 +131,71 @@ testLine::applyTest(const int extra)
   return 0;
 }
 
+size_t
+testLine::lineRoots(const Geometry::Line& LX,const int type,
+		    const Geometry::Surface* SPtr,
+		    std::vector<double>& LOut)
+  /*!
+    Line parameters of the Line::intersect points
+    \param LX :: Line
+    \param type :: LineKernel type of surface
+    \param SPtr :: Surface
+    \param LOut :: Line parameters [added to]
+    \return number of points
+  */
+{
+  std::vector<Geometry::Vec3D> PtOut;
+  if (type==LineKernel::axisPlane || type==LineKernel::genPlane)
+    LX.intersect(PtOut,*static_cast<const Geometry::Plane*>(SPtr));
+  else if (type==LineKernel::axisCylinder ||
+	   type==LineKernel::genCylinder)
+    LX.intersect(PtOut,*static_cast<const Geometry::Cylinder*>(SPtr));
+  else if (type==LineKernel::sphere)
+    LX.intersect(PtOut,*static_cast<const Geometry::Sphere*>(SPtr));
+  else if (type==LineKernel::cone)
+    LX.intersect(PtOut,*static_cast<const Geometry::Cone*>(SPtr));
+
+  for(const Geometry::Vec3D& Pt : PtOut)
+    LOut.push_back((Pt-LX.getOrigin()).dotProd(LX.getDirect()));
+  return PtOut.size();
+}
+
+size_t
+testLine::kernelRoots(const Geometry::Line& LX,const int type,
+		      const Geometry::Surface* SPtr,
+		      std::vector<double>& LOut)
+  /*!
+    Line parameters from the LineKernel functions
+    \param LX :: Line
+    \param type :: LineKernel type of surface
+    \param SPtr :: Surface
+    \param LOut :: Line parameters [added to]
+    \return number of roots
+  */
+{
+  const Geometry::Vec3D O=LX.getOrigin();
+  const Geometry::Vec3D D=LX.getDirect();
+  double L[2];
+  size_t nL(0);
+  if (type==LineKernel::axisPlane || type==LineKernel::genPlane)
+    nL=LineKernel::planeRoots
+      (*static_cast<const Geometry::Plane*>(SPtr),O,D,L);
+  else if (type==LineKernel::axisCylinder ||
+	   type==LineKernel::genCylinder)
+    nL=LineKernel::cylinderRoots
+      (*static_cast<const Geometry::Cylinder*>(SPtr),O,D,L);
+  else if (type==LineKernel::sphere)
+    nL=LineKernel::sphereRoots
+      (*static_cast<const Geometry::Sphere*>(SPtr),O,D,L);
+  else if (type==LineKernel::cone)
+    nL=LineKernel::coneRoots
+      (*static_cast<const Geometry::Cone*>(SPtr),O,D,L);
+
+  for(size_t i=0;i<nL;i++)
+    LOut.push_back(L[i]);
+  return nL;
+}
+
 int
 testLine::testConeIntersect()
   /*!
@@ -414,3 +485,233 @@ testLine::testInterDistance()
 }
 
   
+
+int
+testLine::testKernelBatch()
+  /*!
+    Test the structure-of-arrays batch against
+    the single surface kernels
+    \return 0 sucess / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testLine","testKernelBatch");
+
+  const Geometry::surfaceFactory& SF=
+    Geometry::surfaceFactory::Instance();
+
+  const std::vector<std::string> SurfStr=
+    {
+      "px 3","py -2","pz 5","p 1 1 0 2","p 0 0 -1 4",
+      "c/y 1 2 5","cx 3","cz 7","s 1 2 3 4","so 2",
+      "k/y 2 1 4 1 1","kx 2 0.5","gq 1 1 1 0 0 0 0 0 0 -4"
+    };
+  std::vector<std::shared_ptr<Geometry::Surface> > SurList;
+  for(const std::string& SStr : SurfStr)
+    SurList.push_back(std::shared_ptr<Geometry::Surface>
+		      (SF.processLine(SStr)));
+  SurList.push_back(std::shared_ptr<Geometry::Surface>
+		    (new Geometry::Cylinder
+		     (10,Geometry::Vec3D(1,1,0),
+		      Geometry::Vec3D(1,1,1),2.0)));
+
+  LineKernel::surfBatch SB;
+  std::vector<const Geometry::Surface*> Held;
+  for(const std::shared_ptr<Geometry::Surface>& SPtr : SurList)
+    if (SB.addSurface(SPtr.get()))
+      Held.push_back(SPtr.get());
+
+  // the general quadratic has no kernel
+  if (SB.size()!=SurList.size()-1 || Held.size()!=SB.size())
+    {
+      ELog::EM<<"Batch size "<<SB.size()<<" ["
+	      <<SurList.size()-1<<"]"<<ELog::endDiag;
+      return -1;
+    }
+
+  typedef std::tuple<Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0)),
+      TTYPE(Geometry::Vec3D(-5,0.5,1),Geometry::Vec3D(1,1,0)),
+      TTYPE(Geometry::Vec3D(1,-7,2),Geometry::Vec3D(0,1,0)),
+      TTYPE(Geometry::Vec3D(3,4,-5),Geometry::Vec3D(0.2,0.3,1)),
+      TTYPE(Geometry::Vec3D(2,2,2),Geometry::Vec3D(-1,0.5,0.25))
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Line LX(std::get<0>(tc),std::get<1>(tc));
+      std::vector<double> LOut;
+      std::vector<size_t> IOut;
+      SB.intersect(LX.getOrigin(),LX.getDirect(),LOut,IOut);
+
+      for(size_t i=0;i<Held.size();i++)
+	{
+	  std::vector<double> LExpect;
+	  kernelRoots(LX,LineKernel::getType(Held[i]),Held[i],LExpect);
+	  std::vector<double> LBatch;
+	  for(size_t j=0;j<IOut.size();j++)
+	    if (IOut[j]==i)
+	      LBatch.push_back(LOut[j]);
+	  std::sort(LBatch.begin(),LBatch.end());
+
+	  int fail(LBatch.size()!=LExpect.size());
+	  for(size_t j=0;!fail && j<LBatch.size();j++)
+	    fail=(std::abs(LBatch[j]-LExpect[j])>1e-8);
+	  if (fail)
+	    {
+	      ELog::EM<<"Test "<<cnt<<" Surface "<<*Held[i]<<ELog::endDiag;
+	      ELog::EM<<"Batch N == "<<LBatch.size()<<" ["
+		      <<LExpect.size()<<"]"<<ELog::endDiag;
+	      for(size_t j=0;j<LBatch.size() && j<LExpect.size();j++)
+		ELog::EM<<"Lambda "<<LBatch[j]<<" ["
+			<<LExpect[j]<<"]"<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      cnt++;
+    }
+
+  // LineIntersectVisit : batch gives the same points as the surfaces
+  cnt=1;
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Vec3D Axis(std::get<1>(tc).unit());
+      MonteCarlo::LineIntersectVisit LIA(std::get<0>(tc),Axis);
+      MonteCarlo::LineIntersectVisit LIB(std::get<0>(tc),Axis);
+      for(const Geometry::Surface* SPtr : Held)
+	SPtr->acceptVisitor(LIA);
+      LIB.Accept(SB,Held);
+      if (LIA.getDistance()!=LIB.getDistance() ||
+	  LIA.getSurfIndex()!=LIB.getSurfIndex())
+	{
+	  const std::vector<double>& DA=LIA.getDistance();
+	  const std::vector<double>& DB=LIB.getDistance();
+	  ELog::EM<<"Test "<<cnt<<" Visit N == "<<DB.size()<<" ["
+		  <<DA.size()<<"]"<<ELog::endDiag;
+	  for(size_t i=0;i<DA.size() && i<DB.size();i++)
+	    ELog::EM<<std::setprecision(17)<<"D "<<DB[i]<<" ["
+		    <<DA[i]<<"]"<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+  return 0;
+}
+
+int
+testLine::testKernelIntersect()
+  /*!
+    Test the LineKernel closed forms against Line::intersect
+    \return 0 sucess / -ve on failure
+  */
+{
+  ELog::RegMethod RegA("testLine","testKernelIntersect");
+
+  const Geometry::surfaceFactory& SF=
+    Geometry::surfaceFactory::Instance();
+
+  // surface : kernel type
+  typedef std::tuple<std::string,int> STYPE;
+  const std::vector<STYPE> SurfTests=
+    {
+      STYPE("px 3",LineKernel::axisPlane),
+      STYPE("p 0 0 -1 4",LineKernel::axisPlane),
+      STYPE("p 1 1 0 2",LineKernel::genPlane),
+      STYPE("c/y 1 2 5",LineKernel::axisCylinder),
+      STYPE("cx 3",LineKernel::axisCylinder),
+      STYPE("s 1 2 3 4",LineKernel::sphere),
+      STYPE("so 2",LineKernel::sphere),
+      STYPE("k/y 2 1 4 1 1",LineKernel::cone),
+      STYPE("k/y 2 1 4 1 -1",LineKernel::cone),
+      STYPE("kx 2 0.5",LineKernel::cone),
+      STYPE("gq 1 1 1 0 0 0 0 0 0 -4",LineKernel::noKernel)
+    };
+
+  std::vector<std::shared_ptr<Geometry::Surface> > SurList;
+  for(const STYPE& sc : SurfTests)
+    SurList.push_back(std::shared_ptr<Geometry::Surface>
+		      (SF.processLine(std::get<0>(sc))));
+  SurList.push_back(std::shared_ptr<Geometry::Surface>
+		    (new Geometry::Cylinder
+		     (10,Geometry::Vec3D(1,1,0),
+		      Geometry::Vec3D(1,1,1),2.0)));
+
+  for(size_t i=0;i<SurfTests.size();i++)
+    if (LineKernel::getType(SurList[i].get())!=std::get<1>(SurfTests[i]))
+      {
+	ELog::EM<<"Kernel type of "<<std::get<0>(SurfTests[i])<<" == "
+		<<LineKernel::getType(SurList[i].get())<<ELog::endDiag;
+	return -1;
+      }
+  if (LineKernel::getType(SurList.back().get())!=LineKernel::genCylinder)
+    {
+      ELog::EM<<"Failed on general cylinder type"<<ELog::endDiag;
+      return -1;
+    }
+
+  typedef std::tuple<Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0)),
+      TTYPE(Geometry::Vec3D(-5,0.5,1),Geometry::Vec3D(1,1,0)),
+      TTYPE(Geometry::Vec3D(1,-7,2),Geometry::Vec3D(0,1,0)),
+      TTYPE(Geometry::Vec3D(3,4,-5),Geometry::Vec3D(0.2,0.3,1)),
+      TTYPE(Geometry::Vec3D(0,0,10),Geometry::Vec3D(0,0,-1)),
+      TTYPE(Geometry::Vec3D(2,2,2),Geometry::Vec3D(-1,0.5,0.25))
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Line LX(std::get<0>(tc),std::get<1>(tc));
+      for(const std::shared_ptr<Geometry::Surface>& SPtr : SurList)
+	{
+	  const int type=LineKernel::getType(SPtr.get());
+	  if (!type) continue;
+
+	  std::vector<double> LExpect;
+	  std::vector<double> LKernel;
+	  lineRoots(LX,type,SPtr.get(),LExpect);
+	  kernelRoots(LX,type,SPtr.get(),LKernel);
+
+	  int fail(LKernel.size()!=LExpect.size());
+	  for(size_t j=0;!fail && j<LKernel.size();j++)
+	    fail=(std::abs(LKernel[j]-LExpect[j])>1e-8);
+	  if (fail)
+	    {
+	      ELog::EM<<"Test "<<cnt<<" Surface "<<*SPtr<<ELog::endDiag;
+	      ELog::EM<<"Kernel N == "<<LKernel.size()<<" ["
+		      <<LExpect.size()<<"]"<<ELog::endDiag;
+	      for(size_t j=0;j<LKernel.size() && j<LExpect.size();j++)
+		ELog::EM<<"Lambda "<<LKernel[j]<<" ["
+			<<LExpect[j]<<"]"<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      cnt++;
+    }
+
+  // LineIntersectVisit uses the kernels
+  const Geometry::Vec3D Org(3,4,-5);
+  const Geometry::Vec3D Axis(Geometry::Vec3D(0.2,0.3,1).unit());
+  MonteCarlo::LineIntersectVisit LI(Org,Axis);
+  for(const std::shared_ptr<Geometry::Surface>& SPtr : SurList)
+    if (LineKernel::getType(SPtr.get()))
+      SPtr->acceptVisitor(LI);
+  const std::vector<Geometry::Vec3D>& PtOut=LI.getPoints();
+  const std::vector<double>& DOut=LI.getDistance();
+  for(size_t i=0;i<PtOut.size();i++)
+    {
+      const Geometry::Vec3D& SPt=PtOut[i];
+      if (std::abs((SPt-Org).dotProd(Axis)-DOut[i])>1e-8 ||
+	  std::abs(LI.getSurfIndex()[i]->distance(SPt))>1e-7)
+	{
+	  ELog::EM<<"Visit point "<<SPt<<" : "<<DOut[i]<<ELog::endDiag;
+	  ELog::EM<<"Surface "<<*LI.getSurfIndex()[i]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
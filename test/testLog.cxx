@@ -65,11 +65,13 @@ testLog::applyTest(const int extra)
   typedef int (testLog::*testPtr)();
   testPtr TPtr[]=
     {
-      &testLog::testENDL
+      &testLog::testENDL,
+      &testLog::testRegMethod
     };
   const std::string TestName[]=
     {
-      "ENDL"
+      "ENDL",
+      "RegMethod"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -130,3 +132,59 @@ testLog::testENDL()
   ELog::EM<<"END of EMPTY LINE:"<<ELog::endDebug;
   return 0;
 }
+
+int
+testLog::testRegMethod()
+  /*!
+    Test the registration of literal / string names
+    and the exception backtrace.
+    \retval -1 :: failed
+    \retval 0 :: success
+   */
+{
+  ELog::RegMethod RegA("testLog","testRegMethod");
+
+  const std::string keyName("Key");
+  std::string Trace;
+  {
+    ELog::RegMethod RegB("testLog","part("+keyName+")");
+    {
+      // RegHot is a no-op under NO_HOTREG
+#ifdef NO_HOTREG
+      const std::string hotBase("testLog::part(Key)");
+#else
+      const std::string hotBase("testLog::hot");
+#endif
+      ELog::RegHot RegC("testLog","hot");
+      if (ELog::RegMethod::getBase()!=hotBase)
+	{
+	  ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+	  return -1;
+	}
+    }
+    try
+      {
+	throw ColErr::ExitAbort("Trace");
+      }
+    catch (ColErr::ExitAbort& EA)
+      {
+	Trace=ELog::RegMethod::getBase();
+      }
+  }
+  if (Trace!="testLog::part(Key)" ||
+      ELog::RegMethod::getBase()!="testLog::testRegMethod")
+    {
+      ELog::EM<<"Trace == "<<Trace<<ELog::endDiag;
+      ELog::EM<<"Base == "<<ELog::RegMethod::getBase()<<ELog::endDiag;
+      return -1;
+    }
+
+  // copy keeps owned names
+  const ELog::NameStack Copy(*RegA.getBasePtr());
+  if (Copy.getFull()!=RegA.getBasePtr()->getFull())
+    {
+      ELog::EM<<"Copy == "<<Copy.getFull()<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
@@ -46,6 +46,7 @@
 #include "MatrixBase.h"
 #include "Matrix.h"
 #include "Vec3D.h"
+#include "BoundBox.h"
 #include "Transform.h"
 #include "Surface.h"
 #include "Rules.h"
@@ -57,6 +58,7 @@
 #include "surfIndex.h"
 #include "HeadRule.h"
 #include "Object.h"
+#include "RuleProgram.h"
 #include "neutron.h"
 
 #include "Debug.h"
@@ -180,12 +182,15 @@ testObject::applyTest(const int extra)
   typedef int (testObject::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObject::testAddIntersection,
+      &testObject::testBoundBox,
       &testObject::testCellStr,
       &testObject::testComplement,
       &testObject::testIsValid,
       &testObject::testIsOnSide,
       &testObject::testMakeComplement,
       &testObject::testRemoveComplement,
+      &testObject::testRuleProgram,
       &testObject::testSetObject,
       &testObject::testSetObjectExtra,
       &testObject::testTrackCell,
@@ -193,12 +198,15 @@ testObject::applyTest(const int extra)
     };
   const std::string TestName[]=
     {
+      "AddIntersection",
+      "BoundBox",
       "CellStr",
       "Complement",
       "IsValid",
       "IsOnSide",
       "MakeComplement",
       "RemoveComplement",
+      "RuleProgram",
       "SetObject",
       "SetObjectExtra",
       "TrackCell",
@@ -230,6 +238,131 @@ testObject::applyTest(const int extra)
 }
 
 
+int
+testObject::testAddIntersection()
+  /*!
+    Test that adding a rule gives the same cell as
+    adding its string
+    \retval -1 :: mismatch
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testAddIntersection");
+
+  createSurfaces();
+
+  typedef std::tuple<std::string,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05524655  11 -12 13 -14 15 -16","1 -2 3 -4 5 -6"),
+      TTYPE("4 10 0.05524655  11 -12 13 -14 15 -16","-1:2:-3:4:-5:6"),
+      TTYPE("4 10 0.05524655  (11 -12 13 -14 15 -16) : (21 -22)",
+	    "-1:2:-3:4:-5:6"),
+      TTYPE("4 10 0.05524655  -100 #(1 -2 3 -4 5 -6)","-21 : 22")
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      Object A;
+      Object B;
+      A.setObject(std::get<0>(tc));
+      B.setObject(std::get<0>(tc));
+      B.populate();
+      B.createSurfaceList();
+
+      HeadRule HR;
+      HR.procString(std::get<1>(tc));
+      A.addSurfString(" ("+std::get<1>(tc)+")");
+      B.addIntersection(HR);
+      A.populate();
+      A.createSurfaceList();
+
+      if (A.getSurfSet()!=B.getSurfSet() ||
+	  A.getSurList()!=B.getSurList())
+	{
+	  ELog::EM<<"Failed surface list on test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"A == "<<A.cellCompStr()<<ELog::endDiag;
+	  ELog::EM<<"B == "<<B.cellCompStr()<<ELog::endDiag;
+	  return -1;
+	}
+      for(double x=-16.0;x<16.1;x+=0.5)
+	for(double y=-4.0;y<4.1;y+=0.5)
+	  for(double z=-4.0;z<4.1;z+=0.5)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      if (A.isValid(Pt)!=B.isValid(Pt))
+		{
+		  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+		  ELog::EM<<"Point "<<Pt<<" : "<<B.isValid(Pt)
+			  <<" ["<<A.isValid(Pt)<<"]"<<ELog::endDiag;
+		  ELog::EM<<"A == "<<A.cellCompStr()<<ELog::endDiag;
+		  ELog::EM<<"B == "<<B.cellCompStr()<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+      cnt++;
+    }
+  return 0;
+}
+
+int
+testObject::testBoundBox()
+  /*!
+    Test the bounding box contains all the object. Planes that
+    are only nearly on an axis must not be used as axis planes.
+    \retval -1 :: point outside box
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testBoundBox");
+
+  createSurfaces();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  // tilt of 1e-4 rad from z [passes Plane::planeType]
+  SurI.createSurface(31,"p 1e-4 0 1 0.5");
+  SurI.createSurface(32,"p 1e-3 0 1 0.5");
+  SurI.createSurface(33,"p 1 1 0 1.0");
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -31",
+      "4 10 0.05524655  1 -2 3 -4 5 -32",
+      "4 10 0.05524655  1 -2 3 -4 -31 -33",
+      "4 10 0.05524655  11 -12 13 -14 15 -16 -31"
+    };
+
+  Object A;
+  int cnt(1);
+  for(const std::string& cellStr : Tests)
+    {
+      A.setObject(cellStr);
+      A.populate();
+      const Geometry::BoundBox& BBox=A.getBoundBox();
+      std::vector<Geometry::Vec3D> TPts;
+      for(double x=-3.0;x<3.1;x+=0.25)
+	for(double y=-3.0;y<3.1;y+=0.25)
+	  for(double z=-3.0;z<3.1;z+=0.25)
+	    TPts.push_back(Geometry::Vec3D(x,y,z));
+      // corners of the tilted plane
+      for(const double x : {-3.0,-1.0})
+	{
+	  const Geometry::Vec3D Pt(x,0.0,0.5-1e-4*x);
+	  const Geometry::Vec3D DVec(Pt-Geometry::Vec3D(0,0,1e-7));
+	  TPts.push_back(DVec);
+	}
+      for(const Geometry::Vec3D& Pt : TPts)
+	if (A.isValid(Pt) && !BBox.isValid(Pt))
+	  {
+	    ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+	    ELog::EM<<"Point "<<Pt<<" not in box "<<BBox<<ELog::endDiag;
+	    return -1;
+	  }
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testObject::testCellStr()
   /*!
@@ -574,6 +707,18 @@ testObject::testTrackCell()
   Tests.push_back(TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",-16,
 			Geometry::Vec3D(-2,0,0),Geometry::Vec3D(0,0,1),
 			Geometry::Vec3D(-2,0,3)));
+  Tests.push_back(TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",-1,
+			Geometry::Vec3D(-2,0,0),Geometry::Vec3D(1,0,0),
+			Geometry::Vec3D(-1,0,0)));
+  Tests.push_back(TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",11,
+			Geometry::Vec3D(-2,0,0),Geometry::Vec3D(-1,0,0),
+			Geometry::Vec3D(-3,0,0)));
+  Tests.push_back(TTYPE("4 10 0.05 1 -2 3 -4 5 -6",-2,
+			Geometry::Vec3D(0,0,0),Geometry::Vec3D(1,0,0),
+			Geometry::Vec3D(1,0,0)));
+  Tests.push_back(TTYPE("4 10 0.05 -100 (-1:2:-3:4:-5:6)",-100,
+			Geometry::Vec3D(2,0,0),Geometry::Vec3D(1,0,0),
+			Geometry::Vec3D(25,0,0)));
 
   // Tests.push_back(TTYPE("4 10 0.05524655  1 -2 3 -4 5 -6",-1,
   // 			Geometry::Vec3D(-1.01,0,0),Geometry::Vec3D(1,0,0),
@@ -722,6 +867,62 @@ testObject::testRemoveComplement()
 }
 
 
+int
+testObject::testRuleProgram()
+  /*!
+    Test the compiled rule gives the same result as
+    the rule tree [including points on surfaces]
+    \retval -1 :: failed to compile / mismatch
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testRuleProgram");
+
+  createSurfaces();
+
+  const std::vector<std::string> Tests=
+    {
+      "4 10 0.05524655  1 -2 3 -4 5 -6",
+      "4 10 0.05524655  11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",
+      "4 10 0.05524655  -100 #(1 -2 3 -4 5 -6)",
+      "4 10 0.05524655  (1 -2 : 21 -22) 3 -4 (5 -6 : -100 -16)",
+      "4 10 0.05524655  (-1 : 12) (-3 : 2) 15 -16"
+    };
+
+  Object A;
+  int cnt(1);
+  for(const std::string& cellStr : Tests)
+    {
+      A.setObject(cellStr);
+      A.populate();
+      const RuleProgram* PPtr=A.getProgram();
+      if (!PPtr)
+	{
+	  ELog::EM<<"Failed to compile test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"Cell "<<A.headStr()<<ELog::endDiag;
+	  return -1;
+	}
+      for(double x=-4.0;x<4.1;x+=0.5)
+	for(double y=-4.0;y<4.1;y+=0.5)
+	  for(double z=-4.0;z<4.1;z+=0.5)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      const int res=A.isValid(Pt);
+	      const int expect=A.topRule()->isValid(Pt);
+	      if (res!=expect)
+		{
+		  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+		  ELog::EM<<"Point "<<Pt<<" : "<<res
+			  <<" ["<<expect<<"]"<<ELog::endDiag;
+		  ELog::EM<<"Program\n"<<*PPtr<<ELog::endDiag;
+		  return -1;
+		}
+	    }
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testObject::testWriteFluka() 
   /*!
@@ -34,7 +34,9 @@
 #include <numeric>
 #include <iterator>
 #include <memory>
+#include <array>
 #include <tuple>
+#include <boost/multi_array.hpp>
 
 
 #include "Exception.h"
@@ -68,6 +70,11 @@
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "Mesh3D.h"
+#include "VTKwrite.h"
+#include "WWGWeight.h"
+#include "WWG.h"
+#include "MarkovProcess.h"
 
 #include "testFunc.h"
 #include "testObjectTrackAct.h"
@@ -185,10 +192,14 @@ testObjectTrackAct::applyTest(const int extra)
   typedef int (testObjectTrackAct::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObjectTrackAct::testEnergyFactor,
+      &testObjectTrackAct::testMarkovMatrix,
       &testObjectTrackAct::testPointDet
     };
   const std::string TestName[]=
     {
+      "EnergyFactor",
+      "MarkovMatrix",
       "PointDet"
     };
   
@@ -217,6 +228,151 @@ testObjectTrackAct::applyTest(const int extra)
   return 0;
 }
 
+int
+testObjectTrackAct::testEnergyFactor()
+  /*!
+    Test the energy scaling of the attenuation
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testEnergyFactor");
+
+  // A : Energy : factor
+  typedef std::tuple<double,double,double>  TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(56.0,0.0,1.0),         // no energy scaling
+      TTYPE(56.0,1e-8,2.0),        // thermal : limit
+      TTYPE(56.0,1.0,2.0),   
+      TTYPE(56.0,10.0,1.60942),
+      TTYPE(56.0,100.0,1.17711),
+      TTYPE(1.0,100.0,1.75562),
+      TTYPE(208.0,1e5,1.00347)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const double F=ObjectTrackAct::energyFactor
+	(std::get<0>(tc),std::get<1>(tc));
+      if (std::abs(F-std::get<2>(tc))>1e-5)
+	{
+	  ELog::EM<<"A == "<<std::get<0>(tc)<<" E == "
+		  <<std::get<1>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Factor == "<<F<<" ("<<std::get<2>(tc)<<")"
+		  <<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testObjectTrackAct::testMarkovMatrix()
+  /*!
+    Test the sparse Markov transfer matrix and multiply-out
+    against a full dense matrix of the same transfer values
+    [diagonal 1.0 / exp(WFactor) above the cut]
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testMarkovMatrix");
+
+  const double densityFactor(0.5);
+  const double r2Length(1.0);
+  const double r2Power(12.0);
+  const size_t nMult(3);
+  
+  // mid-points kept off the model surfaces
+  WeightSystem::WWG wSet;
+  wSet.getGrid().setMesh({-4.3,3.7},{4},{-2.2,1.8},{2},{-4.1,11.9},{4});
+  wSet.calcGridMidPoints();
+  wSet.setEnergyBin({1.0,10.0},{1.0,1.0});
+
+  const std::vector<Geometry::Vec3D>& midPts=wSet.getMidPoints();
+  const size_t NF(midPts.size());
+  const size_t NE(wSet.getEBin().size());
+
+  // dense matrix
+  std::vector<std::vector<double>> TMat(NF,std::vector<double>(NF,0.0));
+  for(size_t i=0;i<NF;i++)
+    {
+      TMat[i][i]=1.0;
+      ObjectTrackPoint OTrack(midPts[i]);
+      for(size_t j=i+1;j<NF;j++)
+	{
+	  const long int lJ(static_cast<long int>(j));
+	  OTrack.addUnit(ASim,lJ,midPts[j]);
+	  double DistT=OTrack.getDistance(lJ)/r2Length;
+	  if (DistT<1.0) DistT=1.0;
+	  const double AT=OTrack.getAttnSum(lJ);
+	  const double WFactor= -densityFactor*AT-r2Power*log(DistT);
+	  if (WFactor> -20.0)
+	    TMat[i][j]=TMat[j][i]=exp(WFactor);
+	  OTrack.clearAll();
+	}
+    }
+  // dense multiply [initial mesh is log(1.0)]
+  std::vector<double> flux(NF,1.0);
+  for(size_t n=0;n<nMult;n++)
+    {
+      std::vector<double> outFlux(NF,0.0);
+      for(size_t i=0;i<NF;i++)
+	for(size_t j=0;j<NF;j++)
+	  outFlux[i]+=TMat[i][j]*flux[j];
+      const double maxFlux=
+	*std::max_element(outFlux.begin(),outFlux.end());
+      for(double& F : outFlux)
+	F/=maxFlux;
+      flux=outFlux;
+    }
+
+  for(const size_t nThread : {1,3})
+    {
+      WeightSystem::WWG mSet(wSet);
+      WeightSystem::MarkovProcess MP;
+      MP.setThreads(nThread);
+      MP.initializeData(mSet);
+      MP.computeMatrix(ASim,mSet,densityFactor,r2Length,r2Power);
+
+      size_t nDense(0);
+      for(size_t i=0;i<NF;i++)
+	for(size_t j=0;j<NF;j++)
+	  if (TMat[i][j]>0.0) nDense++;
+      if (MP.nEntries()!=nDense)
+	{
+	  ELog::EM<<"Threads == "<<nThread<<ELog::endDiag;
+	  ELog::EM<<"Entries == "<<MP.nEntries()<<" ("<<nDense<<")"
+		  <<ELog::endDiag;
+	  return -1;
+	}
+      
+      MP.multiplyOut(nMult);
+      MP.rePopulateWWG(mSet);
+
+      const boost::multi_array<double,4>& WGrid=mSet.getMesh().getGrid();
+      const size_t NY(mSet.getGrid().getYSize());
+      const size_t NZ(mSet.getGrid().getZSize());
+      for(size_t i=0;i<NF;i++)
+	for(size_t IE=0;IE<NE;IE++)
+	  {
+	    const double V=WGrid[static_cast<long int>(i/(NY*NZ))]
+	      [static_cast<long int>((i/NZ) % NY)]
+	      [static_cast<long int>(i % NZ)]
+	      [static_cast<long int>(IE)];
+	    if (std::abs(V-log(flux[i]))>1e-8)
+	      {
+		ELog::EM<<"Threads == "<<nThread<<ELog::endDiag;
+		ELog::EM<<"Point["<<i<<"] "<<midPts[i]<<" E="<<IE
+			<<ELog::endDiag;
+		ELog::EM<<"Log flux == "<<V<<" ("<<log(flux[i])<<")"
+			<<ELog::endDiag;
+		return -1;
+	      }
+	  }
+    }
+  return 0;
+}
+
 int
 testObjectTrackAct::testPointDet()
   /*!
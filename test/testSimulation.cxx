@@ -65,6 +65,8 @@
 #include "HeadRule.h"
 #include "Object.h"
 #include "ObjSurfMap.h"
+#include "BoundBox.h"
+#include "ObjectBVH.h"
 #include "ReadFunctions.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
@@ -192,13 +194,15 @@ testSimulation::applyTest(const int extra)
     {
       &testSimulation::testCreateObjSurfMap,
       &testSimulation::testInCell,
-      &testSimulation::testSplitCell
+      &testSimulation::testSplitCell,
+      &testSimulation::testBVHCell
     };
   const std::string TestName[]=
     {
       "CreateObjSurfMap",
       "InCell",
-      "SplitCell"
+      "SplitCell",
+      "BVHCell"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -226,6 +230,57 @@ testSimulation::applyTest(const int extra)
 }
 
 
+int
+testSimulation::testBVHCell()
+  /*!
+    Test the cell box tree gives the same cells
+    as a full search
+    \return -1 on failure
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testBVHCell");
+
+  initSim();
+  ASim.createObjSurfMap();
+  const ModelSupport::ObjectBVH* BPtr=ASim.getBVH();
+  if (!BPtr || !BPtr->isActive()) return -1;
+
+  // Only the outer void [outside sphere] is unbounded
+  if (BPtr->nBound()!=4 || BPtr->nUnbound()!=1)
+    {
+      BPtr->write(ELog::EM.Estream());
+      ELog::EM<<ELog::endDiag;
+      return -2;
+    }
+
+  typedef std::tuple<Geometry::Vec3D,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(0,0,0),2),
+      TTYPE(Geometry::Vec3D(0,26,0),1),
+      TTYPE(Geometry::Vec3D(0,2,0),3),
+      TTYPE(Geometry::Vec3D(12.5,0.3,0),4),
+      TTYPE(Geometry::Vec3D(0,5,0),5),
+      TTYPE(Geometry::Vec3D(1,1,1),2),
+      TTYPE(Geometry::Vec3D(2.0,8.0,0.2),3)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Vec3D& Pt=std::get<0>(tc);
+      const int CN(std::get<1>(tc));
+      const MonteCarlo::Object* OPtr=BPtr->findCell(Pt);
+      if (!OPtr || OPtr->getName()!=CN)
+	{
+	  ELog::EM<<"Failed on point:"<<Pt<<ELog::endDiag;
+	  ELog::EM<<"  Cell == "<<CN<<" != "
+		  <<((OPtr) ? OPtr->getName() : 0)<<ELog::endDiag;
+	  return -3;
+	}
+    }
+  return 0;
+}
+
 int
 testSimulation::testCreateObjSurfMap()
   /*!
@@ -23,6 +23,8 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 #include <cmath>
 #include <complex>
 #include <vector>
@@ -32,6 +34,8 @@
 #include <algorithm>
 #include <tuple>
 
+#include <boost/format.hpp>
+
 #ifndef NO_REGEX
 #include <regex>
 #endif
@@ -42,10 +46,15 @@
 #include "RegMethod.h"
 #include "GTKreport.h"
 #include "OutputLog.h"
+#include "MatrixBase.h"
+#include "Matrix.h"
+#include "Vec3D.h"
+#include "masterWrite.h"
 #include "mathSupport.h"
 #include "support.h"
 #include "stringCombine.h"
 #include "regexSupport.h"
+#include "writeSupport.h"
 
 #include "testFunc.h"
 #include "testSupport.h"
@@ -84,6 +93,7 @@ testSupport::applyTest(const int extra)
       &testSupport::testExtractWord,
       &testSupport::testFullBlock,
       &testSupport::testItemize,
+      &testSupport::testMasterWrite,
       &testSupport::testSection,
       &testSupport::testSectionCinder,
       &testSupport::testSectionRange,
@@ -93,7 +103,8 @@ testSupport::applyTest(const int extra)
       &testSupport::testStrFullCut,
       &testSupport::testStrParts,
       &testSupport::testStrRemove,
-      &testSupport::testStrSplit
+      &testSupport::testStrSplit,
+      &testSupport::testWriteControl
     };
 
   const std::string TestName[]=
@@ -103,6 +114,7 @@ testSupport::applyTest(const int extra)
       "ExtractWord",
       "FullBlock",
       "Itemize",
+      "MasterWrite",
       "Section",
       "SectionCinder",
       "SectionRange",
@@ -112,7 +124,8 @@ testSupport::applyTest(const int extra)
       "StrFullCut",
       "StrParts",
       "StrRemove",
-      "StrSplit"
+      "StrSplit",
+      "WriteControl"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -375,6 +388,93 @@ testSupport::testItemize()
   return 0;  
 }
 
+int
+testSupport::testMasterWrite()
+  /*!
+    Test the masterWrite number output against the 
+    boost::format [%1.<sigFig>g] output
+    \retval -1 :: failed to write number
+  */
+{
+  ELog::RegMethod RegA("testSupport","testMasterWrite");
+
+  masterWrite& MW=masterWrite::Instance();
+  const size_t initSigFig(MW.getSigFig());
+
+  const std::vector<double> Values=
+    { 1.0, -1.0, 0.1, 123456.0, 1234567.0, -9.87654321e-5,
+      1.5e-20, 2.0/3.0, 6.02214076e23, -1.234567890123e-19,
+      1e300, 0.5, 10.0, 100000.5 };
+
+  int retFlag(0);
+  for(const size_t SF : std::vector<size_t>({1,6,9,12,50}))
+    {
+      MW.setSigFig(SF);
+      const boost::format FMT("%1."+std::to_string(SF)+"g");
+      for(const double V : Values)
+	{
+	  const std::string Ref=(boost::format(FMT) % V).str();
+	  if (MW.Num(V)!=Ref)
+	    {
+	      ELog::EM<<"SigFig["<<SF<<"] "<<Ref<<ELog::endDiag;
+	      ELog::EM<<"Num == "<<MW.Num(V)<<ELog::endDiag;
+	      retFlag=-1;
+	    }
+	}
+    }
+  MW.setSigFig(6);
+  
+  // Value : Num(Value)
+  typedef std::tuple<double,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(0.0,"0.0"),
+      TTYPE(-0.0,"0.0"),
+      TTYPE(-1e-21,"0.0"),
+      TTYPE(1e-20,"1e-20"),
+      TTYPE(1.23456789e-7,"1.23457e-07"),
+      TTYPE(-1.0e+15,"-1e+15"),
+      TTYPE(0.000123456789,"0.000123457")
+    };
+  for(const TTYPE& tc : Tests)
+    if (MW.Num(std::get<0>(tc))!=std::get<1>(tc))
+      {
+	ELog::EM<<"Value == "<<std::get<0>(tc)<<" : "
+		<<MW.Num(std::get<0>(tc))<<" ("<<std::get<1>(tc)<<")"
+		<<ELog::endDiag;
+	retFlag=-1;
+      }
+
+  const Geometry::Vec3D Pt(1.5,-0.0,1.0/3.0);
+  if (MW.Num(Pt)!="1.5 0.0 0.333333" ||
+      MW.NumComma(Pt)!="1.5,0.0,0.333333" ||
+      MW.padNum(Pt,4)!="1.5  0.0  0.333333" ||
+      MW.padNum(-2,4)!="-2  " ||
+      MW.Num(size_t(12))!="12")
+    {
+      ELog::EM<<"Vec3D == "<<MW.Num(Pt)<<ELog::endDiag;
+      ELog::EM<<"Comma == "<<MW.NumComma(Pt)<<ELog::endDiag;
+      ELog::EM<<"Pad   == :"<<MW.padNum(Pt,4)<<":"<<ELog::endDiag;
+      retFlag=-1;
+    }
+
+  // sigFig range is 1-50
+  for(const size_t SF : std::vector<size_t>({0,51}))
+    {
+      try
+	{
+	  MW.setSigFig(SF);
+	  ELog::EM<<"SigFig accepted "<<SF<<ELog::endDiag;
+	  retFlag=-1;
+	}
+      catch (ColErr::RangeError<size_t>&)
+	{ }
+    }
+  
+  MW.setSigFig(initSigFig);
+  return retFlag;
+}
+
 int
 testSupport::testSection()
   /*!
@@ -898,3 +998,56 @@ testSupport::testStrSplit()
 
   return 0;
 }
+
+int
+testSupport::testWriteControl()
+  /*!
+    Test the MCNP line splitting of writeControl
+    and writeMCNPXcomment
+    \retval -1 :: failed to split line correctly
+  */
+{
+  ELog::RegMethod RegA("testSupport","testWriteControl");
+
+  // Line : LNMax : insert : comment flag : result
+  typedef std::tuple<std::string,size_t,int,int,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("10 5 0.0855 -1001 1002 -1003 1004 -1005 1006 (-1007:1008) "
+	    "-1009 1010 -1011 1012 imp:n=1 imp:p=1",72,8,0,
+	    "10 5 0.0855 -1001 1002 -1003 1004 -1005 1006 (-1007:1008)"
+	    " -1009 1010\n        -1011 1012 imp:n=1 imp:p=1\n"),
+      TTYPE("m1 1001.70c 0.6667,8016.70c 0.3333,6000.70c 0.0010000,"
+	    "7014.70c 0.00100,5010.70c 0.001",72,8,0,
+	    "m1 1001.70c 0.6667,8016.70c 0.3333,6000.70c 0.0010000,"
+	    "7014.70c 0.00100,\n        5010.70c 0.001\n"),
+      TTYPE("fm4 1.0 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 "
+	    "21 22 23 24 25 26 27 28",72,-8,0,
+	    "        fm4 1.0 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18"
+	    " 19 20 21 22\n        23 24 25 26 27 28\n"),
+      TTYPE("RunCmd: ./ess -defaultConfig Single ODIN -r -validAll "
+	    "--validCheck 1000 -angle objAxis GuideBay4 1 AA",72,8,1,
+	    "c RunCmd: ./ess -defaultConfig Single ODIN -r -validAll "
+	    "--validCheck 1000\nc         -angle objAxis GuideBay4 1 AA\n"),
+      TTYPE("   ",72,8,0,""),
+      TTYPE("  px 3.0  ",72,8,0,"px 3.0\n")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      std::ostringstream cx;
+      if (std::get<3>(tc))
+	StrFunc::writeMCNPXcomment(std::get<0>(tc),cx);
+      else
+	StrFunc::writeControl(std::get<0>(tc),cx,
+			      std::get<1>(tc),std::get<2>(tc));
+      if (cx.str()!=std::get<4>(tc))
+	{
+	  ELog::EM<<"Input  == "<<std::get<0>(tc)<<" =="<<ELog::endDiag;
+	  ELog::EM<<"Out    == "<<cx.str()<<" =="<<ELog::endDiag;
+	  ELog::EM<<"Expect == "<<std::get<4>(tc)<<" =="<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
@@ -116,13 +116,15 @@ testSurfEqual::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSurfEqual::testBasicPair,
-      &testSurfEqual::testEqualSurfNum
+      &testSurfEqual::testEqualSurfNum,
+      &testSurfEqual::testHashEqual
     };
 
   const std::string TestName[]=
     {
       "BasicPair",
-      "EqualSurfNum"
+      "EqualSurfNum",
+      "HashEqual"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -212,3 +214,72 @@ testSurfEqual::testEqualSurfNum()
   return 0;
 }
 
+
+int
+testSurfEqual::testHashEqual()
+  /*!
+    Test the hashed equal/opposite surface search 
+    including values on the edge of a hash cell
+    \return -ve on error 
+  */
+{
+  ELog::RegMethod RegA("testSurfEqual","testHashEqual");
+
+  createSurfaces();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const Geometry::surfaceFactory& SF=
+    Geometry::surfaceFactory::Instance();
+  
+  // surface : equal surface : opposite surface
+  typedef std::tuple<std::string,int,int> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("px 1.000000001",2,0),
+      TTYPE("px 1.0000001",102,0),
+      TTYPE("p -1 0 0 -1",103,2),
+      TTYPE("px 0.0000005",104,0),
+      TTYPE("px 0.000000499999999",104,0),
+      TTYPE("p 0 1 0 1",4,0),
+      TTYPE("pz -1.00000000001",5,0),
+      TTYPE("cz 3",108,0),
+      TTYPE("c/z 0 0 3",108,0),
+      TTYPE("c/z 5 0 3",110,0),
+      TTYPE("so 2",111,0),
+      TTYPE("s 0 0 0 2.000000001",111,0),
+      TTYPE("s 0 0 1e-9 2",111,0)
+    };
+
+  int SN(100);
+  for(const TTYPE& tc : Tests)
+    {
+      SN++;
+      Geometry::Surface* SPtr=SF.processLine(std::get<0>(tc));
+      SPtr->setName(SN);
+      const int oppN=SurI.findOpposite(SPtr);
+      const int eqN=SurI.addSurface(SPtr)->getName();
+      if (eqN!=std::get<1>(tc) || oppN!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Surface : "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Equal    : "<<eqN<<" ("<<std::get<1>(tc)<<")"
+		  <<ELog::endDiag;
+	  ELog::EM<<"Opposite : "<<oppN<<" ("<<std::get<2>(tc)<<")"
+		  <<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  // Move a surface : found after rehash
+  Geometry::Plane* PPtr=dynamic_cast<Geometry::Plane*>(SurI.getSurf(102));
+  PPtr->setPlane(Geometry::Vec3D(1,0,0),10.0);
+  SurI.rehash();
+  std::unique_ptr<Geometry::Surface>
+    TPtr(SF.processLine("px 10.000000001"));
+  TPtr->setName(200);
+  if (ModelSupport::equalSurfNum(TPtr.get())!=102)
+    {
+      ELog::EM<<"Failed to find moved surface : "
+	      <<ModelSupport::equalSurfNum(TPtr.get())<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
@@ -0,0 +1,436 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   test/testVTKwrite.cxx
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <array>
+#include <string>
+#include <algorithm>
+#include <tuple>
+#include <boost/format.hpp>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "GTKreport.h"
+#include "OutputLog.h"
+#include "VTKwrite.h"
+
+#include "testFunc.h"
+#include "testVTKwrite.h"
+
+namespace
+{
+  // grid for all the tests : value = i+10j-100k
+  const std::vector<double> XCoord({0.0,1.0});
+  const std::vector<double> YCoord({0.0,1.0,2.0});
+  const std::vector<double> ZCoord({-1.0,1.5});
+
+  double
+  gridValue(const size_t i,const size_t j,const size_t k)
+    /*!
+      Value at a grid point
+      \param i :: x index
+      \param j :: y index
+      \param k :: z index
+      \return value
+    */
+  {
+    return static_cast<double>(i)+10.0*static_cast<double>(j)-
+      100.0*static_cast<double>(k);
+  }
+
+  std::string
+  bigEndian(const uint32_t U)
+    /*!
+      Bytes of a 32 bit value most significant first
+      \param U :: Value
+      \return byte string
+    */
+  {
+    std::string Out;
+    for(int shift=24;shift>=0;shift-=8)
+      Out+=static_cast<char>((U >> shift) & 0xff);
+    return Out;
+  }
+
+  std::string
+  bigEndian(const float F)
+    /*!
+      Bytes of a float most significant first
+      \param F :: Value
+      \return byte string
+    */
+  {
+    uint32_t U;
+    std::memcpy(&U,&F,sizeof(uint32_t));
+    return bigEndian(U);
+  }
+
+  template<typename T>
+  T
+  readValue(const std::string& File,const size_t pos)
+    /*!
+      Read a value in machine byte order
+      \param File :: File contents
+      \param pos :: Byte position
+      \return value
+    */
+  {
+    T Out(0);
+    if (pos+sizeof(T)<=File.size())
+      std::memcpy(&Out,File.data()+pos,sizeof(T));
+    return Out;
+  }
+}
+
+testVTKwrite::testVTKwrite()
+  /*!
+    Constructor
+  */
+{}
+
+testVTKwrite::~testVTKwrite()
+  /*!
+    Destructor
+  */
+{}
+
+int
+testVTKwrite::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns
+    the error number
+    \param extra :: index of test
+    \retval -1 on failure
+    \retval 0 All succeeded
+  */
+{
+  ELog::RegMethod RegA("testVTKwrite","applyTest");
+  TestFunc::regSector("testVTKwrite");
+
+  typedef int (testVTKwrite::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testVTKwrite::testAscii,
+      &testVTKwrite::testBinary,
+      &testVTKwrite::testXML
+    };
+  const std::string TestName[]=
+    {
+      "Ascii",
+      "Binary",
+      "XML"
+    };
+
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+std::string
+testVTKwrite::readFile(const std::string& FName)
+  /*!
+    Read a complete file
+    \param FName :: File name
+    \return file contents [bytes]
+  */
+{
+  std::ifstream IX(FName.c_str(),std::ios::in | std::ios::binary);
+  std::ostringstream cx;
+  cx<<IX.rdbuf();
+  return cx.str();
+}
+
+void
+testVTKwrite::writeGrid(VTKwrite& VW,const std::string& FName)
+  /*!
+    Write the test grid one z-slice at a time
+    \param VW :: Writer
+    \param FName :: File name
+  */
+{
+  VW.open(FName,"test Data",XCoord,YCoord,ZCoord);
+  std::vector<double> Slice;
+  for(size_t k=0;k<ZCoord.size();k++)
+    {
+      Slice.clear();
+      for(size_t j=0;j<YCoord.size();j++)
+	for(size_t i=0;i<XCoord.size();i++)
+	  Slice.push_back(gridValue(i,j,k));
+      VW.writeSlice(Slice);
+    }
+  VW.close();
+  return;
+}
+
+int
+testVTKwrite::testAscii()
+  /*!
+    Test the streamed ascii output against the
+    full mesh output of the old Visit::writeVTK
+    [which wrote the component count as 1.0]
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testVTKwrite","testAscii");
+
+  const std::string FName("testVTKwrite.vtk");
+  VTKwrite VW(VTKwrite::vtkForm::ascii,VTKwrite::vtkData::Float,"cellID");
+  writeGrid(VW,FName);
+  const std::string Out=readFile(FName);
+  std::remove(FName.c_str());
+
+  std::ostringstream OX;
+  boost::format fFMT("%1$11.6g%|14t|");
+  OX<<"# vtk DataFile Version 2.0"<<std::endl;
+  OX<<"test Data"<<std::endl;
+  OX<<"ASCII"<<std::endl;
+  OX<<"DATASET RECTILINEAR_GRID"<<std::endl;
+  OX<<"DIMENSIONS "<<XCoord.size()<<" "<<YCoord.size()<<" "
+    <<ZCoord.size()<<std::endl;
+  OX<<"X_COORDINATES "<<XCoord.size()<<" float"<<std::endl;
+  for(const double C : XCoord)
+    OX<<(fFMT % C);
+  OX<<std::endl;
+  OX<<"Y_COORDINATES "<<YCoord.size()<<" float"<<std::endl;
+  for(const double C : YCoord)
+    OX<<(fFMT % C);
+  OX<<std::endl;
+  OX<<"Z_COORDINATES "<<ZCoord.size()<<" float"<<std::endl;
+  for(const double C : ZCoord)
+    OX<<(fFMT % C);
+  OX<<std::endl;
+  OX<<"POINT_DATA "<<XCoord.size()*YCoord.size()*ZCoord.size()<<std::endl;
+  OX<<"SCALARS cellID float 1"<<std::endl;
+  OX<<"LOOKUP_TABLE default"<<std::endl;
+  for(size_t k=0;k<ZCoord.size();k++)
+    for(size_t j=0;j<YCoord.size();j++)
+      {
+	for(size_t i=0;i<XCoord.size();i++)
+	  OX<<(fFMT % gridValue(i,j,k));
+	OX<<std::endl;
+      }
+
+  if (Out!=OX.str())
+    {
+      ELog::EM<<"Ascii file ::\n"<<Out<<ELog::endDiag;
+      ELog::EM<<"Expected ::\n"<<OX.str()<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testVTKwrite::testBinary()
+  /*!
+    Test that the legacy binary output is big endian
+    for both float and integer scalars
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testVTKwrite","testBinary");
+
+  const std::string FName("testVTKwrite.vtk");
+  for(const VTKwrite::vtkData DType :
+	{VTKwrite::vtkData::Float,VTKwrite::vtkData::Int})
+    {
+      const bool intFlag(DType==VTKwrite::vtkData::Int);
+      VTKwrite VW(VTKwrite::vtkForm::binary,DType,"flux");
+      writeGrid(VW,FName);
+      const std::string Out=readFile(FName);
+      std::remove(FName.c_str());
+
+      std::string Expect=
+	"# vtk DataFile Version 2.0\n"
+	"test Data\n"
+	"BINARY\n"
+	"DATASET RECTILINEAR_GRID\n"
+	"DIMENSIONS 2 3 2\n"
+	"X_COORDINATES 2 float\n";
+      for(const double C : XCoord)
+	Expect+=bigEndian(static_cast<float>(C));
+      Expect+="\nY_COORDINATES 3 float\n";
+      for(const double C : YCoord)
+	Expect+=bigEndian(static_cast<float>(C));
+      Expect+="\nZ_COORDINATES 2 float\n";
+      for(const double C : ZCoord)
+	Expect+=bigEndian(static_cast<float>(C));
+      Expect+="\nPOINT_DATA 12\n";
+      Expect+=(intFlag) ? "SCALARS flux int 1\n" : "SCALARS flux float 1\n";
+      Expect+="LOOKUP_TABLE default\n";
+      for(size_t k=0;k<ZCoord.size();k++)
+	for(size_t j=0;j<YCoord.size();j++)
+	  for(size_t i=0;i<XCoord.size();i++)
+	    {
+	      const double V=gridValue(i,j,k);
+	      Expect+=(intFlag) ?
+		bigEndian(static_cast<uint32_t>(static_cast<int32_t>(V))) :
+		bigEndian(static_cast<float>(V));
+	    }
+      Expect+="\n";
+
+      if (Out!=Expect)
+	{
+	  ELog::EM<<"Data type == "<<((intFlag) ? "int" : "float")
+		  <<ELog::endDiag;
+	  ELog::EM<<"Size == "<<Out.size()<<" ("<<Expect.size()<<")"
+		  <<ELog::endDiag;
+	  const size_t index=static_cast<size_t>
+	    (std::mismatch(Out.begin(),Out.begin()+
+			   static_cast<long int>
+			   (std::min(Out.size(),Expect.size())),
+			   Expect.begin()).first-Out.begin());
+	  ELog::EM<<"First difference at byte "<<index<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testVTKwrite::testXML()
+  /*!
+    Test the XML header and that each appended offset
+    points to a byte count and the data of its array
+    \retval -1 :: failed
+    \retval 0 :: All passed
+  */
+{
+  ELog::RegMethod RegA("testVTKwrite","testXML");
+
+  const std::string FName("testVTKwrite.vtr");
+  VTKwrite VW(VTKwrite::vtkForm::xml,VTKwrite::vtkData::Float,"flux");
+  writeGrid(VW,FName);
+  const std::string Out=readFile(FName);
+  std::remove(FName.c_str());
+
+  const uint16_t testValue(1);
+  const std::string byteOrder=
+    (*reinterpret_cast<const char*>(&testValue)) ?
+    "LittleEndian" : "BigEndian";
+
+  const std::string Head=
+    "<?xml version=\"1.0\"?>\n"
+    "<VTKFile type=\"RectilinearGrid\" version=\"1.0\" byte_order=\""+
+    byteOrder+"\" header_type=\"UInt64\">\n"
+    "  <RectilinearGrid WholeExtent=\"0 1 0 2 0 1\">\n"
+    "    <Piece Extent=\"0 1 0 2 0 1\">\n"
+    "      <PointData Scalars=\"flux\">\n"
+    "        <DataArray type=\"Float32\" Name=\"flux\" "
+    "format=\"appended\" offset=\"52\"/>\n"
+    "      </PointData>\n"
+    "      <Coordinates>\n"
+    "        <DataArray type=\"Float32\" Name=\"X\" "
+    "format=\"appended\" offset=\"0\"/>\n"
+    "        <DataArray type=\"Float32\" Name=\"Y\" "
+    "format=\"appended\" offset=\"16\"/>\n"
+    "        <DataArray type=\"Float32\" Name=\"Z\" "
+    "format=\"appended\" offset=\"36\"/>\n"
+    "      </Coordinates>\n"
+    "    </Piece>\n"
+    "  </RectilinearGrid>\n"
+    "  <AppendedData encoding=\"raw\">\n"
+    "_";
+  const std::string Tail="\n  </AppendedData>\n</VTKFile>\n";
+
+  if (Out.size()!=Head.size()+108+Tail.size() ||
+      Out.compare(0,Head.size(),Head) ||
+      Out.compare(Out.size()-Tail.size(),Tail.size(),Tail))
+    {
+      ELog::EM<<"Size == "<<Out.size()<<" ("
+	      <<Head.size()+108+Tail.size()<<")"<<ELog::endDiag;
+      ELog::EM<<"Header ::\n"<<Out.substr(0,Head.size())<<ELog::endDiag;
+      ELog::EM<<"Expected ::\n"<<Head<<ELog::endDiag;
+      return -1;
+    }
+
+  // offset : expected values
+  std::vector<double> Scalar;
+  for(size_t k=0;k<ZCoord.size();k++)
+    for(size_t j=0;j<YCoord.size();j++)
+      for(size_t i=0;i<XCoord.size();i++)
+	Scalar.push_back(gridValue(i,j,k));
+  typedef std::tuple<size_t,std::vector<double>> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(0,XCoord),
+      TTYPE(16,YCoord),
+      TTYPE(36,ZCoord),
+      TTYPE(52,Scalar)
+    };
+
+  const size_t base(Head.size());
+  for(const TTYPE& tc : Tests)
+    {
+      const size_t offset(base+std::get<0>(tc));
+      const std::vector<double>& Values=std::get<1>(tc);
+      const uint64_t nByte=readValue<uint64_t>(Out,offset);
+      if (nByte!=Values.size()*sizeof(float))
+	{
+	  ELog::EM<<"Offset "<<std::get<0>(tc)<<" : byte count "
+		  <<nByte<<" ("<<Values.size()*sizeof(float)<<")"
+		  <<ELog::endDiag;
+	  return -1;
+	}
+      for(size_t i=0;i<Values.size();i++)
+	{
+	  const float V=readValue<float>
+	    (Out,offset+sizeof(uint64_t)+i*sizeof(float));
+	  if (std::abs(V-static_cast<float>(Values[i]))>1e-6)
+	    {
+	      ELog::EM<<"Offset "<<std::get<0>(tc)<<" item "<<i<<" : "
+		      <<V<<" ("<<Values[i]<<")"<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+    }
+  return 0;
+}
@@ -25,10 +25,12 @@
 #include <cmath>
 #include <complex> 
 #include <vector>
+#include <array>
 #include <list> 
 #include <map> 
 #include <set>
 #include <string>
+#include <tuple>
 #include <algorithm>
 #include <functional>
 #include <numeric>
@@ -197,12 +199,18 @@ testVolumes::applyTest(const int extra)
   typedef int (testVolumes::*testPtr)();
   testPtr TPtr[]=
     {
+      &testVolumes::testEmptyTally,
       &testVolumes::testPointVolume,
+      &testVolumes::testSampleVolume,
+      &testVolumes::testSeed,
       &testVolumes::testVolume
     };
   const std::string TestName[]=
     {
+      "EmptyTally",
       "PointVolume",
+      "SampleVolume",
+      "Seed",
       "Volume"
     };
   
@@ -260,6 +268,38 @@ testVolumes::testVolume()
   return 0;
 }
 
+int
+testVolumes::testEmptyTally()
+  /*!
+    Test that a tally outside the sample volume [Gd box]
+    does not stop the error target ending the run
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testEmptyTally");
+
+  const double targetErr(0.005);
+  const size_t NMax(400000);
+  
+  VolSum VTally(Geometry::Vec3D(0,0,0),
+		Geometry::Vec3D(14.0,14.0,14.0));
+  VTally.addTallyCell(4,2);
+  VTally.addTallyCell(5,5);
+  VTally.setBatchSize(2000);
+  const size_t NPts=VTally.sampleRun(ASim,NMax,targetErr);
+  const double V=VTally.calcVolume(5);
+  const double VErr=VTally.calcError(4);
+  
+  if (NPts>=NMax || std::abs(V)>1e-12 || VErr>targetErr)
+    {
+      ELog::EM<<"NPts == "<<NPts<<" ("<<NMax<<")"<<ELog::endDiag;
+      ELog::EM<<"Empty volume == "<<V<<ELog::endDiag;
+      ELog::EM<<"Error(4) == "<<VErr<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
 int
 testVolumes::testPointVolume()
   /*!
@@ -286,3 +326,93 @@ testVolumes::testPointVolume()
   return 0;
 }
 
+int
+testVolumes::testSampleVolume()
+  /*!
+    Test the batch sampling methods on the sphere cell 
+    [r=6] : all must converge to the volume and the 
+    result must not depend on the number of threads
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testSampleVolume");
+
+  const double VTrue(4.0*M_PI*216.0/3.0);
+  const double targetErr(0.005);
+  
+  typedef std::tuple<VolSum::volType,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(VolSum::volType::random,"random"),
+      TTYPE(VolSum::volType::halton,"halton"),
+      TTYPE(VolSum::volType::sobol,"sobol"),
+      TTYPE(VolSum::volType::strat,"strat")
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      double V[2];
+      double VErr[2];
+      size_t NPts[2];
+      for(size_t i=0;i<2;i++)
+	{
+	  VolSum VTally(Geometry::Vec3D(0,0,0),
+			Geometry::Vec3D(14.0,14.0,14.0));
+	  VTally.addTallyCell(4,2);
+	  VTally.setSampleType(std::get<0>(tc));
+	  VTally.setBatchSize(2000);
+	  VTally.setThreads(3*i);
+	  NPts[i]=VTally.sampleRun(ASim,400000,targetErr);
+	  V[i]=VTally.calcVolume(4);
+	  VErr[i]=VTally.calcError(4);
+	}
+      if (std::abs(V[0]-V[1])>1e-12 || NPts[0]!=NPts[1] ||
+	  VErr[0]>targetErr ||
+	  std::abs(V[0]-VTrue)>4.0*targetErr*VTrue)
+	{
+	  ELog::EM<<"Failed on "<<std::get<1>(tc)<<ELog::endDiag;
+	  ELog::EM<<"V[serial/thread] == "<<V[0]<<" "<<V[1]
+		  <<" ("<<VTrue<<")"<<ELog::endDiag;
+	  ELog::EM<<"Error == "<<VErr[0]<<" "<<VErr[1]<<ELog::endDiag;
+	  ELog::EM<<"NPts == "<<NPts[0]<<" "<<NPts[1]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testVolumes::testSeed()
+  /*!
+    Test that -random sets the base seed of the sampled
+    run [via setSampling] : the same seed repeats the
+    result and a different seed changes it
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testVolumes","testSeed");
+
+  const std::vector<long int> Seeds({375642321L,375642321L,12345L});
+  std::vector<double> V;
+  for(const long int S : Seeds)
+    {
+      mainSystem::inputParam IParam;
+      IParam.regDefItem<long int>("s","random",1,S);
+      IParam.regItem("volType","volType",1,2);
+      IParam.regItem("volThread","volThread",1);
+      
+      VolSum VTally(Geometry::Vec3D(0,0,0),
+		    Geometry::Vec3D(14.0,14.0,14.0));
+      VTally.addTallyCell(4,2);
+      VTally.setBatchSize(2000);
+      setSampling(IParam,VTally);
+      VTally.sampleRun(ASim,40000,0.0);
+      V.push_back(VTally.calcVolume(4));
+    }
+  if (std::abs(V[0]-V[1])>1e-12 || std::abs(V[0]-V[2])<1e-12)
+    {
+      ELog::EM<<"V[seed] == "<<V[0]<<" "<<V[1]<<" "<<V[2]<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
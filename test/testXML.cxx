@@ -385,6 +385,11 @@ testXML::testNextGrp()
   OX.open("testXML.xml");
 
   OX<<"<Out>\n";
+  // comment longer than a read block
+  OX<<"<!-- <testD/>\n";
+  for(size_t i=0;i<5000;i++)
+    OX<<"    comment line <testE/>\n";
+  OX<<"-->\n";
   OX<<"<test f=\"54\"> Some text </test>";
   OX<<"<testA f=\"44\"> Some more text </testA>\n";
   OX<<"<testB/>\n";
@@ -0,0 +1,62 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   testInclude/testActivationSource.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testActivationSource_h
+#define testActivationSource_h 
+
+/*!
+  \class testActivationSource
+  \brief Tests the activation source points
+  \author S. Ansell
+  \date June 2018
+  \version 1.0
+
+  Test the binary point file and that the sampled
+  points do not depend on the number of threads
+*/
+
+class testActivationSource
+{
+private:
+  
+  SimMCNP ASim;       ///< Simulation object to build
+
+  void initSim();
+  void writeSpectra();
+  void createSource(const size_t,const long int,const bool,
+		    const std::string&);
+  static std::string readFile(const std::string&);
+
+  //Tests 
+  int testBadHeader();
+  int testBinary();
+  int testThreads();
+
+public:
+  
+  testActivationSource();
+  ~testActivationSource();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
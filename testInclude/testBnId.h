@@ -38,6 +38,7 @@ private:
 
 
   //Tests 
+  int testCombination();
   int testMinTerm();
 
 public:
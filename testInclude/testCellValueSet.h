@@ -0,0 +1,54 @@
+/********************************************************************* 
+  CombLayer : MNCPX Input builder
+ 
+ * File:   testInclude/testCellValueSet.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testCellValueSet_h
+#define testCellValueSet_h 
+
+/*!
+  \class testCellValueSet
+  \brief Tests the class cellValueSet
+  \author S. Ansell
+  \date June 2018
+  \version 1.0
+*/
+
+class testCellValueSet
+{
+private:
+
+  static int checkCards(const std::string&,
+			const std::vector<std::string>&);
+  
+  //Tests 
+  int testMixed();
+  int testRange();
+  int testScale();
+
+public:
+  
+  testCellValueSet();
+  ~testCellValueSet();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
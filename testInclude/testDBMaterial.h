@@ -35,7 +35,9 @@ class testDBMaterial
 private:
 
   //Tests 
+  int testAttnTable();
   int testCombine();
+  int testThreadLookup();
  
 public:
 
@@ -22,6 +22,12 @@
 #ifndef testLine_h
 #define testLine_h 
 
+namespace Geometry
+{
+  class Line;
+  class Surface;
+}
+
 /*!
   \class testLine
   \brief Tests the Line class
@@ -36,11 +42,18 @@ class testLine
 {
 private:
 
+  static size_t lineRoots(const Geometry::Line&,const int,
+			  const Geometry::Surface*,std::vector<double>&);
+  static size_t kernelRoots(const Geometry::Line&,const int,
+			    const Geometry::Surface*,std::vector<double>&);
+
   //Tests 
   int testConeIntersect();
   int testCylinderIntersect();
   int testEllipticCylIntersect();
   int testInterDistance();
+  int testKernelBatch();
+  int testKernelIntersect();
  
 public:
 
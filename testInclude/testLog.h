@@ -38,6 +38,7 @@ private:
 
   //Tests 
   int testENDL();
+  int testRegMethod();
  
 public:
 
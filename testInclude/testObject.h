@@ -46,12 +46,15 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testAddIntersection();
+  int testBoundBox();
   int testCellStr();
   int testComplement();
   int testIsValid();
   int testIsOnSide();
   int testMakeComplement();
   int testRemoveComplement();
+  int testRuleProgram();
   int testSetObject();
   int testSetObjectExtra();
   int testTrackCell();
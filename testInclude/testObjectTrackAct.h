@@ -43,6 +43,8 @@ private:
   void createObjects();
 
   //Tests 
+  int testEnergyFactor();
+  int testMarkovMatrix();
   int testPointDet();
 
 public:
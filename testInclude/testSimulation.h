@@ -43,6 +43,7 @@ private:
   void createObjects();
 
   //Tests 
+  int testBVHCell();
   int testCreateObjSurfMap();
   int testInCell();
   int testSplitCell();
@@ -44,6 +44,7 @@ private:
   int testExtractWord();
   int testFullBlock();  
   int testItemize();    
+  int testMasterWrite();
   int testSection();
   int testSectionCinder();
   int testSectionRange();    
@@ -54,6 +55,7 @@ private:
   int testStrParts();   
   int testStrRemove();  
   int testStrSplit();   
+  int testWriteControl();
 
 public:
 
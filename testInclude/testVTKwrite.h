@@ -0,0 +1,58 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   testInclude/testVTKwrite.h
+ *
+ * Copyright (c) 2004-2018 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef testVTKwrite_h
+#define testVTKwrite_h
+
+class VTKwrite;
+
+/*!
+  \class testVTKwrite
+  \brief Tests the VTK file writer
+  \author S. Ansell
+  \date June 2018
+  \version 1.0
+
+  Test the byte layout of the binary/xml files and
+  the ascii output on a small known grid
+*/
+
+class testVTKwrite
+{
+private:
+
+  static std::string readFile(const std::string&);
+  static void writeGrid(VTKwrite&,const std::string&);
+
+  //Tests
+  int testAscii();
+  int testBinary();
+  int testXML();
+
+public:
+
+  testVTKwrite();
+  ~testVTKwrite();
+
+  int applyTest(const int);
+};
+
+#endif
@@ -43,7 +43,10 @@ private:
   void createObjects();
 
   //Tests 
+  int testEmptyTally();
   int testPointVolume();
+  int testSampleVolume();
+  int testSeed();
   int testVolume();
 
 public: